@@ -0,0 +1,92 @@
+/// Measure the cost of a log call on the calling thread, synchronous and asynchronous.
+///
+/// The messages are written into a file, as a console would be, and each call is timed.
+/// The asynchronous logging only format the message and queue it, the file is written by
+/// the logging thread. The messages are logged by bursts separated by some work, like a
+/// frame logging a few messages: a continuous flood would measure the throughput of the
+/// file instead, the asynchronous logging then wait (or drop messages) as the queue is full.
+///
+/// Usage: LogBenchmark [message count] [messages per burst]
+#include <FuseApp/Log.h>
+
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// @brief Log messages with the default logger and print the time of the calls.
+void benchmark(const char* name, std::size_t messageCount, std::size_t burstSize) {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<double> times(messageCount);
+    double              total = 0.0; ///< Time in the log calls, in nanoseconds.
+    for (std::size_t i = 0; i < messageCount; i++) {
+        const auto begin = Clock::now();
+        // Like the OpenGL debug callback.
+        spdlog::warn("[{}] [{}] ({}) {}", "API", "MEDIUM", i, "Buffer performance warning.");
+        times[i] = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+        total += times[i];
+
+        if ((i + 1) % burstSize == 0) {
+            // The rest of the frame.
+            const auto workEnd = Clock::now() + std::chrono::microseconds(200);
+            while (Clock::now() < workEnd) {
+            }
+        }
+    }
+
+    // The asynchronous messages are written before measuring the next logger.
+    fuse::disableAsyncLogging();
+
+    std::ranges::sort(times);
+    const auto percentile = [&](double p) {
+        return times[static_cast<std::size_t>(p * static_cast<double>(messageCount - 1))];
+    };
+    std::printf("%-28s %8.1f ns/call  p50 %8.1f ns  p99 %8.1f ns  max %10.1f ns\n",
+                name,
+                total / static_cast<double>(messageCount),
+                percentile(0.5),
+                percentile(0.99),
+                times.back());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t messageCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    const std::size_t burstSize    = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32;
+    if (messageCount == 0 || burstSize == 0) {
+        std::printf("Usage: LogBenchmark [message count] [messages per burst]\n");
+        return 1;
+    }
+
+    const auto path = std::filesystem::temp_directory_path() / "FuseLogBenchmark.log";
+    auto       sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path.string(), true);
+    spdlog::set_default_logger(std::make_shared<spdlog::logger>("benchmark", sink));
+
+    std::printf("%zu messages by bursts of %zu written to %s\n",
+                messageCount,
+                burstSize,
+                path.string().c_str());
+    benchmark("synchronous", messageCount, burstSize);
+
+    fuse::enableAsyncLogging({.queueSize      = 8192,
+                              .overflowPolicy = fuse::LogOverflowPolicy::Block});
+    benchmark("asynchronous, block", messageCount, burstSize);
+
+    fuse::enableAsyncLogging({.queueSize      = 8192,
+                              .overflowPolicy = fuse::LogOverflowPolicy::DiscardNew});
+    benchmark("asynchronous, discard new", messageCount, burstSize);
+
+    spdlog::shutdown();
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -4,6 +4,8 @@
 #include <FuseApp/TransformerSystem.h>
 #include <FuseCore/Input.h>
 #include <FuseCore/scene/Components.h>
+#include <FuseCore/scene/RenderList.h>
+#include <FuseCore/scene/TransformInterpolation.h>
 
 #include <imgui.h>
 #include <spdlog/spdlog.h>
@@ -39,23 +41,45 @@ bool Application::onInit() {
     r.angle = fuse::degrees(10);
 
     createCube(mScene, {-11, 10, -11});
+    createCube(mScene, {11, 10, -11}).getComponent<fuse::CMesh>().mesh = fuse::MeshHandle::kSphere;
     mSceneRenderer = std::make_unique<fuse::SceneRenderer>();
+    // the sandbox does not add meshes after the init, they are uploaded once.
+    mSceneRenderer->syncMeshes(mScene.getMeshRegistry());
+
+    // simulate at a fixed rate, the renderer interpolate between the steps.
+    setFixedTimestep(60.0f);
     return true;
 }
 
 void Application::onShutdown() { mSceneRenderer.reset(); }
 
-void Application::onUpdate(float deltaTime) {
-    glClearColor(1.0f, .0f, 1.f, 1.f);
-    glEnable(GL_DEPTH_TEST);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+void Application::onFixedUpdate(float fixedDeltaTime) {
+    fuse::storePreviousTransforms(mScene);
+
     fuse::TransformerSystem transformerSystem;
+    transformerSystem.update(mScene, fixedDeltaTime);
+}
 
-    const fuse::Mat4 proj = mCamera.getProjMatrix();
-    const fuse::Mat4 view = mCamera.getViewMatrix();
-    transformerSystem.update(mScene, deltaTime);
-    mSceneRenderer->renderScene(mScene, proj, view);
+void Application::onSimulate(float /*deltaTime*/) {
+    // may run on the simulation thread, use the input captured for the simulation.
+    const fuse::InputSnapshot& input = getSimulationInput();
+    if (input.isKeyPressed(fuse::ScanCode::Z)) {
+        entityToDestroy                                   = createCube(mScene, {0, 0, 0});
+        entityToDestroy.getComponent<fuse::CMesh>().color = {0.5f, 0.5f, 0.5f, 1.0f};
+        entityToDestroy.addComponent<fuse::CTranslator>(fuse::Vec3{1, 0, 0}, 2.0f);
+    }
+    if (input.isKeyPressed(fuse::ScanCode::X)) {
+        if (entityToDestroy.isValid()) {
+            entityToDestroy.destroy();
+        }
+    }
+    if (input.isKeyPressed(fuse::ScanCode::C)) {
+        auto newEnt = mScene.duplicateEntity(entityToDestroy);
+        newEnt.getOrAddComponent<fuse::CTranslator>(fuse::Vec3{0, 1, 0}, 2.0f);
+    }
+}
 
+void Application::onUpdate(float /*deltaTime*/) {
     if (fuse::Input::IsKeyDown(fuse::ScanCode::A)) {
         auto pos = mCamera.getPosition();
         pos -= mCamera.getRight() * 2;
@@ -86,21 +110,6 @@ void Application::onUpdate(float deltaTime) {
         pos += fuse::Vec3::kAxisYNeg;
         mCamera.setPosition(pos);
     }
-    if (fuse::Input::IsKeyPressed(fuse::ScanCode::Z)) {
-        entityToDestroy                                   = createCube(mScene, {0, 0, 0});
-        entityToDestroy.getComponent<fuse::CMesh>().color = {0.5f, 0.5f, 0.5f, 1.0f};
-        entityToDestroy.addComponent<fuse::CTranslator>(fuse::Vec3{1, 0, 0}, 2.0f);
-    }
-    if (fuse::Input::IsKeyPressed(fuse::ScanCode::X)) {
-        if (entityToDestroy.isValid()) {
-            entityToDestroy.destroy();
-        }
-    }
-    if (fuse::Input::IsKeyPressed(fuse::ScanCode::C)) {
-        auto newEnt = mScene.duplicateEntity(entityToDestroy);
-        newEnt.getOrAddComponent<fuse::CTranslator>(fuse::Vec3{0, 1, 0}, 2.0f);
-    }
-
     const auto [x, y] = fuse::Input::GetMousePositionDelta();
     // Make each pixel correspond to a 1/8 of a degree.
     const auto dx = x * fuse::degrees(0.125f);
@@ -109,6 +118,20 @@ void Application::onUpdate(float deltaTime) {
     mCamera.yaw(-dx);   // rotation around local right
 }
 
+void Application::onExtract(fuse::RenderList& renderList) {
+    fuse::extractRenderList(mScene, getInterpolationAlpha(), renderList);
+}
+
+void Application::onRender(const fuse::RenderList& renderList) {
+    glClearColor(1.0f, .0f, 1.f, 1.f);
+    glEnable(GL_DEPTH_TEST);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    const fuse::Mat4 proj = mCamera.getProjMatrix();
+    const fuse::Mat4 view = mCamera.getViewMatrix();
+    mSceneRenderer->renderList(renderList, proj, view);
+}
+
 void Application::onEvent(const fuse::Event& event) {
     fuse::Application::onEvent(event);
 
@@ -122,11 +145,12 @@ void Application::onEvent(const fuse::Event& event) {
 void Application::onImGui() {
     ImGui::ShowDemoWindow();
 
-    if (ImGui::Begin("Entities")) {
+    // the scene is owned by the simulation thread in pipelined mode.
+    if (ImGui::Begin("Entities") && !isPipelined()) {
         for (auto entity : mScene.getRegistry().view<entt::entity>()) {
 
             fuse::ImGuiTextFmt("{} id={}",
-                               mScene.getRegistry().get<fuse::NameComponent>(entity).name.c_str(),
+                               mScene.getEntityName({entity, mScene.getRegistry()}),
                                mScene.getRegistry().get<fuse::IDComponent>(entity).id);
 
             if (mScene.getRegistry().try_get<fuse::CTranslator>(entity)) {
@@ -24,6 +24,10 @@ public:
     bool onInit() override;
     void onShutdown() override;
     void onUpdate(float deltaTime) override;
+    void onSimulate(float deltaTime) override;
+    void onFixedUpdate(float fixedDeltaTime) override;
+    void onExtract(fuse::RenderList& renderList) override;
+    void onRender(const fuse::RenderList& renderList) override;
     void onEvent(const fuse::Event& event) override;
     void onImGui() override;
 
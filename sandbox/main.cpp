@@ -99,8 +99,11 @@ SDL_Cursor* init_system_cursor(const char* const image[]) {
 
 } // namespace
 
-int main() {
+int main(int argc, char** argv) {
     auto app = std::make_unique<Application>();
+    if (!app->parseCommandLine(argc, argv)) {
+        return 1;
+    }
     app->run();
     app.reset();
     return 0;
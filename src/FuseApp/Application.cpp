@@ -3,6 +3,7 @@
 #include "SDL3/SDL3Helper.h"
 #include "Window.h"
 
+#include <FuseCore/EventRecorder.h>
 #include <FuseCore/fileSystem/FileSystem.h>
 #include <FuseCore/Input.h>
 
@@ -13,6 +14,10 @@
 #include <SDL3/SDL_opengl.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <chrono>
+#include <string_view>
+
 namespace {
 void GLAPIENTRY MessageCallback(GLenum source,
                                 GLenum type,
@@ -76,6 +81,9 @@ Application::Application() = default;
 Application::~Application() = default;
 
 bool Application::init() {
+    if (mAsyncLogging) {
+        enableAsyncLogging(mAsyncLogSettings);
+    }
 
     const int compiled = SDL_VERSION;      /* hardcoded number from SDL headers */
     const int linked   = SDL_GetVersion(); /* reported by linked SDL library */
@@ -115,8 +123,10 @@ bool Application::init() {
         return false;
     }
 
+    // A headless replay keep the OpenGL context, the layers render every frame: only the
+    // window is hidden.
     mMainWindow = std::make_unique<Window>();
-    if (!mMainWindow->create()) {
+    if (!mMainWindow->create(WindowCreateInfo{.visible = !mHeadless})) {
         return false;
     }
 
@@ -156,8 +166,8 @@ bool Application::init() {
     //};
 
 
-    //Use Vsync
-    if (!SDL_GL_SetSwapInterval(1)) {
+    //Use Vsync, except for a headless replay which must run as fast as possible.
+    if (!SDL_GL_SetSwapInterval(mHeadless ? 0 : 1)) {
         spdlog::error("Warning: Unable to set VSync! SDL Error: {}\n", SDL_GetError());
     }
 
@@ -241,23 +251,112 @@ bool Application::init() {
 }
 
 bool Application::shutdown() {
+    if (mSimulationThread.joinable()) {
+        waitSimulation();
+        mSimulationThread.request_stop();
+        mSimulationStart.release();
+        mSimulationThread.join();
+    }
+
     onShutdown();
 
+    if (mRecorder) {
+        if (const auto result = mRecorder->save(mRecordPath); !result) {
+            spdlog::error("Fail to save the event log {}: {}",
+                          mRecordPath.string(),
+                          std::toString(result.error().errorCode));
+        } else {
+            spdlog::info("{} frames recorded to {}",
+                         mRecorder->getFrameCount(),
+                         mRecordPath.string());
+        }
+    }
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL3_Shutdown();
     ImGui::DestroyContext();
     mMainWindow.reset();
     SDL_Quit();
+
+    // Write the messages queued, the logger can be used after the application stop.
+    disableAsyncLogging();
     return true;
 }
 
+bool Application::parseCommandLine(int argc, char** argv) {
+    std::filesystem::path recordPath;
+    std::filesystem::path replayPath;
+    bool                  headless = false;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if ((arg == "--record" || arg == "--replay") && i + 1 < argc) {
+            (arg == "--record" ? recordPath : replayPath) = argv[++i];
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--pipelined") {
+            setPipelined(true);
+        } else if (arg == "--async-log") {
+            setAsyncLogging(true);
+        } else {
+            spdlog::error("Invalid command line option: {}", arg);
+            return false;
+        }
+    }
+
+    if (!recordPath.empty()) {
+        recordEvents(recordPath);
+    }
+    if (!replayPath.empty()) {
+        replayEvents(replayPath, 1.0f / 60.0f, headless);
+    }
+    return true;
+}
+
+void Application::setFixedTimestep(float rate, unsigned maxStepsPerFrame) {
+    mFixedTimestep.emplace(rate, maxStepsPerFrame);
+}
+
+void Application::recordEvents(const std::filesystem::path& path) {
+    mRecorder   = std::make_unique<EventRecorder>();
+    mRecordPath = path;
+}
+
+void Application::replayEvents(const std::filesystem::path& path,
+                               float                        fixedDeltaTime,
+                               bool                         headless) {
+    mPlayer          = std::make_unique<EventPlayer>();
+    mReplayPath      = path;
+    mReplayDeltaTime = fixedDeltaTime;
+    mHeadless        = headless;
+}
+
 void Application::run() {
     if (!init()) {
         return;
     }
 
+    if (mPlayer) {
+        if (const auto result = mPlayer->open(mReplayPath); !result) {
+            spdlog::error("Fail to open the event log {}: {}",
+                          mReplayPath.string(),
+                          std::toString(result.error().errorCode));
+            shutdown();
+            return;
+        }
+        spdlog::info("Replaying {} frames from {}", mPlayer->getFrameCount(), mReplayPath.string());
+    }
+
+    if (mPipelined) {
+        mSimulationThread =
+          std::jthread([this](const std::stop_token& stopToken) { simulationThread(stopToken); });
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
     mTimer.reset();
     while (mIsRunning) {
+        // the events must not be dispatched while the simulation is running.
+        waitSimulation();
+
         SDL_Event sdlEvent{};
         while (SDL_PollEvent(&sdlEvent)) {
             if (sdlEvent.type == SDL_EVENT_QUIT) {
@@ -265,6 +364,11 @@ void Application::run() {
                 break;
             }
 
+            // the user input is ignored during a replay
+            if (mPlayer) {
+                continue;
+            }
+
             // pass event to imgui
             ImGui_ImplSDL3_ProcessEvent(&sdlEvent);
 
@@ -284,13 +388,34 @@ void Application::run() {
                     continue;
                 }
 
-                // update the inputs and dispatch the event to subclass.
-                Input::OnEvent(event);
-                onEvent(event);
+                dispatchEvent(event);
             }
         }
         mTimer.tick();
 
+        if (mPlayer && !replayFrame()) {
+            const std::chrono::duration<double, std::milli> elapsed =
+              std::chrono::steady_clock::now() - startTime;
+            const double frameCount = static_cast<double>(std::max<std::uint64_t>(mFrameIndex, 1));
+            spdlog::info("Replay done: {} frames in {:.3f} ms ({:.3f} ms/frame)",
+                         mFrameIndex,
+                         elapsed.count(),
+                         elapsed.count() / frameCount);
+            break;
+        }
+        const float deltaTime = mPlayer ? mReplayDeltaTime : mTimer.deltaTime();
+
+        mSimulationInput = Input::GetSnapshot();
+        if (mPipelined) {
+            // simulate the next frame while this one is drawn.
+            mSimulationDeltaTime = deltaTime;
+            mSimulationPending   = true;
+            mSimulationStart.release();
+        } else {
+            simulate(deltaTime);
+            mFrontRenderList = 1 - mFrontRenderList;
+        }
+
         // Start the Dear ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplSDL3_NewFrame();
@@ -298,9 +423,14 @@ void Application::run() {
 
         //spdlog::info("{}x{}", mMainWindow->getSize().first, mMainWindow->getSize().second);
         onImGui();
-        onUpdate(mTimer.deltaTime());
+        onUpdate(deltaTime);
+        onRender(mRenderLists[mFrontRenderList]);
         Input::UpdateStates();
 
+        if (mRecorder) {
+            mRecorder->endFrame(deltaTime);
+        }
+
         // Rendering
         ImGui::Render();
         const ImGuiIO& io = ImGui::GetIO();
@@ -321,11 +451,65 @@ void Application::run() {
 
         SDL_GL_SwapWindow(mMainWindow->getSDLWindow());
         //SDL_GL_SwapWindow(mMainWindow2->getSDLWindow());
+        mFrameIndex++;
     }
 
     shutdown();
 }
 
+void Application::dispatchEvent(const Event& event) {
+    if (mRecorder) {
+        mRecorder->record(event);
+    }
+
+    // update the inputs and dispatch the event to subclass.
+    Input::OnEvent(event);
+    onEvent(event);
+}
+
+void Application::simulate(float deltaTime) {
+    onSimulate(deltaTime);
+    if (mFixedTimestep) {
+        const unsigned steps = mFixedTimestep->advance(deltaTime);
+        for (unsigned step = 0; step < steps; step++) {
+            onFixedUpdate(mFixedTimestep->getStep());
+        }
+    }
+    onExtract(mRenderLists[1 - mFrontRenderList]);
+}
+
+void Application::simulationThread(const std::stop_token& stopToken) {
+    while (true) {
+        mSimulationStart.acquire();
+        if (stopToken.stop_requested()) {
+            return;
+        }
+        simulate(mSimulationDeltaTime);
+        mSimulationDone.release();
+    }
+}
+
+void Application::waitSimulation() {
+    if (!mSimulationPending) {
+        return;
+    }
+    mSimulationDone.acquire();
+    mSimulationPending = false;
+    mFrontRenderList   = 1 - mFrontRenderList;
+}
+
+bool Application::replayFrame() {
+    const auto frame = mPlayer->nextFrame();
+    if (!frame) {
+        return false;
+    }
+
+    for (const Event& event : frame->events) {
+        dispatchEvent(event);
+    }
+    return true;
+}
+
 void Application::onEvent(const Event& event) {
     if (const auto* keyEvent = event.getIf<KeyPressedEvent>()) {
         if (keyEvent->getScanCode() == fuse::ScanCode::P) {
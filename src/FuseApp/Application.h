@@ -1,14 +1,26 @@
 #pragma once
+#include "Log.h"
 #include "Timer.h"
 
 #include <FuseCore/Event.h>
+#include <FuseCore/Input.h>
+#include <FuseCore/scene/RenderList.h>
+#include <FuseCore/utils/FixedTimestep.h>
 
 #include <glad/glad.h>
 
+#include <array>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <optional>
+#include <semaphore>
+#include <thread>
 
 namespace fuse {
 
+class EventPlayer;
+class EventRecorder;
 class Window;
 
 /// @brief Base class for fuse application.
@@ -28,10 +40,70 @@ public:
     /// @brief
     void run();
 
+    /// @brief Parse the command line options of the application.
+    ///
+    /// - `--record <file>`: record the session events into \p file (see recordEvents()).
+    /// - `--replay <file>`: replay the events of \p file (see replayEvents()).
+    /// - `--headless`: with `--replay`, hide the window and run as fast as possible. The
+    ///   window and the OpenGL context are still created, the layers render every frame.
+    /// - `--pipelined`: simulate on a worker thread (see setPipelined()).
+    /// - `--async-log`: write the log messages on a background thread (see setAsyncLogging()).
+    ///
+    /// @return false if the command line is invalid.
+    bool parseCommandLine(int argc, char** argv);
+
+    /// @brief Record every event dispatched to the application, frame by frame.
+    ///
+    /// The log is written to \p path when the application stop.
+    /// Must be called before run().
+    /// @param path The file to write the log.
+    void recordEvents(const std::filesystem::path& path);
+
+    /// @brief Drive the application with a event log instead of the user input.
+    ///
+    /// Each frame dispatch the recorded events of the frame and call onUpdate() with a
+    /// fixed delta time, so a session can be replayed identically to compare performance.
+    /// The application quit at the end of the log and report the replay time.
+    /// Must be called before run().
+    ///
+    /// @param path The log written by recordEvents().
+    /// @param fixedDeltaTime The delta time given to onUpdate() in seconds.
+    /// @param headless Hide the window and disable the vsync. The rendering is still done,
+    ///                 so a display (or a virtual one) is required.
+    void replayEvents(const std::filesystem::path& path,
+                      float                        fixedDeltaTime = 1.0f / 60.0f,
+                      bool                         headless       = false);
+
     /// @brief
     /// @param deltaTime
     virtual void onUpdate(float /*deltaTime*/) {}
 
+    /// @brief Update the simulation, once per frame before the fixed steps.
+    ///
+    /// In pipelined mode, this is called on the simulation thread (see setPipelined()).
+    /// @param deltaTime The frame time in seconds.
+    virtual void onSimulate(float /*deltaTime*/) {}
+
+    /// @brief Update the simulation by a fixed step.
+    ///
+    /// Only called when the fixed timestep is enabled (see setFixedTimestep()),
+    /// zero or more times per frame before onUpdate().
+    /// In pipelined mode, this is called on the simulation thread (see setPipelined()).
+    /// @param fixedDeltaTime The duration of a step in seconds.
+    virtual void onFixedUpdate(float /*fixedDeltaTime*/) {}
+
+    /// @brief Extract what must be drawn at the end of the simulation of a frame.
+    ///
+    /// Called once per frame after onFixedUpdate(), on the simulation thread in pipelined mode.
+    /// @param renderList The list to fill, it still hold the data of a previous frame.
+    virtual void onExtract(RenderList& /*renderList*/) {}
+
+    /// @brief Draw the latest render list extracted by onExtract().
+    ///
+    /// Called on the main thread after onUpdate().
+    /// @param renderList The list to draw.
+    virtual void onRender(const RenderList& /*renderList*/) {}
+
     /// @brief
     virtual void onEvent(const Event& event);
 
@@ -40,6 +112,56 @@ public:
 
     [[nodiscard]] const GameTimer& getGameTimer() const { return mTimer; }
 
+    /// @brief Run onFixedUpdate() at a fixed rate, independently of the frame rate.
+    /// @param rate The number of simulation steps per second.
+    /// @param maxStepsPerFrame The maximum number of steps per frame, the time the
+    ///                         simulation can't catch up is dropped.
+    void setFixedTimestep(float rate, unsigned maxStepsPerFrame = 5);
+
+    /// @brief Stop calling onFixedUpdate().
+    void disableFixedTimestep() noexcept { mFixedTimestep.reset(); }
+
+    /// @brief Run the simulation of the next frame on a worker thread while the current frame
+    ///        is drawn. Must be called before run().
+    ///
+    /// Each frame, the simulation thread run onSimulate(), onFixedUpdate() and onExtract()
+    /// while the main thread run onImGui(), onUpdate() and onRender() with the render list
+    /// extracted the frame before. Events are dispatched while the simulation thread is idle.
+    ///
+    /// @warning In this mode, onImGui(), onUpdate() and onRender() must not access the state
+    ///          updated by the simulation, and the simulation must read the inputs with
+    ///          getSimulationInput().
+    /// @param enable true to enable the pipelined mode.
+    void setPipelined(bool enable) noexcept { mPipelined = enable; }
+
+    /// @brief Query if the simulation run on a worker thread.
+    [[nodiscard]] bool isPipelined() const noexcept { return mPipelined; }
+
+    /// @brief Write the log messages on a background thread while the application run
+    ///        (see enableAsyncLogging()). Must be called before run().
+    ///
+    /// The threads logging, like the OpenGL debug callback which is synchronous, only copy the
+    /// message into a queue. The messages still queued are written when the application stop.
+    /// @param enable true to enable the asynchronous logging.
+    /// @param settings The size of the queue and the overflow policy.
+    void setAsyncLogging(bool enable, const AsyncLogSettings& settings = {}) noexcept {
+        mAsyncLogging     = enable;
+        mAsyncLogSettings = settings;
+    }
+
+    /// @brief Get the input state captured when the simulation of the frame started.
+    ///
+    /// Unlike the Input static functions, this is safe to use from the simulation thread.
+    [[nodiscard]] const InputSnapshot& getSimulationInput() const noexcept {
+        return mSimulationInput;
+    }
+
+    /// @brief Get the interpolation factor between the two latest simulation steps.
+    /// @return A factor in range [0, 1) or 1 when the fixed timestep is disabled.
+    [[nodiscard]] float getInterpolationAlpha() const noexcept {
+        return mFixedTimestep ? mFixedTimestep->getAlpha() : 1.0f;
+    }
+
     void quit() { mIsRunning = false; }
 
 protected:
@@ -59,10 +181,49 @@ private:
     /// @return
     bool shutdown();
 
+    /// @brief Update the inputs, dispatch a event to the subclass and record it.
+    void dispatchEvent(const Event& event);
+
+    /// @brief Dispatch the events of the next replayed frame.
+    /// @return false at the end of the replay.
+    bool replayFrame();
+
+    /// @brief Simulate the frame and extract the back render list.
+    void simulate(float deltaTime);
+
+    /// @brief Body of the simulation thread.
+    void simulationThread(const std::stop_token& stopToken);
+
+    /// @brief Wait the simulation of the frame in flight, if any, and swap the render lists.
+    void waitSimulation();
+
     std::unique_ptr<Window> mMainWindow;
     std::unique_ptr<Window> mMainWindow2;
     bool                    mIsRunning = true;
     GameTimer               mTimer;
+    std::uint64_t           mFrameIndex{}; ///< Number of frames since run() was called.
+
+    std::optional<FixedTimestep> mFixedTimestep; ///< Simulation rate, if enabled.
+
+    std::array<RenderList, 2>     mRenderLists;           ///< Front and back render lists.
+    std::size_t                   mFrontRenderList{};     ///< Index of the list to draw.
+    bool                          mPipelined = false;     ///< Simulate on a worker thread.
+    bool                          mSimulationPending{};   ///< A simulation is in flight.
+    float                         mSimulationDeltaTime{}; ///< Delta time of the simulation.
+    InputSnapshot                 mSimulationInput;       ///< Input state of the simulation.
+    std::binary_semaphore         mSimulationStart{0};    ///< Signaled to start a simulation.
+    std::binary_semaphore         mSimulationDone{0};     ///< Signaled when a simulation end.
+    std::jthread                  mSimulationThread;      ///< The simulation thread.
+
+    bool             mAsyncLogging = false; ///< Log on a background thread.
+    AsyncLogSettings mAsyncLogSettings;     ///< Settings of the asynchronous logging.
+
+    std::unique_ptr<EventRecorder> mRecorder;          ///< Record the events, if enabled.
+    std::filesystem::path          mRecordPath;        ///< File to write the recorded events.
+    std::unique_ptr<EventPlayer>   mPlayer;            ///< Replay the events, if enabled.
+    std::filesystem::path          mReplayPath;        ///< File to read the replayed events.
+    float                          mReplayDeltaTime{}; ///< Fixed delta time of the replay.
+    bool                           mHeadless = false;  ///< Hide the window during the replay.
 };
 
 } // namespace fuse
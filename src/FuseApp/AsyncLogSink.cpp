@@ -0,0 +1,131 @@
+#include "AsyncLogSink.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+/// @brief Time the logging thread sleep when there is no message.
+constexpr std::chrono::milliseconds kIdleSleep{1};
+
+} // namespace
+
+namespace fuse {
+
+AsyncLogSink::AsyncLogSink(std::vector<spdlog::sink_ptr> sinks,
+                           std::string                   loggerName,
+                           const AsyncLogSettings&       settings)
+    : mRing(std::bit_ceil(std::max<std::size_t>(settings.queueSize, 2)))
+    , mSinks(std::move(sinks))
+    , mLoggerName(std::move(loggerName))
+    , mOverflowPolicy(settings.overflowPolicy)
+    , mThread([this](const std::stop_token& stopToken) { run(stopToken); }) {}
+
+AsyncLogSink::~AsyncLogSink() {
+    mThread.request_stop();
+    mThread.join();
+}
+
+void AsyncLogSink::log(const spdlog::details::log_msg& msg) {
+    const std::string_view text(msg.payload.data(), msg.payload.size());
+    std::size_t            offset = 0;
+    do {
+        const std::size_t length = std::min(text.size() - offset, LogRecord::kMaxLength);
+        const auto        writer = [&](LogRecord& record) {
+            std::memcpy(record.text.data(), text.data() + offset, length);
+            record.length   = static_cast<std::uint16_t>(length);
+            record.level    = msg.level;
+            record.partial  = offset + length < text.size();
+            record.threadId = static_cast<std::uint32_t>(msg.thread_id);
+            const auto time = msg.time.time_since_epoch();
+            record.time     = std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+        };
+
+        // A message partly queued is completed, even with the DiscardNew policy.
+        while (!mRing.tryPush(writer)) {
+            if (mOverflowPolicy == LogOverflowPolicy::DiscardNew && offset == 0) {
+                mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+        }
+        offset += length;
+    } while (offset < text.size());
+}
+
+void AsyncLogSink::flush() { mFlushRequested.store(true, std::memory_order_relaxed); }
+
+void AsyncLogSink::set_pattern(const std::string& pattern) {
+    for (const auto& sink : mSinks) {
+        sink->set_pattern(pattern);
+    }
+}
+
+void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
+    for (const auto& sink : mSinks) {
+        sink->set_formatter(formatter->clone());
+    }
+}
+
+void AsyncLogSink::run(const std::stop_token& stopToken) {
+    for (;;) {
+        // The messages logged before the stop request are written.
+        const bool        stopping = stopToken.stop_requested();
+        const std::size_t count =
+          mRing.drain([this](const LogRecord& record) { write(record); });
+        if (mFlushRequested.exchange(false, std::memory_order_relaxed)) {
+            for (const auto& sink : mSinks) {
+                sink->flush();
+            }
+        }
+
+        if (count == 0) {
+            if (stopping) {
+                break;
+            }
+            std::this_thread::sleep_for(kIdleSleep);
+        }
+    }
+
+    for (const auto& sink : mSinks) {
+        sink->flush();
+    }
+}
+
+void AsyncLogSink::write(const LogRecord& record) {
+    // The records of a long message follow each other for a thread, not between threads.
+    auto partial = std::ranges::find_if(mPartialMessages, [&record](const auto& message) {
+        return message.first == record.threadId;
+    });
+    std::string_view text = record.getText();
+    if (partial != mPartialMessages.end() || record.partial) {
+        if (partial == mPartialMessages.end()) {
+            partial = mPartialMessages.emplace(partial, record.threadId, std::string());
+        }
+        partial->second.append(text);
+        if (record.partial) {
+            return;
+        }
+        text = partial->second;
+    }
+
+    const auto time = std::chrono::duration_cast<spdlog::log_clock::duration>(
+      std::chrono::nanoseconds(record.time));
+    spdlog::details::log_msg msg(
+      spdlog::log_clock::time_point(time), {}, mLoggerName, record.level, text);
+    msg.thread_id = record.threadId;
+    for (const auto& sink : mSinks) {
+        if (sink->should_log(msg.level)) {
+            sink->log(msg);
+        }
+    }
+
+    if (partial != mPartialMessages.end()) {
+        mPartialMessages.erase(partial);
+    }
+}
+
+} // namespace fuse
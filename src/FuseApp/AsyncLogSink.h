@@ -0,0 +1,92 @@
+#pragma once
+#include "Log.h"
+#include "LogRingSink.h"
+
+#include <FuseCore/utils/MpscRing.h>
+
+#include <spdlog/sinks/sink.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fuse {
+
+/// @brief spdlog sink writing the messages into other sinks on a background thread.
+///
+/// log() copy the message text, already formatted by the logger, into a preallocated
+/// lock-free ring (see MpscRing) and return: the calling thread does not take a lock, does
+/// not allocate memory and does not wake the logging thread. The logging thread poll the
+/// ring, format the messages with the patterns of the sinks and write them. The messages
+/// longer than a record are split into consecutive records of the thread.
+///
+/// When the ring is full, the calling thread wait for the logging thread or the message is
+/// dropped, depending on the overflow policy. The messages still queued are written when
+/// the sink is destroyed.
+class AsyncLogSink final : public spdlog::sinks::sink {
+public:
+    /// @brief Create the sink and start the logging thread.
+    /// @param sinks The sinks writing the messages, called from the logging thread.
+    /// @param loggerName The name of the logger using the sink, for the patterns.
+    /// @param settings The size of the ring and the overflow policy.
+    AsyncLogSink(std::vector<spdlog::sink_ptr> sinks,
+                 std::string                   loggerName,
+                 const AsyncLogSettings&       settings = {});
+
+    /// @brief Write the messages queued and stop the logging thread.
+    ///
+    /// The threads logging must be stopped.
+    ~AsyncLogSink() override;
+
+    AsyncLogSink(const AsyncLogSink&)            = delete;
+    AsyncLogSink(AsyncLogSink&&)                 = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(AsyncLogSink&&)      = delete;
+
+    void log(const spdlog::details::log_msg& msg) override;
+
+    /// @brief Ask the logging thread to flush the sinks after the messages queued.
+    void flush() override;
+
+    /// @brief Set the pattern of the sinks.
+    void set_pattern(const std::string& pattern) override;
+
+    /// @brief Set the formatter of the sinks.
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+    /// @brief Get the sinks writing the messages.
+    [[nodiscard]] const std::vector<spdlog::sink_ptr>& getSinks() const noexcept {
+        return mSinks;
+    }
+
+    /// @brief Get the number of messages dropped because the ring was full.
+    [[nodiscard]] std::uint64_t getDroppedCount() const noexcept {
+        return mDroppedCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// @brief Body of the logging thread.
+    void run(const std::stop_token& stopToken);
+
+    /// @brief Write a record into the sinks, or keep it until the message is complete.
+    void write(const LogRecord& record);
+
+    MpscRing<LogRecord>           mRing;
+    std::vector<spdlog::sink_ptr> mSinks;
+    std::string                   mLoggerName;
+    LogOverflowPolicy             mOverflowPolicy;
+    std::atomic<std::uint64_t>    mDroppedCount{};
+    std::atomic<bool>             mFlushRequested{};
+
+    /// Start of the messages split into many records, by thread. Used by the logging thread.
+    std::vector<std::pair<std::uint32_t, std::string>> mPartialMessages;
+
+    std::jthread mThread; ///< The logging thread, last to start after the other members.
+};
+
+} // namespace fuse
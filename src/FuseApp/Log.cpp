@@ -0,0 +1,52 @@
+#include "Log.h"
+
+#include "AsyncLogSink.h"
+
+#include <spdlog/spdlog.h>
+
+#include <memory>
+
+namespace {
+
+/// @brief Get the asynchronous sink of a logger created by fuse::enableAsyncLogging().
+std::shared_ptr<fuse::AsyncLogSink> getAsyncSink(const spdlog::logger& logger) {
+    const auto& sinks = logger.sinks();
+    return sinks.size() == 1 ? std::dynamic_pointer_cast<fuse::AsyncLogSink>(sinks.front())
+                             : nullptr;
+}
+
+} // namespace
+
+namespace fuse {
+
+void enableAsyncLogging(const AsyncLogSettings& settings) {
+    const auto logger = spdlog::default_logger();
+    if (getAsyncSink(*logger)) {
+        return;
+    }
+
+    auto sink        = std::make_shared<AsyncLogSink>(logger->sinks(), logger->name(), settings);
+    auto asyncLogger = std::make_shared<spdlog::logger>(logger->name(), std::move(sink));
+    asyncLogger->set_level(logger->level());
+    asyncLogger->flush_on(logger->flush_level());
+    spdlog::set_default_logger(std::move(asyncLogger));
+}
+
+void disableAsyncLogging() {
+    const auto logger = spdlog::default_logger();
+    const auto sink   = getAsyncSink(*logger);
+    if (!sink) {
+        return;
+    }
+
+    const auto& sinks      = sink->getSinks();
+    auto        syncLogger =
+      std::make_shared<spdlog::logger>(logger->name(), sinks.begin(), sinks.end());
+    syncLogger->set_level(logger->level());
+    syncLogger->flush_on(logger->flush_level());
+    spdlog::set_default_logger(std::move(syncLogger));
+
+    // The sink is destroyed with the asynchronous logger, after writing the messages queued.
+}
+
+} // namespace fuse
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+
+namespace fuse {
+
+/// @brief What the threads logging do when the queue of the asynchronous logging is full.
+enum class LogOverflowPolicy {
+    Block,      ///< Wait for the logging thread to make room, no message is lost.
+    DiscardNew, ///< Drop the new message, never wait.
+};
+
+/// @brief Settings of the asynchronous logging (see enableAsyncLogging()).
+struct AsyncLogSettings {
+    std::size_t       queueSize      = 8192; ///< Number of records queued, preallocated.
+    LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Block;
+};
+
+/// @brief Move the writing of the messages of the default logger to a background thread.
+///
+/// The sinks of the default logger are moved behind a AsyncLogSink: the calling thread only
+/// format the message text and copy it into a preallocated lock-free queue, the sinks (the
+/// pattern formatting, the console and the editor) run on the logging thread. The messages
+/// of a thread keep their order.
+///
+/// Call it before starting other threads which log, it does nothing if the default logger is
+/// already asynchronous.
+/// @param settings The size of the queue and the overflow policy.
+void enableAsyncLogging(const AsyncLogSettings& settings = {});
+
+/// @brief Restore a synchronous default logger with the same sinks.
+///
+/// The messages queued are written before returning and the logging thread is stopped.
+/// Call it after stopping the other threads which log, it does nothing if the default
+/// logger is not asynchronous.
+void disableAsyncLogging();
+
+} // namespace fuse
@@ -0,0 +1,32 @@
+#include "LogRingSink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace fuse {
+
+LogRingSink::LogRingSink(std::size_t capacity)
+    : mRing(capacity) {}
+
+void LogRingSink::log(const spdlog::details::log_msg& msg) {
+    const bool pushed = mRing.tryPush([&msg](LogRecord& record) {
+        const std::size_t length = std::min(msg.payload.size(), LogRecord::kMaxLength);
+        std::memcpy(record.text.data(), msg.payload.data(), length);
+        record.length   = static_cast<std::uint16_t>(length);
+        record.level    = msg.level;
+        record.partial  = false;
+        record.threadId = static_cast<std::uint32_t>(msg.thread_id);
+        const auto time = msg.time.time_since_epoch();
+        record.time     = std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+    });
+    if (!pushed) {
+        mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void LogRingSink::set_pattern(const std::string& /*pattern*/) {}
+
+void LogRingSink::set_formatter(std::unique_ptr<spdlog::formatter> /*formatter*/) {}
+
+} // namespace fuse
@@ -0,0 +1,83 @@
+#pragma once
+#include <FuseCore/utils/MpscRing.h>
+
+#include <spdlog/sinks/sink.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace fuse {
+
+/// @brief A message logged, copied into the ring of a LogRingSink or a AsyncLogSink.
+struct LogRecord {
+    /// The longer messages are truncated by LogRingSink, split by AsyncLogSink. A record and
+    /// its sequence fill 4 cache lines.
+    static constexpr std::size_t kMaxLength = 224;
+
+    std::int64_t                 time{};     ///< Nanoseconds since the epoch (system clock).
+    std::uint32_t                threadId{}; ///< Thread which logged the message.
+    std::uint16_t                length{};   ///< Number of characters in text.
+    spdlog::level::level_enum    level{};    ///< Level of the message.
+    bool                         partial{};  ///< The next record of the thread continue it.
+    std::array<char, kMaxLength> text;       ///< Message, not null-terminated.
+
+    /// @brief Get the message.
+    [[nodiscard]] std::string_view getText() const noexcept { return {text.data(), length}; }
+};
+
+/// @brief spdlog sink pushing the messages into a lock-free ring, read by the editor.
+///
+/// log() only copy the message into a ring (see MpscRing), it does not take a lock and does
+/// not allocate memory, so a thread logging does not wait for the others nor for the
+/// reader. When the ring is full the message is dropped and counted. The messages are not
+/// formatted with a pattern, the reader format the time and the level when displaying them.
+///
+/// @code
+/// auto sink = std::make_shared<LogRingSink>();
+/// spdlog::default_logger()->sinks().push_back(sink); // before starting the threads
+/// sink->drain([](const LogRecord& record) { ... });  // each frame
+/// @endcode
+class LogRingSink final : public spdlog::sinks::sink {
+public:
+    static constexpr std::size_t kDefaultCapacity = 4096; ///< Number of messages, 1 MiB.
+
+    /// @brief Create a sink.
+    /// @param capacity The number of messages in the ring, a power of two.
+    explicit LogRingSink(std::size_t capacity = kDefaultCapacity);
+
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override {}
+
+    /// @brief Ignored, the messages are not formatted by the sink.
+    void set_pattern(const std::string& pattern) override;
+
+    /// @brief Ignored, the messages are not formatted by the sink.
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+    /// @brief Read the messages logged, oldest first. Only called from one thread.
+    /// @param reader Called with each message, `void(const LogRecord&)`.
+    /// @param maxCount The maximum number of messages to read.
+    /// @return The number of messages read.
+    template <class Reader>
+    std::size_t drain(Reader&&    reader,
+                      std::size_t maxCount = std::numeric_limits<std::size_t>::max()) {
+        return mRing.drain(std::forward<Reader>(reader), maxCount);
+    }
+
+    /// @brief Get the number of messages dropped because the ring was full.
+    [[nodiscard]] std::uint64_t getDroppedCount() const noexcept {
+        return mDroppedCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    MpscRing<LogRecord>        mRing;
+    std::atomic<std::uint64_t> mDroppedCount{};
+};
+
+} // namespace fuse
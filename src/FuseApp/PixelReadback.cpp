@@ -0,0 +1,50 @@
+#include "PixelReadback.h"
+
+namespace fuse {
+
+PixelReadback::PixelReadback() {
+    glCreateBuffers(1, &mBuffer);
+    glObjectLabel(GL_BUFFER, mBuffer, -1, "PixelReadback");
+    glNamedBufferStorage(mBuffer, sizeof(std::uint32_t), nullptr, GL_CLIENT_STORAGE_BIT);
+}
+
+PixelReadback::~PixelReadback() {
+    glDeleteSync(mFence);
+    glDeleteBuffers(1, &mBuffer);
+}
+
+void PixelReadback::request(GLuint framebuffer, GLenum attachment, int x, int y) {
+    glNamedFramebufferReadBuffer(framebuffer, attachment);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, mBuffer);
+    // with a pack buffer bound the pointer is a offset in it, the call does not wait.
+    glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+    glDeleteSync(mFence);
+    mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+std::optional<std::uint32_t> PixelReadback::poll() {
+    if (mFence == nullptr) {
+        return std::nullopt;
+    }
+
+    // a timeout of zero only query the state of the fence
+    const GLenum status = glClientWaitSync(mFence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        return std::nullopt;
+    }
+    glDeleteSync(mFence);
+    mFence = nullptr;
+    if (status == GL_WAIT_FAILED) {
+        return std::nullopt;
+    }
+
+    std::uint32_t value = 0;
+    glGetNamedBufferSubData(mBuffer, 0, sizeof(value), &value);
+    return value;
+}
+
+} // namespace fuse
@@ -0,0 +1,51 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <optional>
+
+namespace fuse {
+
+/// @brief Read a pixel of a framebuffer without stalling the GPU.
+///
+/// glReadPixels into client memory wait for the GPU to finish the frame. The pixel is
+/// instead copied into a pixel buffer object, with a fence inserted after the copy, and
+/// the value is fetched on a later frame once the fence is signaled.
+///
+/// @code
+/// readback.request(fbo, GL_COLOR_ATTACHMENT1, x, y); // after the draws
+/// if (const auto value = readback.poll()) {           // the next frames
+///     use(*value);
+/// }
+/// @endcode
+class PixelReadback {
+public:
+    PixelReadback();
+    ~PixelReadback();
+
+    PixelReadback(const PixelReadback&)            = delete;
+    PixelReadback(PixelReadback&&)                 = delete;
+    PixelReadback& operator=(const PixelReadback&) = delete;
+    PixelReadback& operator=(PixelReadback&&)      = delete;
+
+    /// @brief Start the copy of a pixel of a R32UI attachment, replace a pending request.
+    /// @param framebuffer The framebuffer to read.
+    /// @param attachment The color attachment to read (GL_COLOR_ATTACHMENTi).
+    /// @param x The column of the pixel, from the left.
+    /// @param y The row of the pixel, from the bottom.
+    void request(GLuint framebuffer, GLenum attachment, int x, int y);
+
+    /// @brief Get the pixel of the last request if the GPU copied it.
+    /// @return The value of the pixel, or nothing if there is no request or the copy is
+    ///         not finished. A value is returned only once per request.
+    [[nodiscard]] std::optional<std::uint32_t> poll();
+
+    /// @brief Check if a request is waiting for the GPU.
+    [[nodiscard]] bool isPending() const noexcept { return mFence != nullptr; }
+
+private:
+    GLuint mBuffer = 0;       ///< Pixel buffer object, the size of a pixel.
+    GLsync mFence  = nullptr; ///< Signaled when the copy is done, null without request.
+};
+
+} // namespace fuse
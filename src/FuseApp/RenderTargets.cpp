@@ -0,0 +1,44 @@
+#include "RenderTargets.h"
+
+#include <glad/glad.h>
+
+#include <cassert>
+
+namespace fuse {
+
+RenderTargetPool::Handle createRenderTarget(const RenderTargetDesc& desc) {
+    const auto width  = static_cast<GLsizei>(desc.width);
+    const auto height = static_cast<GLsizei>(desc.height);
+
+    GLuint handle = 0;
+    switch (desc.format) {
+        case RenderTargetFormat::RGBA8:
+            glCreateTextures(GL_TEXTURE_2D, 1, &handle);
+            glTextureStorage2D(handle, 1, GL_RGBA8, width, height);
+            glTextureParameteri(handle, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTextureParameteri(handle, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            break;
+        case RenderTargetFormat::R32UI:
+            glCreateTextures(GL_TEXTURE_2D, 1, &handle);
+            glTextureStorage2D(handle, 1, GL_R32UI, width, height);
+            glTextureParameteri(handle, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTextureParameteri(handle, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            break;
+        case RenderTargetFormat::Depth24Stencil8:
+            glCreateRenderbuffers(1, &handle);
+            glNamedRenderbufferStorage(handle, GL_DEPTH24_STENCIL8, width, height);
+            break;
+    }
+    assert(handle != 0);
+    return handle;
+}
+
+void destroyRenderTarget(RenderTargetPool::Handle handle, const RenderTargetDesc& desc) {
+    if (isRenderbuffer(desc.format)) {
+        glDeleteRenderbuffers(1, &handle);
+    } else {
+        glDeleteTextures(1, &handle);
+    }
+}
+
+} // namespace fuse
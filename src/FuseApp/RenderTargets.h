@@ -0,0 +1,24 @@
+#pragma once
+#include <FuseCore/renderer/RenderTargetPool.h>
+
+namespace fuse {
+
+/// @brief Create a OpenGL render target, the create callback of a RenderTargetPool.
+///
+/// The depth targets are renderbuffers, the other formats are textures which can be
+/// sampled or read back.
+/// @param desc The size and format of the target.
+/// @return The name of the texture or renderbuffer.
+[[nodiscard]] RenderTargetPool::Handle createRenderTarget(const RenderTargetDesc& desc);
+
+/// @brief Destroy a render target created by createRenderTarget().
+/// @param handle The name of the texture or renderbuffer.
+/// @param desc The size and format of the target.
+void destroyRenderTarget(RenderTargetPool::Handle handle, const RenderTargetDesc& desc);
+
+/// @brief Check if a render target is a renderbuffer instead of a texture.
+[[nodiscard]] constexpr bool isRenderbuffer(RenderTargetFormat format) noexcept {
+    return format == RenderTargetFormat::Depth24Stencil8;
+}
+
+} // namespace fuse
@@ -4,88 +4,85 @@
 
 #include <spdlog/spdlog.h>
 
-namespace {
-
-
-// clang-format off
-constexpr float kVertices[] = {
-        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, // back
-         0.5f, -0.5f, -0.5f,  1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, // front
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f,
-
-        -0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, // left
-        -0.5f,  0.5f, -0.5f,  1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f, -0.5f,  0.5f,  0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f, -0.5f, -0.5f,  1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f
-    };
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <numeric>
 
+namespace {
 
-// clang-format on
-
+// The draws are submitted with glMultiDrawElementsIndirect, the draws of a batch are the
+// instances of a command. aDrawIndex is a instanced attribute reading a buffer of
+// consecutive integers, so it value is the baseInstance of the command + the instance
+// index: the index of the draw in the DrawBuffer (gl_DrawID and gl_BaseInstance
+// require GL 4.6).
+// The pick id of the entity (see fuse::toPickId()) is written in the second color
+// attachment, a static batch merge several entities so it read the id per vertex.
 constexpr const char* kVertexShaderSource = R"(
-    #version 330 core
+    #version 450 core
     layout (location = 0) in  vec3 aPos;
-    layout (location = 1) in  vec4 aColor;
-    out vec4 outColor;
+    layout (location = 1) in  vec3 aNormal;
+    layout (location = 2) in  uint aDrawIndex;
+    layout (location = 3) in  uint aEntityId;
+    out vec3 outNormal;
+    flat out vec4 outColor;
+    flat out uint outEntityId;
+
+    struct DrawData {
+        mat4 transform;
+        vec4 color;
+        uint entityId;
+    };
+
+    layout (std430, binding = 0) readonly buffer DrawBuffer {
+        DrawData draws[];
+    };
 
     uniform mat4 proj;
     uniform mat4 view;
-    uniform mat4 transform;
 
     void main()
     {
-        outColor = aColor;
-        gl_Position = proj * view * transform * vec4(aPos, 1.0f);
+        DrawData draw = draws[aDrawIndex];
+        outNormal = mat3(draw.transform) * aNormal;
+        outColor = draw.color;
+        outEntityId = draw.entityId != 0u ? draw.entityId : aEntityId;
+        gl_Position = proj * view * draw.transform * vec4(aPos, 1.0f);
     }
 )";
 
 constexpr const char* kFragmentShaderSource = R"(
-    #version 330 core
-    in  vec4 outColor;
-
-    uniform vec4 color;
+    #version 450 core
+    in  vec3 outNormal;
+    flat in vec4 outColor;
+    flat in uint outEntityId;
 
-    out vec4 FragColor;
+    layout (location = 0) out vec4 FragColor;
+    layout (location = 1) out uint FragEntityId;
     void main()
     {
-        //FragColor = vec4(1.0f, 0.5f, 0.2f, 1.0f);
-        FragColor = color * outColor;
+        const vec3 lightDir = normalize(vec3(0.4f, 1.0f, 0.6f));
+        float      light    = 0.3f + 0.7f * max(dot(normalize(outNormal), lightDir), 0.0f);
+        FragColor = vec4(outColor.rgb * light, outColor.a);
+        FragEntityId = outEntityId;
     }
 )";
 
+/// @brief Binding point of the DrawBuffer in the vertex shader.
+constexpr GLuint kDrawBufferBinding = 0;
+
+/// @brief Vertex buffer binding of the draw indices.
+constexpr GLuint kDrawIndexBinding = 1;
+
+/// @brief Vertex buffer binding of the entity ids of the static batches.
+constexpr GLuint kEntityIdBinding = 2;
+
+/// @brief Vertex attribute of the entity ids, only enabled for the static batches.
+constexpr GLuint kEntityIdAttrib = 3;
+
+GLenum toGLIndexType(fuse::IndexType type) noexcept {
+    return type == fuse::IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
 
 } // namespace
 
@@ -127,44 +124,26 @@ SceneRenderer::SceneRenderer()
         spdlog::error("SHADER::PROGRAM::COMPILATION_FAILED\n {}", infoLog);
     }
 
-#define USE_DSA
-#ifdef USE_DSA
-    // create the vertex buffer
-    glCreateBuffers(1, &mVbo);
-    glObjectLabel(GL_BUFFER, mVbo, -1, "CubeVBO");
-    glNamedBufferData(mVbo, sizeof(kVertices), kVertices, GL_STATIC_DRAW);
-
-    // create the vertex array object
+    // the buffers are created on the first syncMeshes()
     glCreateVertexArrays(1, &mVao);
-    glObjectLabel(GL_VERTEX_ARRAY, mVao, -1, "CubeVAO");
+    glObjectLabel(GL_VERTEX_ARRAY, mVao, -1, "MeshVAO");
 
     glEnableVertexArrayAttrib(mVao, 0 /*attribindex*/);
     glVertexArrayAttribFormat(mVao, 0 /*attribindex*/, 3, GL_FLOAT, GL_FALSE, 0);
     glVertexArrayAttribBinding(mVao, 0 /*attribindex*/, 0 /*bindingindex*/);
 
     glEnableVertexArrayAttrib(mVao, 1 /*attribindex*/);
-    glVertexArrayAttribFormat(mVao, 1 /*attribindex*/, 4, GL_FLOAT, GL_FALSE, 20);
+    glVertexArrayAttribFormat(
+      mVao, 1 /*attribindex*/, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, normal));
     glVertexArrayAttribBinding(mVao, 1 /*attribindex*/, 0 /*bindingindex*/);
 
-    glVertexArrayVertexBuffer(mVao, 0 /*bindingindex*/, mVbo, 0 /*offset*/, 9 * sizeof(float));
-#else
-    glGenVertexArrays(1, &mVao);
-    glGenBuffers(1, &mVbo);
+    glEnableVertexArrayAttrib(mVao, 2 /*attribindex*/);
+    glVertexArrayAttribIFormat(mVao, 2 /*attribindex*/, 1, GL_UNSIGNED_INT, 0);
+    glVertexArrayAttribBinding(mVao, 2 /*attribindex*/, kDrawIndexBinding);
+    glVertexArrayBindingDivisor(mVao, kDrawIndexBinding, 1);
 
-    glBindVertexArray(mVao);
-    glBindBuffer(GL_ARRAY_BUFFER, mVbo);
-
-    glObjectLabel(GL_BUFFER, mVbo, -1, "CubeVBO");
-    glObjectLabel(GL_VERTEX_ARRAY, mVao, -1, "CubeVAO");
-
-    glBufferData(GL_ARRAY_BUFFER, sizeof(kVertices), kVertices, GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), nullptr);
-
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 9 * sizeof(float), reinterpret_cast<void*>(20));
-#endif
+    glVertexArrayAttribIFormat(mVao, kEntityIdAttrib, 1, GL_UNSIGNED_INT, 0);
+    glVertexArrayAttribBinding(mVao, kEntityIdAttrib, kEntityIdBinding);
 }
 
 SceneRenderer::~SceneRenderer() {
@@ -172,13 +151,185 @@ SceneRenderer::~SceneRenderer() {
     glDeleteShader(mVertexShader);
     glDeleteShader(mFragmentShader);
     glDeleteVertexArrays(1, &mVao);
-    glDeleteBuffers(1, &mVbo);
+    glDeleteBuffers(1, &mVertexBuffer.id);
+    glDeleteBuffers(1, &mIndexBuffer16.id);
+    glDeleteBuffers(1, &mIndexBuffer32.id);
+    glDeleteBuffers(1, &mDrawBuffer.id);
+    glDeleteBuffers(1, &mDrawIndexBuffer.id);
+    glDeleteBuffers(1, &mIndirectBuffer.id);
+    glDeleteBuffers(1, &mStaticVertices.id);
+    glDeleteBuffers(1, &mStaticEntityIds.id);
+    glDeleteBuffers(1, &mStaticIndices.id);
+    glDeleteBuffers(1, &mStaticDraws.id);
+    glDeleteBuffers(1, &mStaticCommands.id);
+}
+
+void SceneRenderer::syncMeshes(const MeshRegistry& registry) {
+    // a other registry, upload everything again
+    if (&registry != mSyncedRegistry) {
+        mVertexBuffer.size  = 0;
+        mIndexBuffer16.size = 0;
+        mIndexBuffer32.size = 0;
+        mSyncedRegistry     = &registry;
+    }
+
+    const auto vertices  = std::as_bytes(registry.getVertices());
+    const auto indices16 = std::as_bytes(registry.getIndices16());
+    const auto indices32 = std::as_bytes(registry.getIndices32());
+    if (updateBuffer(mVertexBuffer, vertices, "MeshVertices")) {
+        glVertexArrayVertexBuffer(mVao, 0 /*bindingindex*/, mVertexBuffer.id, 0, sizeof(Vertex));
+    }
+    updateBuffer(mIndexBuffer16, indices16, "MeshIndices16");
+    updateBuffer(mIndexBuffer32, indices32, "MeshIndices32");
+
+    mMeshes.assign(registry.getInfos().begin(), registry.getInfos().end());
+}
+
+bool SceneRenderer::reserveBuffer(GpuBuffer& buffer, std::size_t size, const char* label) {
+    if (size <= buffer.capacity) {
+        return false;
+    }
+
+    // the content is lost, the caller upload it again
+    glDeleteBuffers(1, &buffer.id);
+    glCreateBuffers(1, &buffer.id);
+    glObjectLabel(GL_BUFFER, buffer.id, -1, label);
+    buffer.capacity = std::max(size, buffer.capacity * 2);
+    buffer.size     = 0;
+    glNamedBufferStorage(
+      buffer.id, static_cast<GLsizeiptr>(buffer.capacity), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    return true;
+}
+
+bool SceneRenderer::updateBuffer(GpuBuffer&                 buffer,
+                                 std::span<const std::byte> data,
+                                 const char*                label) {
+    const bool recreated = reserveBuffer(buffer, data.size(), label);
+
+    // the registry is append only, only the new data need to be uploaded.
+    if (data.size() > buffer.size) {
+        glNamedBufferSubData(buffer.id,
+                             static_cast<GLintptr>(buffer.size),
+                             static_cast<GLsizeiptr>(data.size() - buffer.size),
+                             data.data() + buffer.size);
+    }
+    buffer.size = data.size();
+    return recreated;
+}
+
+void SceneRenderer::buildCommands(const RenderList& renderList) {
+    static_assert(sizeof(DrawData) == 96, "Must match the std430 DrawData layout.");
+    static_assert(sizeof(DrawElementsIndirectCommand) == 20);
+
+    mDrawData.clear();
+    mCommands.clear();
+    mSubmits.clear();
+
+    std::uint64_t previousState = 0;
+    for (const auto& item : mRenderQueue.getItems()) {
+        const std::uint32_t meshId = renderList.meshIds[item.index];
+        assert(meshId < mMeshes.size() && "Mesh not uploaded, see syncMeshes().");
+        const MeshInfo& mesh        = mMeshes[meshId];
+        const auto      fields      = SortKey::Decode(item.key);
+        const bool      transparent = fields.pass == RenderPass::Transparent;
+        const auto      drawIndex   = static_cast<std::uint32_t>(mDrawData.size());
+
+        mDrawData.push_back({.transform = renderList.worldMatrices[item.index].transposed(),
+                             .color     = renderList.colors[item.index],
+                             .entityId  = renderList.entityIds[item.index]});
+
+        // a submit per run of draws with the same index buffer and blending.
+        if (mSubmits.empty() || mSubmits.back().indexType != mesh.indexType ||
+            mSubmits.back().transparent != transparent) {
+            mSubmits.push_back({.firstCommand = static_cast<std::uint32_t>(mCommands.size()),
+                                .commandCount = 0,
+                                .indexType    = mesh.indexType,
+                                .transparent  = transparent});
+        }
+
+        // consecutive draws of the same state are instances of a command.
+        const std::uint64_t state =
+          SortKey::Make(fields.pass, fields.shader, fields.material, fields.mesh);
+        if (mSubmits.back().commandCount > 0 && state == previousState) {
+            mCommands.back().instanceCount++;
+            continue;
+        }
+        mCommands.push_back({.count         = mesh.indexCount,
+                             .instanceCount = 1,
+                             .firstIndex    = mesh.firstIndex,
+                             .baseVertex    = static_cast<std::int32_t>(mesh.baseVertex),
+                             .baseInstance  = drawIndex});
+        mSubmits.back().commandCount++;
+        previousState = state;
+    }
 }
 
 void SceneRenderer::renderScene(const Scene&      scene,
                                 const fuse::Mat4& proj,
-                                const fuse::Mat4& view) const {
+                                const fuse::Mat4& view,
+                                float             interpolationAlpha) {
+    const auto& registry = scene.getMeshRegistry();
+    syncMeshes(registry);
+    updateStaticBatches(scene);
+    extractRenderList(scene, interpolationAlpha, mRenderList, &mWorkers, true /*skipStatic*/);
+
+    mOcclusionCuller.begin(proj * view);
+    const bool hasOccluders = !mStaticBatcher.getOccluders().empty() ||
+                              std::ranges::contains(mRenderList.occluders, 1);
+    if (mOcclusionCulling && hasOccluders) {
+        for (const auto& occluder : mStaticBatcher.getOccluders()) {
+            mOcclusionCuller.addOccluder(registry, occluder.mesh, occluder.world);
+        }
+        for (std::size_t i = 0; i < mRenderList.size(); i++) {
+            if (mRenderList.occluders[i] != 0) {
+                mOcclusionCuller.addOccluder(
+                  registry, MeshHandle{mRenderList.meshIds[i]}, mRenderList.worldMatrices[i]);
+            }
+        }
+        mOcclusionCuller.rasterize(&mWorkers);
+        mOcclusionCuller.cull(mRenderList, registry.getInfos(), &mWorkers);
+    }
+
+    // the static batches are opaque, draw them before the transparent meshes of the list.
+    drawStaticBatches(proj, view);
+    renderList(mRenderList, proj, view);
+}
+
+void SceneRenderer::updateStaticBatches(const Scene& scene) {
+    if (!mStaticBatcher.update(scene)) {
+        return;
+    }
+
+    std::vector<DrawData>                    draws;
+    std::vector<DrawElementsIndirectCommand> commands;
+    for (const auto& batch : mStaticBatcher.getBatches()) {
+        commands.push_back({.count         = batch.indexCount,
+                            .instanceCount = 1,
+                            .firstIndex    = batch.firstIndex,
+                            .baseVertex    = 0,
+                            .baseInstance  = static_cast<std::uint32_t>(draws.size())});
+        // no entity id, it is read per vertex
+        draws.push_back({.transform = Mat4::kIdentity, .color = batch.color, .entityId = 0});
+    }
+
+    // the batches are replaced, not appended
+    const auto upload = [](GpuBuffer& buffer, std::span<const std::byte> data, const char* label) {
+        buffer.size = 0;
+        updateBuffer(buffer, data, label);
+    };
+    upload(mStaticVertices, std::as_bytes(mStaticBatcher.getVertices()), "StaticVertices");
+    upload(mStaticEntityIds, std::as_bytes(mStaticBatcher.getEntityIds()), "StaticEntityIds");
+    upload(mStaticIndices, std::as_bytes(mStaticBatcher.getIndices()), "StaticIndices");
+    upload(mStaticDraws, std::as_bytes(std::span(draws)), "StaticDrawBuffer");
+    upload(mStaticCommands, std::as_bytes(std::span(commands)), "StaticIndirectBuffer");
+    reserveDrawIndices(draws.size());
+}
 
+void SceneRenderer::drawStaticBatches(const fuse::Mat4& proj, const fuse::Mat4& view) {
+    const auto batches = mStaticBatcher.getBatches();
+    if (batches.empty()) {
+        return;
+    }
 
     glUseProgram(mShaderProgram);
     const GLint viewLoc = glGetUniformLocation(mShaderProgram, "view");
@@ -186,25 +337,95 @@ void SceneRenderer::renderScene(const Scene&      scene,
     glUniformMatrix4fv(viewLoc, 1, GL_TRUE /*transpose*/, view.ptr());
     glUniformMatrix4fv(projLoc, 1, GL_TRUE /*transpose*/, proj.ptr());
 
-    const auto& registry = scene.getRegistry();
-    for (auto&& [entity, transform, mesh] : registry.view<fuse::CTransform, fuse::CMesh>().each()) {
+    // same vertex format as the meshes, only the buffers change.
+    glBindVertexArray(mVao);
+    glVertexArrayVertexBuffer(mVao, 0 /*bindingindex*/, mStaticVertices.id, 0, sizeof(Vertex));
+    glVertexArrayVertexBuffer(
+      mVao, kEntityIdBinding, mStaticEntityIds.id, 0, sizeof(std::uint32_t));
+    glEnableVertexArrayAttrib(mVao, kEntityIdAttrib);
+    glVertexArrayElementBuffer(mVao, mStaticIndices.id);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kDrawBufferBinding, mStaticDraws.id);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mStaticCommands.id);
+    glMultiDrawElementsIndirect(GL_TRIANGLES,
+                                GL_UNSIGNED_INT,
+                                nullptr,
+                                static_cast<GLsizei>(batches.size()),
+                                0 /*tightly packed*/);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glDisableVertexArrayAttrib(mVao, kEntityIdAttrib);
+    glVertexArrayVertexBuffer(mVao, 0 /*bindingindex*/, mVertexBuffer.id, 0, sizeof(Vertex));
+}
+
+void SceneRenderer::reserveDrawIndices(std::size_t drawCount) {
+    // draw indices 0..n, only written when the buffer grow
+    const std::size_t drawIndexSize = drawCount * sizeof(std::uint32_t);
+    if (drawIndexSize <= mDrawIndexBuffer.size) {
+        return;
+    }
+    reserveBuffer(mDrawIndexBuffer, drawIndexSize, "DrawIndexBuffer");
+    std::vector<std::uint32_t> indices(mDrawIndexBuffer.capacity / sizeof(std::uint32_t));
+    std::iota(indices.begin(), indices.end(), 0U);
+    glNamedBufferSubData(mDrawIndexBuffer.id,
+                         0,
+                         static_cast<GLsizeiptr>(indices.size() * sizeof(std::uint32_t)),
+                         indices.data());
+    mDrawIndexBuffer.size = indices.size() * sizeof(std::uint32_t);
+    glVertexArrayVertexBuffer(
+      mVao, kDrawIndexBinding, mDrawIndexBuffer.id, 0, sizeof(std::uint32_t));
+}
 
-        const auto translationMat = fuse::Mat4::CreateTranslation(transform.translation);
-        const auto scaleMat       = fuse::Mat4::CreateScaling(transform.scale);
-        const auto rotationMat    = fuse::Mat4::CreateRotationX(degrees(transform.rotation.x)) *
-                                 fuse::Mat4::CreateRotationY(degrees(transform.rotation.y)) *
-                                 fuse::Mat4::CreateRotationZ(degrees(transform.rotation.z));
-        const auto transformMat = translationMat * rotationMat * scaleMat;
+void SceneRenderer::renderList(const RenderList& renderList,
+                               const fuse::Mat4& proj,
+                               const fuse::Mat4& view) {
+    mRenderQueue.build(renderList, view);
+    mStats = mRenderQueue.computeStats();
+    buildCommands(renderList);
+    if (mCommands.empty()) {
+        return;
+    }
 
-        const GLint transformLoc = glGetUniformLocation(mShaderProgram, "transform");
-        glUniformMatrix4fv(transformLoc, 1, GL_TRUE /*transpose*/, transformMat.ptr());
+    // per frame data
+    const auto drawData = std::as_bytes(std::span(mDrawData));
+    const auto commands = std::as_bytes(std::span(mCommands));
+    reserveBuffer(mDrawBuffer, drawData.size(), "DrawBuffer");
+    reserveBuffer(mIndirectBuffer, commands.size(), "IndirectBuffer");
+    glNamedBufferSubData(
+      mDrawBuffer.id, 0, static_cast<GLsizeiptr>(drawData.size()), drawData.data());
+    glNamedBufferSubData(
+      mIndirectBuffer.id, 0, static_cast<GLsizeiptr>(commands.size()), commands.data());
 
-        const GLint colorLoc = glGetUniformLocation(mShaderProgram, "color");
-        glUniform4f(colorLoc, mesh.color.x, mesh.color.y, mesh.color.z, mesh.color.w);
+    reserveDrawIndices(mDrawData.size());
 
-        glBindVertexArray(mVao);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+    glUseProgram(mShaderProgram);
+    const GLint viewLoc = glGetUniformLocation(mShaderProgram, "view");
+    const GLint projLoc = glGetUniformLocation(mShaderProgram, "proj");
+    glUniformMatrix4fv(viewLoc, 1, GL_TRUE /*transpose*/, view.ptr());
+    glUniformMatrix4fv(projLoc, 1, GL_TRUE /*transpose*/, proj.ptr());
+
+    glBindVertexArray(mVao);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kDrawBufferBinding, mDrawBuffer.id);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mIndirectBuffer.id);
+    for (const auto& submit : mSubmits) {
+        // the transparent draws are last, blend them without hiding the draws behind.
+        if (submit.transparent) {
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glDepthMask(GL_FALSE);
+        }
+        // all the meshes share the vertex buffer, only the index buffer can change.
+        glVertexArrayElementBuffer(mVao,
+                                   submit.indexType == IndexType::UInt16 ? mIndexBuffer16.id
+                                                                         : mIndexBuffer32.id);
+        glMultiDrawElementsIndirect(
+          GL_TRIANGLES,
+          toGLIndexType(submit.indexType),
+          reinterpret_cast<const void*>(submit.firstCommand * sizeof(DrawElementsIndirectCommand)),
+          static_cast<GLsizei>(submit.commandCount),
+          0 /*tightly packed*/);
     }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
 }
 
 } // namespace fuse
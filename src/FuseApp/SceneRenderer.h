@@ -1,9 +1,20 @@
 #pragma once
 #include <FuseCore/math/Mat4.h>
+#include <FuseCore/renderer/MeshRegistry.h>
+#include <FuseCore/renderer/OcclusionCuller.h>
+#include <FuseCore/renderer/RenderQueue.h>
+#include <FuseCore/scene/RenderList.h>
 #include <FuseCore/scene/Scene.h>
+#include <FuseCore/scene/StaticBatcher.h>
+#include <FuseCore/utils/WorkerPool.h>
 
 #include <glad/glad.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
 namespace fuse {
 
 class SceneRenderer {
@@ -17,14 +28,152 @@ public:
     SceneRenderer& operator=(const SceneRenderer&) = delete;
     SceneRenderer& operator=(SceneRenderer&&)      = delete;
 
-    void renderScene(const Scene& scene, const fuse::Mat4& proj, const fuse::Mat4& view) const;
+    /// @brief Upload the meshes of a registry to the GPU.
+    ///
+    /// All the meshes live in three shared buffers (vertices, 16 and 32 bits indices),
+    /// only the meshes added since the last call are uploaded.
+    /// Must be called before renderList() when meshes are added, the registry must not be
+    /// modified during the call.
+    /// @param registry The meshes referenced by the render lists.
+    void syncMeshes(const MeshRegistry& registry);
+
+    /// @brief Draw all the meshes of a scene.
+    ///
+    /// The meshes of the scene are synchronized, then the scene is extracted into a
+    /// render list owned by the renderer, which is reused from a frame to the next.
+    /// When the occlusion culling is enabled, the meshes hidden behind the occluders
+    /// (see CMesh::occluder) are removed from the list before it is drawn.
+    /// The opaque static entities (see CStatic) are not extracted, they are drawn from
+    /// static batches uploaded only when the static entities of the scene change.
+    /// The pick id of the entities (see toPickId()) is written in the color attachment 1
+    /// of the framebuffer when it has a R32UI draw buffer there, for the picking.
+    /// @param scene The scene to draw.
+    /// @param proj The projection matrix.
+    /// @param view The view matrix.
+    /// @param interpolationAlpha Interpolation factor between the previous and the current
+    ///                           transform of the entities (see interpolateTransform()).
+    void renderScene(const Scene&      scene,
+                     const fuse::Mat4& proj,
+                     const fuse::Mat4& view,
+                     float             interpolationAlpha = 1.0f);
+
+    /// @brief Draw a render list extracted from a scene (see extractRenderList()).
+    ///
+    /// The draws are submitted in the order of a render queue: the opaque meshes
+    /// grouped by state and front to back, then the transparent meshes back to front.
+    /// The matrices and colors are uploaded in a storage buffer and all the draws are
+    /// submitted with a few glMultiDrawElementsIndirect calls (one per index type and
+    /// blending state), consecutive draws of the same mesh are instances of a command.
+    /// @param renderList The meshes to draw.
+    /// @param proj The projection matrix.
+    /// @param view The view matrix.
+    void renderList(const RenderList& renderList,
+                    const fuse::Mat4& proj,
+                    const fuse::Mat4& view);
+
+    /// @brief Get the number of draws and state changes of the last frame.
+    [[nodiscard]] const RenderQueueStats& getStats() const noexcept { return mStats; }
+
+    /// @brief Get the static batches drawn by renderScene().
+    [[nodiscard]] const StaticBatcher& getStaticBatcher() const noexcept {
+        return mStaticBatcher;
+    }
+
+    /// @brief Enable or disable the occlusion culling of renderScene().
+    void setOcclusionCulling(bool enabled) noexcept { mOcclusionCulling = enabled; }
+
+    /// @brief Check if renderScene() cull the meshes hidden by the occluders.
+    [[nodiscard]] bool isOcclusionCulling() const noexcept { return mOcclusionCulling; }
+
+    /// @brief Get the occlusion culling counters of the last renderScene().
+    [[nodiscard]] const OcclusionStats& getOcclusionStats() const noexcept {
+        return mOcclusionCuller.getStats();
+    }
 
 private:
-    unsigned int mVertexShader   = 0;
-    unsigned int mFragmentShader = 0;
-    unsigned int mShaderProgram  = 0;
-    unsigned int mVao            = 0;
-    unsigned int mVbo            = 0;
+    /// @brief A GPU buffer filled from the start.
+    struct GpuBuffer {
+        unsigned int id{};       ///< The buffer object.
+        std::size_t  size{};     ///< Number of bytes uploaded.
+        std::size_t  capacity{}; ///< Size of the buffer in bytes.
+    };
+
+    /// @brief Per draw data read by the vertex shader (std430 layout).
+    struct DrawData {
+        Mat4          transform;    ///< World matrix, column major.
+        Vec4          color;        ///< Color of the mesh.
+        std::uint32_t entityId{};   ///< Pick id of the entity, 0 to read it per vertex.
+        std::uint32_t padding[3]{}; ///< std430 align the struct on a vec4.
+    };
+
+    /// @brief Command read by glMultiDrawElementsIndirect.
+    struct DrawElementsIndirectCommand {
+        std::uint32_t count;         ///< Number of indices.
+        std::uint32_t instanceCount; ///< Number of draws of the batch.
+        std::uint32_t firstIndex;    ///< First index in the index buffer.
+        std::int32_t  baseVertex;    ///< Added to the indices.
+        std::uint32_t baseInstance;  ///< Index of the first draw in the DrawBuffer.
+    };
+
+    /// @brief Commands submitted in a single glMultiDrawElementsIndirect.
+    struct Submit {
+        std::uint32_t firstCommand; ///< First command in the indirect buffer.
+        std::uint32_t commandCount; ///< Number of commands.
+        IndexType     indexType;    ///< Index buffer of the commands.
+        bool          transparent;  ///< The draws are blended.
+    };
+
+    /// @brief Make sure the buffer can hold @p size bytes, recreate it empty otherwise.
+    /// @return True if the buffer was recreated.
+    static bool reserveBuffer(GpuBuffer& buffer, std::size_t size, const char* label);
+
+    /// @brief Upload the end of @p data, or recreate the buffer if it is too small.
+    /// @return True if the buffer was recreated.
+    static bool updateBuffer(GpuBuffer&                 buffer,
+                             std::span<const std::byte> data,
+                             const char*                label);
+
+    /// @brief Build the draw data and the commands from the render queue.
+    void buildCommands(const RenderList& renderList);
+
+    /// @brief Make sure the draw index buffer hold at least @p drawCount indices.
+    void reserveDrawIndices(std::size_t drawCount);
+
+    /// @brief Rebuild and upload the static batches if the static entities changed.
+    void updateStaticBatches(const Scene& scene);
+
+    /// @brief Draw the static batches, one command per batch.
+    void drawStaticBatches(const fuse::Mat4& proj, const fuse::Mat4& view);
+
+    unsigned int          mVertexShader   = 0;
+    unsigned int          mFragmentShader = 0;
+    unsigned int          mShaderProgram  = 0;
+    unsigned int          mVao            = 0;
+    GpuBuffer             mVertexBuffer;     ///< Vertices of all the meshes.
+    GpuBuffer             mIndexBuffer16;    ///< 16 bits indices of all the meshes.
+    GpuBuffer             mIndexBuffer32;    ///< 32 bits indices of all the meshes.
+    GpuBuffer             mDrawBuffer;       ///< DrawData of the frame.
+    GpuBuffer             mDrawIndexBuffer;  ///< Consecutive integers, see aDrawIndex.
+    GpuBuffer             mIndirectBuffer;   ///< Commands of the frame.
+    GpuBuffer             mStaticVertices;   ///< Vertices of the static batches.
+    GpuBuffer             mStaticEntityIds;  ///< Pick id of each static vertex.
+    GpuBuffer             mStaticIndices;    ///< Indices of the static batches.
+    GpuBuffer             mStaticDraws;      ///< DrawData of each static batch.
+    GpuBuffer             mStaticCommands;   ///< One command per static batch.
+    std::vector<MeshInfo> mMeshes;           ///< Meshes uploaded, indexed by handle.
+    const MeshRegistry*   mSyncedRegistry{}; ///< Registry uploaded by syncMeshes().
+    RenderList            mRenderList;       ///< List extracted by renderScene().
+    RenderQueue           mRenderQueue;      ///< Draw order of the last frame.
+    RenderQueueStats      mStats;            ///< Stats of the last frame.
+    OcclusionCuller       mOcclusionCuller;  ///< Cull the list of renderScene().
+    StaticBatcher         mStaticBatcher;    ///< Static batches of renderScene().
+    WorkerPool            mWorkers;          ///< Threads of renderScene().
+
+    std::vector<DrawData>                    mDrawData; ///< Draws in submission order.
+    std::vector<DrawElementsIndirectCommand> mCommands; ///< One command per batch.
+    std::vector<Submit>                      mSubmits;  ///< Multi draw calls of the frame.
+
+    bool mOcclusionCulling{true}; ///< Cull the meshes hidden by the occluders in renderScene().
 };
 
 } // namespace fuse
@@ -8,18 +8,26 @@ namespace fuse {
 void TransformerSystem::update(Scene& scene, float deltaTime) {
     auto& registry = scene.getRegistry();
 
+    bool moved = false;
     for (auto&& [entity, transform, rotator] : registry.view<CTransform, CRotator>().each()) {
         transform.rotation.y += (rotator.angle * deltaTime).asDegrees();
+        moved = true;
     }
 
     for (auto&& [entity, transform, translator] : registry.view<CTransform, CTranslator>().each()) {
         if (translator.duration > 0) {
             transform.translation += translator.direction * deltaTime;
             translator.duration -= deltaTime;
+            moved = true;
         } else {
             registry.remove<fuse::CTranslator>(entity);
         }
     }
+
+    // the transforms are modified in place, the registry does not signal the changes.
+    if (moved) {
+        scene.markTransformsChanged();
+    }
 }
 
 } // namespace fuse
@@ -30,7 +30,9 @@ bool Window::create(const WindowCreateInfo& info) {
 
     //windowFlags |= SDL_WINDOW_FULLSCREEN;
     windowFlags |= SDL_WINDOW_OPENGL;
-    //windowFlags |= SDL_WINDOW_HIDDEN;
+    if (!info.visible) {
+        windowFlags |= SDL_WINDOW_HIDDEN;
+    }
     //windowFlags |= SDL_WINDOW_TRANSPARENT;
 
     //windowFlags |= SDL_WINDOW_KEYBOARD_GRABBED;
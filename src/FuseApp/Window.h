@@ -17,6 +17,7 @@ struct WindowCreateInfo {
     int         width     = 1600;         ///< The window width.
     int         height    = 900;          ///< The window height.
     bool        resizable = true;         ///< Should the window be resizable by the user.
+    bool        visible   = true;         ///< Should the window be shown when created.
 };
 
 /// @brief Platform independent window
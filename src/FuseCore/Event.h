@@ -333,6 +333,9 @@ public:
     TextInputEvent(const char* text)
         : mText(text) {}
 
+    /// @brief Get the input text (UTF-8). The text is owned by the event source.
+    [[nodiscard]] const char* getText() const noexcept { return mText; }
+
     // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
     [[nodiscard]] std::string toString() const;
 
@@ -354,6 +357,32 @@ concept EventRequirement = requires(T t) {
 /// @brief
 class Event {
 public:
+    /// @brief All the event types an Event can hold.
+    using Types = std::variant<
+      // Windows event
+      WindowCloseEvent,
+      WindowDisplayChangedEvent,
+      WindowMouseEnterEvent,
+      WindowMouseLeaveEvent,
+      WindowFocusGainEvent,
+      WindowFocusLostEvent,
+      WindowFullScreenEnterEvent,
+      WindowFullScreenLeaveEvent,
+      WindowMovedEvent,
+      WindowMaximizedEvent,
+      WindowMinimizedEvent,
+      WindowResizedEvent,
+      WindowRestoredEvent,
+      // Mouse event
+      MouseButtonEvent,
+      MouseMovedEvent,
+      MouseScrolledEvent,
+      // Key event
+      KeyPressedEvent,
+      KeyReleasedEvent,
+      // Text input event
+      TextInputEvent>;
+
     /// @brief Construct a event from the real event type.
     ///
     /// @tparam T The type of the event.
@@ -407,37 +436,18 @@ public:
         return std::visit(visitor, mData);
     }
 
-private:
-    std::variant<
-      // Windows event
-      WindowCloseEvent,
-      WindowDisplayChangedEvent,
-      WindowMouseEnterEvent,
-      WindowMouseLeaveEvent,
-      WindowFocusGainEvent,
-      WindowFocusLostEvent,
-      WindowFullScreenEnterEvent,
-      WindowFullScreenLeaveEvent,
-      WindowMovedEvent,
-      WindowMaximizedEvent,
-      WindowMinimizedEvent,
-      WindowResizedEvent,
-      WindowRestoredEvent,
-      // Mouse event
-      MouseButtonEvent,
-      MouseMovedEvent,
-      MouseScrolledEvent,
-      // Key event
-      KeyPressedEvent,
-      KeyReleasedEvent,
-      // Text input event
-      TextInputEvent>
-      mData;
-
+    /// @brief Visit the underlying event.
+    /// @param visitor A callable accepting every event type.
     template <typename T>
     decltype(auto) visit(T&& visitor) const {
         return std::visit(std::forward<T>(visitor), mData);
     }
+
+    /// @brief Get the index of the underlying event type in \p Types.
+    [[nodiscard]] std::size_t getTypeIndex() const noexcept { return mData.index(); }
+
+private:
+    Types mData;
 };
 
 } // namespace fuse
@@ -0,0 +1,256 @@
+#include "EventRecorder.h"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace {
+
+constexpr std::array<char, 4> kMagic   = {'F', 'E', 'V', 'R'};
+constexpr std::uint16_t       kVersion = 1;
+
+constexpr std::size_t kEventTypeCount = std::variant_size_v<fuse::Event::Types>;
+static_assert(kEventTypeCount <= std::numeric_limits<std::uint8_t>::max());
+
+/// @brief Header of a log.
+struct Header {
+    std::array<char, 4> magic;
+    std::uint16_t       version;
+    std::uint16_t       eventTypeCount;
+    std::uint32_t       layoutHash;
+    std::uint32_t       frameCount;
+};
+
+/// @brief Header of a frame (stored field by field, without padding).
+struct FrameHeader {
+    std::uint32_t index;
+    float         deltaTime;
+    std::uint32_t eventCount;
+};
+
+/// @brief Event types stored as raw bytes in the log.
+template <class T>
+constexpr bool kIsRawEvent = !std::is_same_v<T, fuse::TextInputEvent>;
+
+/// @brief Hash the size of all the event types, so a log from a other build is rejected.
+template <std::size_t... I>
+consteval std::uint32_t computeLayoutHash(std::index_sequence<I...> /*unused*/) {
+    std::uint32_t hash = 2166136261U; // FNV-1a
+    ((hash = (hash ^ static_cast<std::uint32_t>(
+                       sizeof(std::variant_alternative_t<I, fuse::Event::Types>))) *
+             16777619U),
+     ...);
+    return hash;
+}
+
+constexpr std::uint32_t kLayoutHash =
+  computeLayoutHash(std::make_index_sequence<kEventTypeCount>{});
+
+template <class T>
+void write(std::vector<char>& buffer, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+/// @brief Bounds checked reader over a log.
+class Reader {
+public:
+    Reader(std::span<const char> data, std::size_t offset) noexcept
+        : mData(data)
+        , mOffset(offset) {}
+
+    template <class T>
+    bool read(T& value) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (mData.size() - mOffset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, mData.data() + mOffset, sizeof(T));
+        mOffset += sizeof(T);
+        return true;
+    }
+
+    /// @brief Read a event type which is not default constructible.
+    template <class T>
+    std::optional<T> readRaw() noexcept {
+        std::array<char, sizeof(T)> bytes{};
+        if (!read(bytes)) {
+            return std::nullopt;
+        }
+        return std::bit_cast<T>(bytes);
+    }
+
+    bool readString(std::string& str) {
+        std::uint16_t size{};
+        if (!read(size) || mData.size() - mOffset < size) {
+            return false;
+        }
+        str.assign(mData.data() + mOffset, size);
+        mOffset += size;
+        return true;
+    }
+
+    [[nodiscard]] std::size_t getOffset() const noexcept { return mOffset; }
+
+private:
+    std::span<const char> mData;
+    std::size_t           mOffset;
+};
+
+using DecodeFunction = bool (*)(Reader&, std::vector<fuse::Event>&, std::deque<std::string>&);
+
+template <class T>
+bool decodeEvent(Reader& reader, std::vector<fuse::Event>& events, std::deque<std::string>& texts) {
+    if constexpr (kIsRawEvent<T>) {
+        const auto event = reader.template readRaw<T>();
+        if (!event) {
+            return false;
+        }
+        events.emplace_back(*event);
+    } else {
+        // deque keep the address of the strings stable while the frame grow.
+        auto& text = texts.emplace_back();
+        if (!reader.readString(text)) {
+            return false;
+        }
+        events.emplace_back(T(text.c_str()));
+    }
+    return true;
+}
+
+template <std::size_t... I>
+constexpr std::array<DecodeFunction, sizeof...(I)> makeDecodeTable(
+  std::index_sequence<I...> /*unused*/) {
+    return {&decodeEvent<std::variant_alternative_t<I, fuse::Event::Types>>...};
+}
+
+constexpr auto kDecodeTable = makeDecodeTable(std::make_index_sequence<kEventTypeCount>{});
+
+} // namespace
+
+namespace fuse {
+
+EventRecorder::EventRecorder() { clear(); }
+
+void EventRecorder::record(const Event& event) {
+    assert(mFrameEventCount < std::numeric_limits<std::uint32_t>::max() && "Too many events.");
+    write(mFrameEvents, static_cast<std::uint8_t>(event.getTypeIndex()));
+    event.visit([this]<class T>(const T& e) {
+        if constexpr (kIsRawEvent<T>) {
+            static_assert(std::is_trivially_copyable_v<T>, "Event type can't be recorded.");
+            write(mFrameEvents, e);
+        } else {
+            const char*         text = e.getText() != nullptr ? e.getText() : "";
+            const std::uint16_t size = static_cast<std::uint16_t>(
+              std::min<std::size_t>(std::strlen(text), std::numeric_limits<std::uint16_t>::max()));
+            write(mFrameEvents, size);
+            mFrameEvents.insert(mFrameEvents.end(), text, text + size);
+        }
+    });
+    mFrameEventCount++;
+}
+
+void EventRecorder::endFrame(float deltaTime) {
+    write(mData, mFrameCount);
+    write(mData, deltaTime);
+    write(mData, mFrameEventCount);
+    mData.insert(mData.end(), mFrameEvents.begin(), mFrameEvents.end());
+
+    mFrameEvents.clear();
+    mFrameEventCount = 0;
+    mFrameCount++;
+
+    // keep the frame count of the header up to date
+    std::memcpy(mData.data() + offsetof(Header, frameCount), &mFrameCount, sizeof(mFrameCount));
+}
+
+std::expected<void, FileError> EventRecorder::save(const std::filesystem::path& path) const {
+    return FileSystem::WriteFile(path, mData);
+}
+
+void EventRecorder::clear() {
+    mData.clear();
+    mFrameEvents.clear();
+    mFrameEventCount = 0;
+    mFrameCount      = 0;
+
+    write(mData,
+          Header{.magic          = kMagic,
+                 .version        = kVersion,
+                 .eventTypeCount = static_cast<std::uint16_t>(kEventTypeCount),
+                 .layoutHash     = kLayoutHash,
+                 .frameCount     = 0});
+}
+
+bool EventPlayer::load(std::vector<char> data) {
+    mData       = std::move(data);
+    mFrameCount = 0;
+    rewind();
+
+    Header header{};
+    Reader reader(mData, 0);
+    if (!reader.read(header) || header.magic != kMagic || header.version != kVersion ||
+        header.eventTypeCount != kEventTypeCount || header.layoutHash != kLayoutHash) {
+        mData.clear();
+        return false;
+    }
+    mFrameCount = header.frameCount;
+    return true;
+}
+
+std::expected<void, FileError> EventPlayer::open(const std::filesystem::path& path) {
+    auto data = FileSystem::ReadFile(path);
+    if (!data) {
+        return std::unexpected(data.error());
+    }
+    if (!load(std::move(data.value()))) {
+        return std::unexpected(FileError{.errorCode = FileErrorCode::ReadFailure, .path = path});
+    }
+    return {};
+}
+
+std::optional<EventPlayer::Frame> EventPlayer::nextFrame() {
+    if (isFinished()) {
+        return std::nullopt;
+    }
+
+    mEvents.clear();
+    mTexts.clear();
+
+    Reader      reader(mData, mOffset);
+    FrameHeader header{};
+    if (!reader.read(header.index) || !reader.read(header.deltaTime) ||
+        !reader.read(header.eventCount)) {
+        mNextFrame = mFrameCount; // corrupted log, stop the replay
+        return std::nullopt;
+    }
+
+    mEvents.reserve(header.eventCount);
+    for (std::uint32_t i = 0; i < header.eventCount; i++) {
+        std::uint8_t type{};
+        if (!reader.read(type) || type >= kDecodeTable.size() ||
+            !kDecodeTable[type](reader, mEvents, mTexts)) {
+            mNextFrame = mFrameCount;
+            return std::nullopt;
+        }
+    }
+
+    mOffset = reader.getOffset();
+    mNextFrame++;
+    return Frame{.index = header.index, .deltaTime = header.deltaTime, .events = mEvents};
+}
+
+void EventPlayer::rewind() noexcept {
+    mOffset    = sizeof(Header);
+    mNextFrame = 0;
+}
+
+} // namespace fuse
@@ -0,0 +1,107 @@
+#pragma once
+#include "Event.h"
+#include "fileSystem/FileSystem.h"
+
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Record a stream of events, frame by frame, into a compact binary log.
+///
+/// The log start with a small header followed by one record per frame:
+/// the frame index, the frame delta time, the number of events and the events.
+/// Each event is stored as it type index followed by it raw bytes
+/// (the text of a TextInputEvent is copied into the log).
+///
+/// @note The log use the native byte order and event layout, it is meant to be replayed
+///       by the same build (the header is checked against the event layout).
+///
+/// @code
+/// recorder.record(event); // for each event of the frame
+/// recorder.endFrame(deltaTime);
+/// recorder.save("session.fev");
+/// @endcode
+class EventRecorder {
+public:
+    /// @brief Create a empty log.
+    EventRecorder();
+
+    /// @brief Add a event to the current frame.
+    /// @param event The event to record.
+    void record(const Event& event);
+
+    /// @brief Close the current frame and start a new one.
+    /// @param deltaTime The delta time of the closed frame in seconds.
+    void endFrame(float deltaTime);
+
+    /// @brief Get the number of frames recorded.
+    [[nodiscard]] std::uint32_t getFrameCount() const noexcept { return mFrameCount; }
+
+    /// @brief Get the binary log of all the frames recorded.
+    [[nodiscard]] std::span<const char> getData() const noexcept { return mData; }
+
+    /// @brief Write the binary log to a file.
+    /// @param path The file to write.
+    /// @return Nothing or a \p FileError if the file can't be written.
+    [[nodiscard]] std::expected<void, FileError> save(const std::filesystem::path& path) const;
+
+    /// @brief Remove all the frames recorded.
+    void clear();
+
+private:
+    std::vector<char> mData;              ///< Header and closed frames.
+    std::vector<char> mFrameEvents;       ///< Encoded events of the current frame.
+    std::uint32_t     mFrameEventCount{}; ///< Number of events of the current frame.
+    std::uint32_t     mFrameCount{};      ///< Number of closed frames.
+};
+
+/// @brief Replay a binary log produced by EventRecorder, frame by frame.
+class EventPlayer {
+public:
+    /// @brief A frame of the log.
+    struct Frame {
+        std::uint32_t          index{};     ///< The frame index.
+        float                  deltaTime{}; ///< The recorded delta time in seconds.
+        std::span<const Event> events;      ///< Valid until the next call to nextFrame().
+    };
+
+    /// @brief Load a log from memory.
+    /// @param data The binary log.
+    /// @return True if the log is valid otherwise, false.
+    bool load(std::vector<char> data);
+
+    /// @brief Load a log from a file.
+    /// @param path The file to read.
+    /// @return Nothing or a \p FileError if the file can't be read or is not a valid log.
+    std::expected<void, FileError> open(const std::filesystem::path& path);
+
+    /// @brief Decode the next frame of the log.
+    /// @return The frame or nothing if the end of the log is reached or the log is corrupted.
+    std::optional<Frame> nextFrame();
+
+    /// @brief Restart the replay from the first frame.
+    void rewind() noexcept;
+
+    /// @brief Check if all the frames have been replayed.
+    [[nodiscard]] bool isFinished() const noexcept { return mNextFrame >= mFrameCount; }
+
+    /// @brief Get the number of frames of the log.
+    [[nodiscard]] std::uint32_t getFrameCount() const noexcept { return mFrameCount; }
+
+private:
+    std::vector<char>       mData;         ///< The binary log.
+    std::size_t             mOffset{};     ///< Read offset of the next frame.
+    std::uint32_t           mFrameCount{}; ///< Number of frames in the log.
+    std::uint32_t           mNextFrame{};  ///< Number of frames already replayed.
+    std::vector<Event>      mEvents;       ///< Decoded events of the current frame.
+    std::deque<std::string> mTexts;        ///< Storage for the text of TextInputEvent.
+};
+
+} // namespace fuse
@@ -1,24 +1,37 @@
 #include "Input.h"
 
-#include <SDL3/SDL.h>
-
-#include <map>
+#include <atomic>
+#include <bit>
+#include <tuple>
 
 namespace {
 
-/// @brief State of a button/key.
-enum class KeyState : std::uint8_t {
-    None,    ///<! No stage, the key is up.
-    Pressed, ///<! Pressed this frame.
-    Held,    ///<! Currently down.
-    Released ///<! Released this frame.
-};
+/// @brief Number of 64 bits words in a InputSnapshot.
+constexpr std::size_t kNbSnapshotWords = sizeof(fuse::InputSnapshot) / sizeof(std::uint64_t);
+static_assert(sizeof(fuse::InputSnapshot) % sizeof(std::uint64_t) == 0);
+static_assert(std::is_trivially_copyable_v<fuse::InputSnapshot>);
+
+using SnapshotWords = std::array<std::uint64_t, kNbSnapshotWords>;
+
+/// @brief The current input state, only accessed from the main thread.
+fuse::InputSnapshot sState;
 
-std::map<fuse::ScanCode, KeyState>    sKeyStates;
-std::map<fuse::MouseButton, KeyState> sMouseButtonStates;
-std::pair<float, float>               sMousePosition;
-std::pair<float, float>               sMouseDelta;
-std::pair<float, float>               sMouseWheel;
+/// @brief Copy of sState published for others threads (seqlock).
+///
+/// The sequence is odd while the writer is copying the words.
+/// Each word is atomic so readers never race with the writer.
+std::atomic<std::uint32_t>                               sSequence{0};
+std::array<std::atomic<std::uint64_t>, kNbSnapshotWords> sPublishedWords{};
+
+template <std::size_t N>
+void setBit(std::array<std::uint64_t, N>& bits, unsigned index) noexcept {
+    bits[index / 64] |= (std::uint64_t{1} << (index % 64));
+}
+
+template <std::size_t N>
+void clearBit(std::array<std::uint64_t, N>& bits, unsigned index) noexcept {
+    bits[index / 64] &= ~(std::uint64_t{1} << (index % 64));
+}
 
 } // namespace
 
@@ -28,90 +41,88 @@ namespace fuse {
 //                                 KeyBoard
 // ==================================================================================
 
-bool Input::IsKeyPressed(ScanCode key) noexcept {
-    if (const auto it = sKeyStates.find(key); it != sKeyStates.end()) {
-        return it->second == KeyState::Pressed;
-    }
-    return false;
-}
+bool Input::IsKeyPressed(ScanCode key) noexcept { return sState.isKeyPressed(key); }
 
 bool Input::IsKeyDown(ScanCode key) noexcept {
-    if (const auto it = sKeyStates.find(key); it != sKeyStates.end()) {
-        // check if it pressed this frame or held down because
-        // the held state happen on the next frame.
-        return it->second == KeyState::Pressed || it->second == KeyState::Held;
-    }
-    return false;
+    // The down bit is set as soon as the key is pressed,
+    // so it also cover a key pressed this frame.
+    return sState.isKeyDown(key);
 }
 
-bool Input::IsKeyReleased(ScanCode key) noexcept {
-    if (const auto it = sKeyStates.find(key); it != sKeyStates.end()) {
-        return it->second == KeyState::Released;
-    }
-    return false;
-}
+bool Input::IsKeyReleased(ScanCode key) noexcept { return sState.isKeyReleased(key); }
 
 // ==================================================================================
 //                                 Mouse
 // ==================================================================================
 
-bool Input::IsButtonPressed(MouseButton button) noexcept {
-    if (const auto it = sMouseButtonStates.find(button); it != sMouseButtonStates.end()) {
-        return it->second == KeyState::Pressed;
-    }
-    return false;
+bool Input::IsButtonPressed(MouseButton button) noexcept { return sState.isButtonPressed(button); }
+
+bool Input::IsButtonDown(MouseButton button) noexcept { return sState.isButtonDown(button); }
+
+bool Input::IsButtonReleased(MouseButton button) noexcept {
+    return sState.isButtonReleased(button);
 }
 
-bool Input::IsButtonDown(MouseButton button) noexcept {
-    if (const auto it = sMouseButtonStates.find(button); it != sMouseButtonStates.end()) {
-        // check if it pressed this frame or held down because
-        // the held state happen on the next frame.
-        return it->second == KeyState::Pressed || it->second == KeyState::Held;
-    }
-    return false;
+std::pair<float, float> Input::GetMousePosition() noexcept { return sState.getMousePosition(); }
+
+std::pair<float, float> Input::GetMousePositionDelta() noexcept {
+    return sState.getMousePositionDelta();
 }
 
-bool Input::IsButtonReleased(MouseButton button) noexcept {
-    if (const auto it = sMouseButtonStates.find(button); it != sMouseButtonStates.end()) {
-        return it->second == KeyState::Released;
-    }
-    return false;
+std::pair<float, float> Input::GetMouseScrollDelta() noexcept {
+    return sState.getMouseScrollDelta();
 }
 
-std::pair<float, float> Input::GetMousePosition() noexcept { return sMousePosition; }
+// ==================================================================================
+//                                 Snapshot
+// ==================================================================================
 
-std::pair<float, float> Input::GetMousePositionDelta() noexcept { return sMouseDelta; }
+InputSnapshot Input::GetSnapshot() noexcept {
+    SnapshotWords words{};
+    std::uint32_t begin{};
+    std::uint32_t end{};
+    do {
+        begin = sSequence.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < kNbSnapshotWords; i++) {
+            words[i] = sPublishedWords[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        end = sSequence.load(std::memory_order_relaxed);
+    } while ((begin & 1U) != 0 || begin != end);
 
-std::pair<float, float> Input::GetMouseScrollDelta() noexcept { return sMouseWheel; }
+    return std::bit_cast<InputSnapshot>(words);
+}
 
 // ==================================================================================
 //                          Internal functions
 // ==================================================================================
 
-void Input::UpdateStates() noexcept {
-    // Update the keyboard state
-    for (auto& ks : sKeyStates) {
-        if (ks.second == KeyState::Pressed) {
-            ks.second = KeyState::Held;
-        }
-        if (ks.second == KeyState::Released) {
-            ks.second = KeyState::None;
-        }
-    }
+void Input::PublishSnapshot() noexcept {
+    const auto words    = std::bit_cast<SnapshotWords>(sState);
+    const auto sequence = sSequence.load(std::memory_order_relaxed);
 
-    // Update the mouse button state
-    for (auto& mbs : sMouseButtonStates) {
-        if (mbs.second == KeyState::Pressed) {
-            mbs.second = KeyState::Held;
-        }
-        if (mbs.second == KeyState::Released) {
-            mbs.second = KeyState::None;
-        }
+    sSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < kNbSnapshotWords; i++) {
+        sPublishedWords[i].store(words[i], std::memory_order_relaxed);
     }
+    sSequence.store(sequence + 2, std::memory_order_release);
+}
+
+void Input::UpdateStates() noexcept {
+    // Pressed and released states only last one frame.
+    sState.mKeyPressed     = {};
+    sState.mKeyReleased    = {};
+    sState.mButtonPressed  = 0;
+    sState.mButtonReleased = 0;
 
     // reset mouse delta position and delta scroll
-    sMouseDelta = {};
-    sMouseWheel = {};
+    sState.mMouseDelta[0] = 0.f;
+    sState.mMouseDelta[1] = 0.f;
+    sState.mMouseWheel[0] = 0.f;
+    sState.mMouseWheel[1] = 0.f;
+
+    PublishSnapshot();
 }
 
 void Input::OnEvent(const Event& e) noexcept {
@@ -121,31 +132,46 @@ void Input::OnEvent(const Event& e) noexcept {
     if (const auto* keyPressedEvent = e.getIf<KeyPressedEvent>()) {
         if (!keyPressedEvent->isRepeated()) {
             // Mark the key as pressed
-            // We can ignore the repeat state, the key will be marked has held down
-            // on the next call to Update().
-            sKeyStates[keyPressedEvent->getScanCode()] = KeyState::Pressed;
+            // We can ignore the repeat state, the key stay down until released.
+            const auto key = std::to_underlying(keyPressedEvent->getScanCode());
+            setBit(sState.mKeyPressed, key);
+            setBit(sState.mKeyDown, key);
+            clearBit(sState.mKeyReleased, key);
         }
     } else if (const auto* keyReleasedEvent = e.getIf<KeyReleasedEvent>()) {
         // Mark the key as released
-        sKeyStates[keyReleasedEvent->getScanCode()] = KeyState::Released;
+        const auto key = std::to_underlying(keyReleasedEvent->getScanCode());
+        setBit(sState.mKeyReleased, key);
+        clearBit(sState.mKeyDown, key);
+        clearBit(sState.mKeyPressed, key);
     }
     //
     // Mouse
     //
     else if (const auto* mouseButtonEvent = e.getIf<MouseButtonEvent>()) {
+        const auto bit = InputSnapshot::buttonBit(mouseButtonEvent->getButton());
         if (mouseButtonEvent->isPressed()) {
             // Mark the button as pressed
-            sMouseButtonStates[mouseButtonEvent->getButton()] = KeyState::Pressed;
+            sState.mButtonPressed |= bit;
+            sState.mButtonDown |= bit;
+            sState.mButtonReleased &= ~bit;
         } else {
             // Mark the button as released
-            sMouseButtonStates[mouseButtonEvent->getButton()] = KeyState::Released;
+            sState.mButtonReleased |= bit;
+            sState.mButtonDown &= ~bit;
+            sState.mButtonPressed &= ~bit;
         }
     } else if (const auto* mouseMovedEvent = e.getIf<MouseMovedEvent>()) {
-        sMousePosition = mouseMovedEvent->getMousePosition();
-        sMouseDelta    = mouseMovedEvent->getMouseDelta();
+        std::tie(sState.mMousePosition[0], sState.mMousePosition[1]) =
+          mouseMovedEvent->getMousePosition();
+        std::tie(sState.mMouseDelta[0], sState.mMouseDelta[1]) = mouseMovedEvent->getMouseDelta();
     } else if (const auto* mouseScrolledEvent = e.getIf<MouseScrolledEvent>()) {
-        sMouseWheel = mouseScrolledEvent->getDelta();
+        std::tie(sState.mMouseWheel[0], sState.mMouseWheel[1]) = mouseScrolledEvent->getDelta();
+    } else {
+        return; // nothing changed
     }
+
+    PublishSnapshot();
 }
 
 } // namespace fuse
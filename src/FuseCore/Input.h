@@ -2,9 +2,93 @@
 #include "Event.h"
 #include "Keyboard.h"
 
+#include <array>
+#include <cstdint>
+#include <utility>
+
 namespace fuse {
 class Event;
 
+/// @brief Copy of the state of the input devices at a given time.
+///
+/// The states are stored as bit masks indexed by ScanCode / MouseButton,
+/// so a snapshot is small, trivially copyable and can be read from any thread.
+/// @see Input::GetSnapshot()
+class InputSnapshot {
+public:
+    /// @brief Query if the given key @b key has been pressed this frame.
+    [[nodiscard]] bool isKeyPressed(ScanCode key) const noexcept {
+        return testBit(mKeyPressed, std::to_underlying(key));
+    }
+
+    /// @brief Query if the given key @b key is currently pressed.
+    [[nodiscard]] bool isKeyDown(ScanCode key) const noexcept {
+        return testBit(mKeyDown, std::to_underlying(key));
+    }
+
+    /// @brief Query if the given key @b key has been released this frame.
+    [[nodiscard]] bool isKeyReleased(ScanCode key) const noexcept {
+        return testBit(mKeyReleased, std::to_underlying(key));
+    }
+
+    /// @brief Query if the given mouse @b button has been pressed this frame.
+    [[nodiscard]] bool isButtonPressed(MouseButton button) const noexcept {
+        return (mButtonPressed & buttonBit(button)) != 0;
+    }
+
+    /// @brief Query if the given mouse @b button is currently pressed.
+    [[nodiscard]] bool isButtonDown(MouseButton button) const noexcept {
+        return (mButtonDown & buttonBit(button)) != 0;
+    }
+
+    /// @brief Query if the given mouse @b button has been released this frame.
+    [[nodiscard]] bool isButtonReleased(MouseButton button) const noexcept {
+        return (mButtonReleased & buttonBit(button)) != 0;
+    }
+
+    /// @brief Return the mouse position in pixel coordinate.
+    [[nodiscard]] std::pair<float, float> getMousePosition() const noexcept {
+        return {mMousePosition[0], mMousePosition[1]};
+    }
+
+    /// @brief Return the mouse position delta of this frame in pixel coordinates.
+    [[nodiscard]] std::pair<float, float> getMousePositionDelta() const noexcept {
+        return {mMouseDelta[0], mMouseDelta[1]};
+    }
+
+    /// @brief Return the amount of mouse scroll (wheel) during this frame.
+    [[nodiscard]] std::pair<float, float> getMouseScrollDelta() const noexcept {
+        return {mMouseWheel[0], mMouseWheel[1]};
+    }
+
+private:
+    friend class Input;
+
+    static constexpr std::size_t kNbKeyWords = 256 / 64; ///< Enough bits for all ScanCode.
+    static_assert(std::to_underlying(ScanCode::Count) <= kNbKeyWords * 64);
+
+    using KeyBits = std::array<std::uint64_t, kNbKeyWords>;
+
+    [[nodiscard]] static bool testBit(const KeyBits& bits, unsigned index) noexcept {
+        return (bits[index / 64] & (std::uint64_t{1} << (index % 64))) != 0;
+    }
+
+    [[nodiscard]] static std::uint32_t buttonBit(MouseButton button) noexcept {
+        return std::uint32_t{1} << std::to_underlying(button);
+    }
+
+    KeyBits       mKeyDown{};        ///< Keys currently down.
+    KeyBits       mKeyPressed{};     ///< Keys pressed this frame.
+    KeyBits       mKeyReleased{};    ///< Keys released this frame.
+    std::uint32_t mButtonDown{};     ///< Mouse buttons currently down.
+    std::uint32_t mButtonPressed{};  ///< Mouse buttons pressed this frame.
+    std::uint32_t mButtonReleased{}; ///< Mouse buttons released this frame.
+    std::uint32_t mPadding{};        ///< Keep the size a multiple of 8 bytes.
+    float         mMousePosition[2]{};
+    float         mMouseDelta[2]{};
+    float         mMouseWheel[2]{};
+};
+
 /// @brief Query the state of input device.
 ///
 /// @note Internal only. The \p UpdateStates() function need to be called once per frame.
@@ -75,6 +159,13 @@ public:
 
     ///  @}
 
+    /// @brief Get a copy of the latest input state.
+    ///
+    /// Unlike the other functions, this function can be called from any thread.
+    /// It is lock-free and never return a partially updated state.
+    /// @return The latest state of the input devices.
+    static InputSnapshot GetSnapshot() noexcept;
+
     /// @name Internal
     ///  @{
 
@@ -90,6 +181,10 @@ public:
     static void OnEvent(const Event& event) noexcept;
 
     ///  @}
+
+private:
+    /// @brief Publish the current state for GetSnapshot().
+    static void PublishSnapshot() noexcept;
 };
 
 } // namespace fuse
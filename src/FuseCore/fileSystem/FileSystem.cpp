@@ -83,6 +83,22 @@ std::expected<std::vector<char>, FileError> FileSystem::ReadFile(
     return data;
 }
 
+std::expected<void, FileError> FileSystem::WriteFile(const std::filesystem::path& filename,
+                                                     std::span<const char>        data) {
+    std::ofstream ofs(filename.string(), std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+        return std::unexpected(
+          FileError{.errorCode = FileErrorCode::PermissionDenied, .path = filename});
+    }
+
+    if (!ofs.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+        return std::unexpected(
+          FileError{.errorCode = FileErrorCode::WriteFailure, .path = filename});
+    }
+
+    return {};
+}
+
 std::ostream& operator<<(std::ostream& stream, const FileError& error) {
     switch (error.errorCode) {
         case FileErrorCode::FileNotFound:
@@ -97,6 +113,9 @@ std::ostream& operator<<(std::ostream& stream, const FileError& error) {
         case FileErrorCode::ReadFailure:
             stream << std::format("Failed to read {}.", error.path.string());
             break;
+        case FileErrorCode::WriteFailure:
+            stream << std::format("Failed to write {}.", error.path.string());
+            break;
         case FileErrorCode::PermissionDenied:
             stream << std::format("Permission denied: {}.", error.path.string());
             break;
@@ -123,6 +142,7 @@ string_view toString(fuse::FileErrorCode ec) {
         case fuse::FileErrorCode::NotAFile:         return "NotAFile";
         case fuse::FileErrorCode::FileTooLarge:     return "FileTooLarge";
         case fuse::FileErrorCode::ReadFailure:      return "ReadFailed";
+        case fuse::FileErrorCode::WriteFailure:     return "WriteFailed";
         case fuse::FileErrorCode::PermissionDenied: return "PermissionDenied";
         case fuse::FileErrorCode::MemoryAllocation: return "MemoryAllocation";
         case fuse::FileErrorCode::Unknown:
@@ -2,6 +2,7 @@
 #include <expected>
 #include <filesystem>
 #include <format>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -13,6 +14,7 @@ enum class FileErrorCode : std::uint8_t {
     NotAFile,         ///< The file is not a regular file.
     FileTooLarge,     ///< The file is too large to be read.
     ReadFailure,      ///< A error occur while reading a file.
+    WriteFailure,     ///< A error occur while writing a file.
     PermissionDenied, ///< Permission denied for reading/writing file.
     MemoryAllocation, ///< A memory error occur while reading a file.
     Unknown           ///< Any other error not explicitly handled.
@@ -34,6 +36,14 @@ public:
     static std::expected<std::vector<char>, FileError> ReadFile(
       const std::filesystem::path& filename);
 
+    /// @brief Write a binary buffer to a file. The file is replaced if it already exists.
+    ///
+    /// @param filename The file to write.
+    /// @param data The data to write.
+    /// @return Nothing or a \p FileError if a error occur.
+    static std::expected<void, FileError> WriteFile(const std::filesystem::path& filename,
+                                                    std::span<const char>        data);
+
     /// @brief return the path of the executable of the application.
     static std::filesystem::path GetExecutableDirectory();
 
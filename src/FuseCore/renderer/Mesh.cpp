@@ -0,0 +1,152 @@
+#include "Mesh.h"
+
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace {
+
+/// @brief Add a quad facing @p normal, @p u x @p v must be equal to @p normal.
+void addFace(fuse::MeshData&   mesh,
+             const fuse::Vec3& normal,
+             const fuse::Vec3& u,
+             const fuse::Vec3& v) {
+    const auto base   = static_cast<std::uint32_t>(mesh.vertices.size());
+    const auto center = normal * 0.5f;
+    mesh.vertices.push_back({center - u * 0.5f - v * 0.5f, normal});
+    mesh.vertices.push_back({center + u * 0.5f - v * 0.5f, normal});
+    mesh.vertices.push_back({center + u * 0.5f + v * 0.5f, normal});
+    mesh.vertices.push_back({center - u * 0.5f + v * 0.5f, normal});
+    mesh.indices.insert(mesh.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+}
+
+/// @brief Add a disk of diameter 1 at the height @p y, facing away from the origin.
+void addCap(fuse::MeshData& mesh, unsigned segments, float y) {
+    const fuse::Vec3 normal{0.0f, y > 0.0f ? 1.0f : -1.0f, 0.0f};
+    const auto       center = static_cast<std::uint32_t>(mesh.vertices.size());
+    mesh.vertices.push_back({{0.0f, y, 0.0f}, normal});
+    for (unsigned s = 0; s <= segments; s++) {
+        const float phi = 2.0f * std::numbers::pi_v<float> * static_cast<float>(s) /
+                          static_cast<float>(segments);
+        mesh.vertices.push_back({{0.5f * std::cos(phi), y, 0.5f * std::sin(phi)}, normal});
+    }
+    for (std::uint32_t s = 0; s < segments; s++) {
+        const std::uint32_t ring = center + 1 + s;
+        if (y > 0.0f) {
+            mesh.indices.insert(mesh.indices.end(), {center, ring + 1, ring});
+        } else {
+            mesh.indices.insert(mesh.indices.end(), {center, ring, ring + 1});
+        }
+    }
+}
+
+} // namespace
+
+namespace fuse {
+
+MeshData createCubeMesh() {
+    MeshData mesh;
+    mesh.vertices.reserve(24);
+    mesh.indices.reserve(36);
+    addFace(mesh, Vec3::kAxisX, Vec3::kAxisY, Vec3::kAxisZ);
+    addFace(mesh, Vec3::kAxisXNeg, Vec3::kAxisZ, Vec3::kAxisY);
+    addFace(mesh, Vec3::kAxisY, Vec3::kAxisZ, Vec3::kAxisX);
+    addFace(mesh, Vec3::kAxisYNeg, Vec3::kAxisX, Vec3::kAxisZ);
+    addFace(mesh, Vec3::kAxisZ, Vec3::kAxisX, Vec3::kAxisY);
+    addFace(mesh, Vec3::kAxisZNeg, Vec3::kAxisY, Vec3::kAxisX);
+    return mesh;
+}
+
+MeshData createSphereMesh(unsigned segments, unsigned rings) {
+    assert(segments >= 3 && rings >= 2);
+    MeshData mesh;
+    mesh.vertices.reserve(std::size_t{rings + 1} * (segments + 1));
+    mesh.indices.reserve(std::size_t{segments} * (rings - 1) * 6);
+
+    // the seam and the poles are duplicated, so each ring has segments + 1 vertices.
+    for (unsigned r = 0; r <= rings; r++) {
+        const float theta =
+          std::numbers::pi_v<float> * static_cast<float>(r) / static_cast<float>(rings);
+        for (unsigned s = 0; s <= segments; s++) {
+            const float phi = 2.0f * std::numbers::pi_v<float> * static_cast<float>(s) /
+                              static_cast<float>(segments);
+            const Vec3  normal{
+              std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+            mesh.vertices.push_back({normal * 0.5f, normal});
+        }
+    }
+
+    const std::uint32_t stride = segments + 1;
+    for (std::uint32_t r = 0; r < rings; r++) {
+        for (std::uint32_t s = 0; s < segments; s++) {
+            const std::uint32_t a = r * stride + s;       // (r, s)
+            const std::uint32_t b = (r + 1) * stride + s; // (r + 1, s)
+            const std::uint32_t c = b + 1;                // (r + 1, s + 1)
+            const std::uint32_t d = a + 1;                // (r, s + 1)
+            if (r != 0) { // degenerated at the north pole
+                mesh.indices.insert(mesh.indices.end(), {a, d, c});
+            }
+            if (r != rings - 1) { // degenerated at the south pole
+                mesh.indices.insert(mesh.indices.end(), {a, c, b});
+            }
+        }
+    }
+    return mesh;
+}
+
+MeshData createPlaneMesh(unsigned subdivisions) {
+    assert(subdivisions >= 1);
+    MeshData mesh;
+    mesh.vertices.reserve(std::size_t{subdivisions + 1} * (subdivisions + 1));
+    mesh.indices.reserve(std::size_t{subdivisions} * subdivisions * 6);
+
+    const float step = 1.0f / static_cast<float>(subdivisions);
+    for (unsigned j = 0; j <= subdivisions; j++) {
+        for (unsigned i = 0; i <= subdivisions; i++) {
+            mesh.vertices.push_back(
+              {{-0.5f + static_cast<float>(i) * step, 0.0f, -0.5f + static_cast<float>(j) * step},
+               Vec3::kAxisY});
+        }
+    }
+
+    const std::uint32_t stride = subdivisions + 1;
+    for (std::uint32_t j = 0; j < subdivisions; j++) {
+        for (std::uint32_t i = 0; i < subdivisions; i++) {
+            const std::uint32_t a = j * stride + i;
+            const std::uint32_t b = a + 1;
+            const std::uint32_t c = a + stride + 1;
+            const std::uint32_t d = a + stride;
+            mesh.indices.insert(mesh.indices.end(), {a, c, b, a, d, c});
+        }
+    }
+    return mesh;
+}
+
+MeshData createCylinderMesh(unsigned segments) {
+    assert(segments >= 3);
+    MeshData mesh;
+    mesh.vertices.reserve(std::size_t{segments + 1} * 2 + std::size_t{segments + 2} * 2);
+    mesh.indices.reserve(std::size_t{segments} * 12);
+
+    // side, the seam is duplicated
+    for (unsigned s = 0; s <= segments; s++) {
+        const float phi = 2.0f * std::numbers::pi_v<float> * static_cast<float>(s) /
+                          static_cast<float>(segments);
+        const Vec3  normal{std::cos(phi), 0.0f, std::sin(phi)};
+        mesh.vertices.push_back({{normal.x * 0.5f, -0.5f, normal.z * 0.5f}, normal});
+        mesh.vertices.push_back({{normal.x * 0.5f, 0.5f, normal.z * 0.5f}, normal});
+    }
+    for (std::uint32_t s = 0; s < segments; s++) {
+        const std::uint32_t a = s * 2;       // bottom s
+        const std::uint32_t b = (s + 1) * 2; // bottom s + 1
+        const std::uint32_t c = b + 1;       // top s + 1
+        const std::uint32_t d = a + 1;       // top s
+        mesh.indices.insert(mesh.indices.end(), {a, c, b, a, d, c});
+    }
+
+    addCap(mesh, segments, 0.5f);
+    addCap(mesh, segments, -0.5f);
+    return mesh;
+}
+
+} // namespace fuse
@@ -0,0 +1,69 @@
+#pragma once
+#include <FuseCore/math/Vec3.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Reference to a mesh of a MeshRegistry.
+struct MeshHandle {
+    std::uint32_t id{}; ///< Index of the mesh in the registry.
+
+    [[nodiscard]] constexpr bool operator==(const MeshHandle&) const noexcept = default;
+
+    /// @name Built-in meshes, registered by every MeshRegistry.
+    ///@{
+    static const MeshHandle kCube;         ///< Unit cube centered on the origin.
+    static const MeshHandle kSphere;       ///< Sphere of diameter 1 centered on the origin.
+    static const MeshHandle kPlane;        ///< Unit plane in XZ facing +Y.
+    static const MeshHandle kCylinder;     ///< Cylinder of diameter and height 1 along Y.
+    static const MeshHandle kSphereMedium; ///< kSphere with about a quarter of the triangles.
+    static const MeshHandle kSphereLow;    ///< kSphere with about a sixteenth of the triangles.
+    ///@}
+
+    static const MeshHandle kInvalid; ///< A handle which is never valid.
+};
+
+inline constexpr MeshHandle MeshHandle::kCube{0};
+inline constexpr MeshHandle MeshHandle::kSphere{1};
+inline constexpr MeshHandle MeshHandle::kPlane{2};
+inline constexpr MeshHandle MeshHandle::kCylinder{3};
+inline constexpr MeshHandle MeshHandle::kSphereMedium{4};
+inline constexpr MeshHandle MeshHandle::kSphereLow{5};
+inline constexpr MeshHandle MeshHandle::kInvalid{std::numeric_limits<std::uint32_t>::max()};
+
+/// @brief Vertex of a mesh.
+struct Vertex {
+    Vec3 position; ///< Position in model space.
+    Vec3 normal;   ///< Unit normal in model space.
+};
+
+static_assert(sizeof(Vertex) == sizeof(float) * 6);
+
+/// @brief Indexed triangle list.
+///
+/// The triangles are counter-clockwise when seen from the side of their normal.
+struct MeshData {
+    std::vector<Vertex>        vertices; ///< The vertices.
+    std::vector<std::uint32_t> indices;  ///< Three indices per triangle.
+};
+
+/// @brief Create a unit cube centered on the origin, with flat faces.
+[[nodiscard]] MeshData createCubeMesh();
+
+/// @brief Create a UV sphere of diameter 1 centered on the origin.
+/// @param segments Number of subdivisions around the Y axis (at least 3).
+/// @param rings Number of subdivisions from pole to pole (at least 2).
+[[nodiscard]] MeshData createSphereMesh(unsigned segments = 32, unsigned rings = 16);
+
+/// @brief Create a unit plane in XZ, centered on the origin and facing +Y.
+/// @param subdivisions Number of quads along each side (at least 1).
+[[nodiscard]] MeshData createPlaneMesh(unsigned subdivisions = 1);
+
+/// @brief Create a capped cylinder of diameter and height 1 along Y, centered on the origin.
+/// @param segments Number of subdivisions around the Y axis (at least 3).
+[[nodiscard]] MeshData createCylinderMesh(unsigned segments = 32);
+
+} // namespace fuse
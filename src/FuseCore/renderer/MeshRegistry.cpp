@@ -0,0 +1,78 @@
+#include "MeshRegistry.h"
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace fuse {
+
+MeshRegistry::MeshRegistry() {
+    // same order as the built-in handles
+    [[maybe_unused]] const auto cube     = add(createCubeMesh(), "Cube");
+    [[maybe_unused]] const auto sphere   = add(createSphereMesh(), "Sphere");
+    [[maybe_unused]] const auto plane    = add(createPlaneMesh(), "Plane");
+    [[maybe_unused]] const auto cylinder = add(createCylinderMesh(), "Cylinder");
+    [[maybe_unused]] const auto medium   = add(createSphereMesh(16, 8), "Sphere (medium)");
+    [[maybe_unused]] const auto low      = add(createSphereMesh(8, 4), "Sphere (low)");
+    assert(cube == MeshHandle::kCube && sphere == MeshHandle::kSphere);
+    assert(plane == MeshHandle::kPlane && cylinder == MeshHandle::kCylinder);
+    assert(medium == MeshHandle::kSphereMedium && low == MeshHandle::kSphereLow);
+}
+
+MeshHandle MeshRegistry::add(const MeshData& mesh, std::string_view name) {
+    assert(mesh.indices.size() % 3 == 0);
+    if (mMeshes.size() > SortKey::kMaxMesh) {
+        return MeshHandle::kInvalid; // a handle would be truncated in the sort keys
+    }
+
+    MeshInfo info;
+    info.baseVertex  = static_cast<std::uint32_t>(mVertices.size());
+    info.vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+    info.indexCount  = static_cast<std::uint32_t>(mesh.indices.size());
+    info.indexType   = mesh.vertices.size() <= std::numeric_limits<std::uint16_t>::max() + 1U
+                         ? IndexType::UInt16
+                         : IndexType::UInt32;
+
+    if (!mesh.vertices.empty()) {
+        info.boundsMin = mesh.vertices.front().position;
+        info.boundsMax = mesh.vertices.front().position;
+    }
+    for (const auto& vertex : mesh.vertices) {
+        info.boundsMin = {std::min(info.boundsMin.x, vertex.position.x),
+                          std::min(info.boundsMin.y, vertex.position.y),
+                          std::min(info.boundsMin.z, vertex.position.z)};
+        info.boundsMax = {std::max(info.boundsMax.x, vertex.position.x),
+                          std::max(info.boundsMax.y, vertex.position.y),
+                          std::max(info.boundsMax.z, vertex.position.z)};
+    }
+
+    mVertices.insert(mVertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+    if (info.indexType == IndexType::UInt16) {
+        info.firstIndex = static_cast<std::uint32_t>(mIndices16.size());
+        for (const auto index : mesh.indices) {
+            assert(index < mesh.vertices.size());
+            mIndices16.push_back(static_cast<std::uint16_t>(index));
+        }
+    } else {
+        info.firstIndex = static_cast<std::uint32_t>(mIndices32.size());
+        mIndices32.insert(mIndices32.end(), mesh.indices.begin(), mesh.indices.end());
+    }
+
+    mMeshes.push_back(info);
+    mNames.emplace_back(name);
+    return MeshHandle{static_cast<std::uint32_t>(mMeshes.size() - 1)};
+}
+
+const MeshInfo& MeshRegistry::getInfo(MeshHandle handle) const noexcept {
+    assert(isValid(handle));
+    return mMeshes[handle.id];
+}
+
+std::string_view MeshRegistry::getName(MeshHandle handle) const noexcept {
+    assert(isValid(handle));
+    return mNames[handle.id];
+}
+
+} // namespace fuse
@@ -0,0 +1,92 @@
+#pragma once
+#include "Mesh.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Type of the indices of a mesh.
+enum class IndexType : std::uint8_t {
+    UInt16, ///< Meshes of at most 65536 vertices.
+    UInt32, ///< Larger meshes.
+};
+
+/// @brief Location of a mesh in the shared buffers of a MeshRegistry.
+struct MeshInfo {
+    std::uint32_t baseVertex{};  ///< First vertex in the vertex buffer.
+    std::uint32_t vertexCount{}; ///< Number of vertices.
+    std::uint32_t firstIndex{};  ///< First index in the index buffer of indexType.
+    std::uint32_t indexCount{};  ///< Number of indices.
+    IndexType     indexType{};   ///< The index buffer used by the mesh.
+    Vec3          boundsMin{};   ///< Minimum corner of the bounding box in model space.
+    Vec3          boundsMax{};   ///< Maximum corner of the bounding box in model space.
+};
+
+/// @brief Storage of the meshes used by a scene.
+///
+/// The meshes are not stored one by one: all the vertices are appended to a single vertex
+/// buffer and the indices to one of the two index buffers (16 or 32 bits), so a renderer
+/// can upload the three buffers once and draw any mesh with an offset into them.
+/// Indices are relative to the first vertex of their mesh (base vertex).
+///
+/// The registry is append only, a MeshHandle stay valid for the lifetime of the registry.
+/// The built-in meshes (see MeshHandle) are registered at construction.
+class MeshRegistry {
+public:
+    /// @brief Construct a registry with the built-in meshes.
+    MeshRegistry();
+
+    /// @brief Add a mesh.
+    ///
+    /// The handles must fit in the mesh field of the sort keys, a registry hold at most
+    /// SortKey::kMaxMesh + 1 meshes.
+    /// @param mesh The geometry to copy in the registry.
+    /// @param name The name of the mesh.
+    /// @return The handle of the new mesh, or MeshHandle::kInvalid if the registry is full.
+    [[nodiscard]] MeshHandle add(const MeshData& mesh, std::string_view name);
+
+    /// @brief Check if a handle reference a mesh of this registry.
+    [[nodiscard]] bool isValid(MeshHandle handle) const noexcept {
+        return handle.id < mMeshes.size();
+    }
+
+    /// @brief Get the location of a mesh in the shared buffers.
+    /// @pre The handle must be valid.
+    [[nodiscard]] const MeshInfo& getInfo(MeshHandle handle) const noexcept;
+
+    /// @brief Get the name of a mesh.
+    /// @pre The handle must be valid.
+    [[nodiscard]] std::string_view getName(MeshHandle handle) const noexcept;
+
+    /// @brief Get the number of meshes.
+    [[nodiscard]] std::size_t getMeshCount() const noexcept { return mMeshes.size(); }
+
+    /// @brief Get the location of all the meshes, indexed by handle.
+    [[nodiscard]] std::span<const MeshInfo> getInfos() const noexcept { return mMeshes; }
+
+    /// @brief Get the shared vertex buffer.
+    [[nodiscard]] std::span<const Vertex> getVertices() const noexcept { return mVertices; }
+
+    /// @brief Get the shared 16 bits index buffer.
+    [[nodiscard]] std::span<const std::uint16_t> getIndices16() const noexcept {
+        return mIndices16;
+    }
+
+    /// @brief Get the shared 32 bits index buffer.
+    [[nodiscard]] std::span<const std::uint32_t> getIndices32() const noexcept {
+        return mIndices32;
+    }
+
+private:
+    std::vector<MeshInfo>      mMeshes;    ///< Location of each mesh, indexed by handle.
+    std::vector<std::string>   mNames;     ///< Name of each mesh, indexed by handle.
+    std::vector<Vertex>        mVertices;  ///< Vertices of all the meshes.
+    std::vector<std::uint16_t> mIndices16; ///< Indices of the meshes of type UInt16.
+    std::vector<std::uint32_t> mIndices32; ///< Indices of the meshes of type UInt32.
+};
+
+} // namespace fuse
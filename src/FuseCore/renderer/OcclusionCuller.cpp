@@ -0,0 +1,355 @@
+#include "OcclusionCuller.h"
+
+#include <FuseCore/scene/RenderList.h>
+#include <FuseCore/utils/WorkerPool.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+/// @brief Minimum number of boxes tested by a thread in cull().
+constexpr std::size_t kMinBoxesPerThread = 1024;
+
+/// @brief Minimum number of triangles to rasterize the tiles across threads.
+constexpr std::size_t kMinParallelTriangles = 256;
+
+/// @brief Signed distance to the near plane (z = -w in OpenGL clip space).
+float nearDistance(const fuse::Vec4& v) noexcept { return v.z + v.w; }
+
+fuse::Vec4 lerp(const fuse::Vec4& a, const fuse::Vec4& b, float t) noexcept {
+    return a + (b - a) * t;
+}
+
+/// @brief Run @p function(begin, end) over @p count items, on the workers if any.
+template <class Function>
+void parallelFor(fuse::WorkerPool* workers,
+                 std::size_t       count,
+                 std::size_t       minPerThread,
+                 Function&&        function) {
+    if (workers == nullptr) {
+        function(std::size_t{0}, count);
+    } else {
+        workers->parallelFor(count, minPerThread, function);
+    }
+}
+
+} // namespace
+
+namespace fuse {
+
+OcclusionCuller::OcclusionCuller(unsigned width, unsigned height)
+    : mWidth(width)
+    , mHeight(height)
+    , mTileCountX(width / kTileSize)
+    , mTileCountY(height / kTileSize) {
+    assert(std::has_single_bit(width) && std::has_single_bit(height));
+    assert(width >= kTileSize && height >= kTileSize);
+
+    // each level half the previous one, down to a single texel
+    const unsigned levelCount = std::bit_width(std::max(width, height));
+    mLevels.resize(levelCount);
+    for (unsigned level = 0; level < levelCount; level++) {
+        mLevels[level].resize(std::size_t{std::max(width >> level, 1U)} *
+                              std::max(height >> level, 1U));
+    }
+    mTileBins.resize(std::size_t{mTileCountX} * mTileCountY);
+    begin(Mat4::kIdentity);
+}
+
+void OcclusionCuller::begin(const Mat4& viewProj) {
+    mViewProj = viewProj;
+    mStats    = {};
+    mTriangles.clear();
+    for (auto& bin : mTileBins) {
+        bin.clear();
+    }
+    std::ranges::fill(mLevels.front(), 1.0f);
+}
+
+void OcclusionCuller::addOccluder(const MeshRegistry& registry,
+                                  MeshHandle          mesh,
+                                  const Mat4&         world) {
+    const MeshInfo& info     = registry.getInfo(mesh);
+    const auto      vertices = registry.getVertices().subspan(info.baseVertex, info.vertexCount);
+    if (info.indexType == IndexType::UInt16) {
+        addIndexedTriangles(
+          vertices, registry.getIndices16().subspan(info.firstIndex, info.indexCount), world);
+    } else {
+        addIndexedTriangles(
+          vertices, registry.getIndices32().subspan(info.firstIndex, info.indexCount), world);
+    }
+}
+
+void OcclusionCuller::addOccluder(std::span<const Vertex>        vertices,
+                                  std::span<const std::uint32_t> indices,
+                                  const Mat4&                    world) {
+    addIndexedTriangles(vertices, indices, world);
+}
+
+template <class Index>
+void OcclusionCuller::addIndexedTriangles(std::span<const Vertex> vertices,
+                                          std::span<const Index>  indices,
+                                          const Mat4&             world) {
+    assert(indices.size() % 3 == 0);
+    mStats.occluderCount++;
+
+    const Mat4 worldViewProj = mViewProj * world;
+    const auto toClip        = [&](Index index) {
+        const Vec3& p = vertices[index].position;
+        return worldViewProj * Vec4(p.x, p.y, p.z, 1.0f);
+    };
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        addClipTriangle(toClip(indices[i]), toClip(indices[i + 1]), toClip(indices[i + 2]));
+    }
+}
+
+void OcclusionCuller::addClipTriangle(const Vec4& a, const Vec4& b, const Vec4& c) {
+    const std::array<Vec4, 3>  input{a, b, c};
+    const std::array<float, 3> distances{nearDistance(a), nearDistance(b), nearDistance(c)};
+
+    // Sutherland-Hodgman against the near plane, a triangle give at most a quad.
+    std::array<Vec4, 4> polygon{};
+    unsigned            count = 0;
+    for (unsigned i = 0; i < 3; i++) {
+        const unsigned next = (i + 1) % 3;
+        if (distances[i] >= 0.0f) {
+            polygon[count++] = input[i];
+        }
+        if ((distances[i] >= 0.0f) != (distances[next] >= 0.0f)) {
+            const float t    = distances[i] / (distances[i] - distances[next]);
+            polygon[count++] = lerp(input[i], input[next], t);
+        }
+    }
+    for (unsigned i = 2; i < count; i++) {
+        addScreenTriangle(polygon[0], polygon[i - 1], polygon[i]);
+    }
+}
+
+void OcclusionCuller::addScreenTriangle(const Vec4& a, const Vec4& b, const Vec4& c) {
+    // w is at least the near distance once clipped
+    if (a.w <= 0.0f || b.w <= 0.0f || c.w <= 0.0f) {
+        return;
+    }
+
+    const float width  = static_cast<float>(mWidth);
+    const float height = static_cast<float>(mHeight);
+    const auto  toScreen = [&](const Vec4& v) {
+        return Vec3((v.x / v.w * 0.5f + 0.5f) * width,
+                    (v.y / v.w * 0.5f + 0.5f) * height,
+                    std::min(v.z / v.w * 0.5f + 0.5f, 1.0f));
+    };
+    const Vec3 p0 = toScreen(a);
+    const Vec3 p1 = toScreen(b);
+    const Vec3 p2 = toScreen(c);
+
+    // counter-clockwise triangles have a positive area, the back faces are skipped.
+    const float area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+    if (!(area > 0.0f)) {
+        return;
+    }
+
+    ScreenTriangle triangle{};
+    triangle.minX = std::max(static_cast<int>(std::floor(std::min({p0.x, p1.x, p2.x}))), 0);
+    triangle.minY = std::max(static_cast<int>(std::floor(std::min({p0.y, p1.y, p2.y}))), 0);
+    triangle.maxX = std::min(static_cast<int>(std::floor(std::max({p0.x, p1.x, p2.x}))),
+                             static_cast<int>(mWidth) - 1);
+    triangle.maxY = std::min(static_cast<int>(std::floor(std::max({p0.y, p1.y, p2.y}))),
+                             static_cast<int>(mHeight) - 1);
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+        return; // outside of the screen
+    }
+
+    // barycentric of the vertex i, from the edge opposite to it, normalized by the area.
+    const std::array<Vec3, 3> points{p0, p1, p2};
+    for (unsigned i = 0; i < 3; i++) {
+        const Vec3& u        = points[(i + 1) % 3];
+        const Vec3& v        = points[(i + 2) % 3];
+        triangle.edges[i][0] = (u.y - v.y) / area;
+        triangle.edges[i][1] = (v.x - u.x) / area;
+        triangle.edges[i][2] = (u.x * v.y - u.y * v.x) / area;
+    }
+    for (unsigned j = 0; j < 3; j++) {
+        triangle.depth[j] = triangle.edges[0][j] * p0.z + triangle.edges[1][j] * p1.z +
+                            triangle.edges[2][j] * p2.z;
+    }
+
+    const auto index = static_cast<unsigned>(mTriangles.size());
+    mTriangles.push_back(triangle);
+    mStats.triangleCount++;
+
+    const unsigned tileMinX = static_cast<unsigned>(triangle.minX) / kTileSize;
+    const unsigned tileMaxX = static_cast<unsigned>(triangle.maxX) / kTileSize;
+    const unsigned tileMinY = static_cast<unsigned>(triangle.minY) / kTileSize;
+    const unsigned tileMaxY = static_cast<unsigned>(triangle.maxY) / kTileSize;
+    for (unsigned tileY = tileMinY; tileY <= tileMaxY; tileY++) {
+        for (unsigned tileX = tileMinX; tileX <= tileMaxX; tileX++) {
+            mTileBins[tileY * mTileCountX + tileX].push_back(index);
+        }
+    }
+}
+
+void OcclusionCuller::rasterize(WorkerPool* workers) {
+    // a few triangles are rasterized faster than the workers are woken up
+    const std::size_t tileCount = mTileBins.size();
+    const std::size_t minTiles  = mTriangles.size() < kMinParallelTriangles ? tileCount : 1;
+    parallelFor(workers, tileCount, minTiles, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t tile = begin; tile < end; tile++) {
+            rasterizeTile(static_cast<unsigned>(tile));
+        }
+    });
+
+    // each texel keep the farthest depth of the 2x2 texels below.
+    for (unsigned level = 1; level < mLevels.size(); level++) {
+        const unsigned srcWidth  = std::max(mWidth >> (level - 1), 1U);
+        const unsigned srcHeight = std::max(mHeight >> (level - 1), 1U);
+        const unsigned dstWidth  = std::max(mWidth >> level, 1U);
+        const unsigned dstHeight = std::max(mHeight >> level, 1U);
+        const auto&    src       = mLevels[level - 1];
+        auto&          dst       = mLevels[level];
+        for (unsigned y = 0; y < dstHeight; y++) {
+            const unsigned y0 = std::min(y * 2, srcHeight - 1);
+            const unsigned y1 = std::min(y * 2 + 1, srcHeight - 1);
+            for (unsigned x = 0; x < dstWidth; x++) {
+                const unsigned x0 = std::min(x * 2, srcWidth - 1);
+                const unsigned x1 = std::min(x * 2 + 1, srcWidth - 1);
+                dst[y * dstWidth + x] =
+                  std::max({src[y0 * srcWidth + x0], src[y0 * srcWidth + x1],
+                            src[y1 * srcWidth + x0], src[y1 * srcWidth + x1]});
+            }
+        }
+    }
+}
+
+void OcclusionCuller::rasterizeTile(unsigned tile) noexcept {
+    const int tileMinX = static_cast<int>((tile % mTileCountX) * kTileSize);
+    const int tileMinY = static_cast<int>((tile / mTileCountX) * kTileSize);
+    const int tileMaxX = tileMinX + static_cast<int>(kTileSize) - 1;
+    const int tileMaxY = tileMinY + static_cast<int>(kTileSize) - 1;
+    auto&     depth    = mLevels.front();
+
+    for (const unsigned index : mTileBins[tile]) {
+        const ScreenTriangle& t = mTriangles[index];
+
+        const int minX = std::max(t.minX, tileMinX);
+        const int maxX = std::min(t.maxX, tileMaxX);
+        const int minY = std::max(t.minY, tileMinY);
+        const int maxY = std::min(t.maxY, tileMaxY);
+        for (int y = minY; y <= maxY; y++) {
+            // sample the pixel centers, the row loop has no dependency between pixels
+            // so the compiler can vectorize it.
+            const float fy   = static_cast<float>(y) + 0.5f;
+            const float row0 = t.edges[0][1] * fy + t.edges[0][2];
+            const float row1 = t.edges[1][1] * fy + t.edges[1][2];
+            const float row2 = t.edges[2][1] * fy + t.edges[2][2];
+            const float rowZ = t.depth[1] * fy + t.depth[2];
+            float*      line = depth.data() + static_cast<std::size_t>(y) * mWidth;
+            for (int x = minX; x <= maxX; x++) {
+                const float fx     = static_cast<float>(x) + 0.5f;
+                const bool  inside = t.edges[0][0] * fx + row0 >= 0.0f &&
+                                    t.edges[1][0] * fx + row1 >= 0.0f &&
+                                    t.edges[2][0] * fx + row2 >= 0.0f;
+                const float z = t.depth[0] * fx + rowZ;
+                line[x]       = inside ? std::min(line[x], z) : line[x];
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::isVisible(const Vec3& boundsMin,
+                                const Vec3& boundsMax,
+                                const Mat4& world) const noexcept {
+    const Mat4 worldViewProj = mViewProj * world;
+
+    constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+    float minX = kInfinity;
+    float minY = kInfinity;
+    float maxX = -kInfinity;
+    float maxY = -kInfinity;
+    float    minZ        = 1.0f;
+    unsigned behindCount = 0;
+    for (unsigned corner = 0; corner < 8; corner++) {
+        const Vec4 clip = worldViewProj * Vec4((corner & 1U) != 0 ? boundsMax.x : boundsMin.x,
+                                               (corner & 2U) != 0 ? boundsMax.y : boundsMin.y,
+                                               (corner & 4U) != 0 ? boundsMax.z : boundsMin.z,
+                                               1.0f);
+        if (nearDistance(clip) <= 0.0f || clip.w <= 0.0f) {
+            behindCount++;
+            continue;
+        }
+        minX = std::min(minX, clip.x / clip.w);
+        minY = std::min(minY, clip.y / clip.w);
+        maxX = std::max(maxX, clip.x / clip.w);
+        maxY = std::max(maxY, clip.y / clip.w);
+        minZ = std::min(minZ, clip.z / clip.w * 0.5f + 0.5f);
+    }
+    if (behindCount != 0) {
+        return behindCount != 8; // entirely behind the camera or crossing the near plane
+    }
+    if (maxX < -1.0f || maxY < -1.0f || minX > 1.0f || minY > 1.0f || minZ >= 1.0f) {
+        return false; // outside of the view
+    }
+
+    // rectangle covered in pixels
+    const auto toPixel = [](float ndc, unsigned size) {
+        const float pixel = (ndc * 0.5f + 0.5f) * static_cast<float>(size);
+        return static_cast<unsigned>(std::clamp(pixel, 0.0f, static_cast<float>(size - 1)));
+    };
+    const unsigned pixelMinX = toPixel(minX, mWidth);
+    const unsigned pixelMaxX = toPixel(maxX, mWidth);
+    const unsigned pixelMinY = toPixel(minY, mHeight);
+    const unsigned pixelMaxY = toPixel(maxY, mHeight);
+
+    // the first level where the rectangle cover at most 4x4 texels
+    unsigned level = 0;
+    while (level + 1 < mLevels.size() && (((pixelMaxX >> level) - (pixelMinX >> level)) >= 4 ||
+                                          ((pixelMaxY >> level) - (pixelMinY >> level)) >= 4)) {
+        level++;
+    }
+
+    const unsigned levelWidth = std::max(mWidth >> level, 1U);
+    const auto&    depth      = mLevels[level];
+    for (unsigned y = pixelMinY >> level; y <= (pixelMaxY >> level); y++) {
+        for (unsigned x = pixelMinX >> level; x <= (pixelMaxX >> level); x++) {
+            if (depth[y * levelWidth + x] >= minZ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::size_t OcclusionCuller::cull(RenderList&               renderList,
+                                  std::span<const MeshInfo> meshes,
+                                  WorkerPool*               workers) {
+    mVisible.resize(renderList.size());
+    parallelFor(workers,
+                renderList.size(),
+                kMinBoxesPerThread,
+                [&](std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i < end; i++) {
+                        const MeshInfo& mesh = meshes[renderList.meshIds[i]];
+                        mVisible[i]          = isVisible(
+                          mesh.boundsMin, mesh.boundsMax, renderList.worldMatrices[i]) ? 1 : 0;
+                    }
+                });
+
+    const std::size_t removed = renderList.compact(mVisible);
+    mStats.testedCount += static_cast<std::uint32_t>(mVisible.size());
+    mStats.culledCount += static_cast<std::uint32_t>(removed);
+    return removed;
+}
+
+float OcclusionCuller::getDepth(unsigned level, unsigned x, unsigned y) const noexcept {
+    assert(level < mLevels.size());
+    const unsigned levelWidth = std::max(mWidth >> level, 1U);
+    assert(x < levelWidth && y < std::max(mHeight >> level, 1U));
+    return mLevels[level][y * levelWidth + x];
+}
+
+} // namespace fuse
@@ -0,0 +1,152 @@
+#pragma once
+#include "MeshRegistry.h"
+
+#include <FuseCore/math/Mat4.h>
+#include <FuseCore/math/Vec3.h>
+#include <FuseCore/math/Vec4.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fuse {
+
+struct RenderList;
+class WorkerPool;
+
+/// @brief Counters of the last frame of a OcclusionCuller.
+struct OcclusionStats {
+    std::uint32_t occluderCount{}; ///< Number of occluders added.
+    std::uint32_t triangleCount{}; ///< Number of triangles rasterized, after clipping and culling.
+    std::uint32_t testedCount{};   ///< Number of bounding boxes tested by cull().
+    std::uint32_t culledCount{};   ///< Number of bounding boxes found hidden by cull().
+};
+
+/// @brief Software occlusion culling.
+///
+/// The triangles of a few large occluders are rasterized on the CPU into a low resolution
+/// depth buffer, then a hierarchy of depth buffers is built where each texel keep the
+/// farthest depth of the 2x2 texels below it. A bounding box is hidden when the depth of
+/// it nearest corner is behind the farthest occluder depth of all the texels it covers,
+/// so a box is tested by reading a few texels of the level matching it size on screen.
+///
+/// The depth buffer is split in tiles of kTileSize x kTileSize pixels. The triangles are
+/// binned per tile when added, then the tiles are rasterized independently across the
+/// threads of a WorkerPool. The test is conservative: the triangles crossing the near
+/// plane are clipped and a box crossing the near plane is always visible.
+///
+/// @code
+/// culler.begin(proj * view);
+/// culler.addOccluder(registry, mesh, world); // for each occluder
+/// culler.rasterize(&workers);
+/// const bool visible = culler.isVisible(boundsMin, boundsMax, world);
+/// @endcode
+class OcclusionCuller {
+public:
+    static constexpr unsigned kTileSize = 32; ///< Width and height of a tile in pixels.
+
+    /// @brief Construct a culler.
+    /// @param width The width of the depth buffer, a power of two multiple of kTileSize.
+    /// @param height The height of the depth buffer, a power of two multiple of kTileSize.
+    explicit OcclusionCuller(unsigned width = 256, unsigned height = 128);
+
+    /// @brief Start a new frame: clear the depth buffer and the occluders.
+    /// @param viewProj The projection * view matrix of the camera.
+    void begin(const Mat4& viewProj);
+
+    /// @brief Add the triangles of a mesh of the registry as a occluder.
+    /// @param registry The registry of the mesh.
+    /// @param mesh The mesh to rasterize.
+    /// @param world The world matrix of the occluder.
+    void addOccluder(const MeshRegistry& registry, MeshHandle mesh, const Mat4& world);
+
+    /// @brief Add a indexed triangle list as a occluder.
+    /// @param vertices The vertices of the triangles.
+    /// @param indices Three indices per triangle.
+    /// @param world The world matrix of the occluder.
+    void addOccluder(std::span<const Vertex>        vertices,
+                     std::span<const std::uint32_t> indices,
+                     const Mat4&                    world);
+
+    /// @brief Rasterize the occluders and build the depth hierarchy.
+    ///
+    /// A few triangles are rasterized on the calling thread, waking the workers would cost
+    /// more than rasterizing them.
+    /// @param workers The threads used, or nullptr to rasterize on the calling thread.
+    void rasterize(WorkerPool* workers = nullptr);
+
+    /// @brief Test if a bounding box is visible.
+    ///
+    /// A box outside of the view is not visible, a box crossing the near plane is always
+    /// visible. Must be called after rasterize().
+    /// @param boundsMin The minimum corner of the box in model space.
+    /// @param boundsMax The maximum corner of the box in model space.
+    /// @param world The world matrix of the box.
+    [[nodiscard]] bool isVisible(const Vec3& boundsMin,
+                                 const Vec3& boundsMax,
+                                 const Mat4& world) const noexcept;
+
+    /// @brief Remove the hidden entries of a render list.
+    ///
+    /// The entries keep their order. Must be called after rasterize().
+    /// @param renderList The list to cull.
+    /// @param meshes The meshes of the entries, indexed by mesh id (gives the bounding boxes).
+    /// @param workers The threads used, or nullptr to test on the calling thread.
+    /// @return The number of entries removed.
+    std::size_t cull(RenderList&               renderList,
+                     std::span<const MeshInfo> meshes,
+                     WorkerPool*               workers = nullptr);
+
+    /// @brief Get the depth of a pixel of a level, in range [0, 1] (1 is the far plane).
+    [[nodiscard]] float getDepth(unsigned level, unsigned x, unsigned y) const noexcept;
+
+    /// @brief Get the number of levels of the depth hierarchy.
+    [[nodiscard]] unsigned getLevelCount() const noexcept {
+        return static_cast<unsigned>(mLevels.size());
+    }
+
+    /// @brief Get the width of the depth buffer.
+    [[nodiscard]] unsigned getWidth() const noexcept { return mWidth; }
+
+    /// @brief Get the height of the depth buffer.
+    [[nodiscard]] unsigned getHeight() const noexcept { return mHeight; }
+
+    /// @brief Get the counters of the current frame.
+    [[nodiscard]] const OcclusionStats& getStats() const noexcept { return mStats; }
+
+private:
+    /// @brief Triangle in screen space, as plane equations of the pixel coordinates.
+    struct ScreenTriangle {
+        float edges[3][3]; ///< Barycentric i = edges[i][0] * x + edges[i][1] * y + edges[i][2].
+        float depth[3];    ///< Depth = depth[0] * x + depth[1] * y + depth[2].
+        int   minX, minY;  ///< Bounding rectangle in pixels (included).
+        int   maxX, maxY;  ///< Bounding rectangle in pixels (included).
+    };
+
+    template <class Index>
+    void addIndexedTriangles(std::span<const Vertex> vertices,
+                             std::span<const Index>  indices,
+                             const Mat4&             world);
+
+    /// @brief Clip a clip space triangle by the near plane, then set it up and bin it.
+    void addClipTriangle(const Vec4& a, const Vec4& b, const Vec4& c);
+
+    /// @brief Set up a triangle inside the near plane and add it to the bins of it tiles.
+    void addScreenTriangle(const Vec4& a, const Vec4& b, const Vec4& c);
+
+    /// @brief Rasterize the triangles of a tile.
+    void rasterizeTile(unsigned tile) noexcept;
+
+    unsigned                           mWidth;
+    unsigned                           mHeight;
+    unsigned                           mTileCountX;
+    unsigned                           mTileCountY;
+    Mat4                               mViewProj{Mat4::kIdentity};
+    std::vector<std::vector<float>>    mLevels;    ///< Level 0 is the depth buffer.
+    std::vector<ScreenTriangle>        mTriangles; ///< Triangles of the frame.
+    std::vector<std::vector<unsigned>> mTileBins;  ///< Triangles overlapping each tile.
+    std::vector<std::uint8_t>          mVisible;   ///< Result of cull() per entry.
+    OcclusionStats                     mStats;
+};
+
+} // namespace fuse
@@ -0,0 +1,180 @@
+#include "RenderQueue.h"
+
+#include <FuseCore/scene/RenderList.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace {
+
+using fuse::SortKey;
+
+static_assert(SortKey::kPassBits + SortKey::kShaderBits + SortKey::kMaterialBits +
+                SortKey::kMeshBits + SortKey::kDepthBits ==
+              64);
+
+constexpr unsigned kPassShift = 64 - SortKey::kPassBits;
+
+// opaque: | pass | shader | material | mesh | depth |
+constexpr unsigned kOpaqueDepthShift    = 0;
+constexpr unsigned kOpaqueMeshShift     = kOpaqueDepthShift + SortKey::kDepthBits;
+constexpr unsigned kOpaqueMaterialShift = kOpaqueMeshShift + SortKey::kMeshBits;
+constexpr unsigned kOpaqueShaderShift   = kOpaqueMaterialShift + SortKey::kMaterialBits;
+
+// transparent: | pass | depth | shader | material | mesh |
+constexpr unsigned kTransparentMeshShift     = 0;
+constexpr unsigned kTransparentMaterialShift = kTransparentMeshShift + SortKey::kMeshBits;
+constexpr unsigned kTransparentShaderShift   = kTransparentMaterialShift + SortKey::kMaterialBits;
+constexpr unsigned kTransparentDepthShift    = kTransparentShaderShift + SortKey::kShaderBits;
+
+constexpr std::uint32_t extract(std::uint64_t key, unsigned shift, std::uint32_t mask) noexcept {
+    return static_cast<std::uint32_t>(key >> shift) & mask;
+}
+
+constexpr unsigned kRadixBits    = 8;
+constexpr unsigned kRadixBuckets = 1U << kRadixBits;
+constexpr unsigned kRadixPasses  = 64 / kRadixBits;
+
+} // namespace
+
+namespace fuse {
+
+std::uint64_t SortKey::Make(RenderPass    pass,
+                            std::uint32_t shader,
+                            std::uint32_t material,
+                            std::uint32_t mesh) noexcept {
+    assert(shader <= kMaxShader && material <= kMaxMaterial && mesh <= kMaxMesh);
+    const bool opaque = pass == RenderPass::Opaque;
+
+    std::uint64_t key = static_cast<std::uint64_t>(pass) << kPassShift;
+    key |= static_cast<std::uint64_t>(shader)
+           << (opaque ? kOpaqueShaderShift : kTransparentShaderShift);
+    key |= static_cast<std::uint64_t>(material)
+           << (opaque ? kOpaqueMaterialShift : kTransparentMaterialShift);
+    key |= static_cast<std::uint64_t>(mesh) << (opaque ? kOpaqueMeshShift : kTransparentMeshShift);
+    return key;
+}
+
+std::uint64_t SortKey::WithDepth(std::uint64_t key, std::uint32_t depth) noexcept {
+    assert(depth <= kMaxDepth);
+    if (static_cast<RenderPass>(key >> kPassShift) == RenderPass::Opaque) {
+        return key | (static_cast<std::uint64_t>(depth) << kOpaqueDepthShift);
+    }
+    // back to front: the furthest draw get the smallest key.
+    return key | (static_cast<std::uint64_t>(kMaxDepth - depth) << kTransparentDepthShift);
+}
+
+SortKeyFields SortKey::Decode(std::uint64_t key) noexcept {
+    SortKeyFields fields;
+    fields.pass = static_cast<RenderPass>(key >> kPassShift);
+    if (fields.pass == RenderPass::Opaque) {
+        fields.shader   = extract(key, kOpaqueShaderShift, kMaxShader);
+        fields.material = extract(key, kOpaqueMaterialShift, kMaxMaterial);
+        fields.mesh     = extract(key, kOpaqueMeshShift, kMaxMesh);
+        fields.depth    = extract(key, kOpaqueDepthShift, kMaxDepth);
+    } else {
+        fields.shader   = extract(key, kTransparentShaderShift, kMaxShader);
+        fields.material = extract(key, kTransparentMaterialShift, kMaxMaterial);
+        fields.mesh     = extract(key, kTransparentMeshShift, kMaxMesh);
+        fields.depth    = kMaxDepth - extract(key, kTransparentDepthShift, kMaxDepth);
+    }
+    return fields;
+}
+
+std::uint32_t SortKey::QuantizeDepth(float distance, float maxDistance) noexcept {
+    assert(maxDistance > 0.0f);
+    const float normalized = std::clamp(distance / maxDistance, 0.0f, 1.0f);
+    return static_cast<std::uint32_t>(normalized * static_cast<float>(kMaxDepth));
+}
+
+void RenderQueue::sort() {
+    if (mItems.size() < 2) {
+        return;
+    }
+
+    // histogram of all the bytes in a single read of the keys
+    std::array<std::array<std::uint32_t, kRadixBuckets>, kRadixPasses> histograms{};
+    for (const auto& item : mItems) {
+        for (unsigned pass = 0; pass < kRadixPasses; pass++) {
+            histograms[pass][(item.key >> (pass * kRadixBits)) & (kRadixBuckets - 1)]++;
+        }
+    }
+
+    mScratch.resize(mItems.size());
+    for (unsigned pass = 0; pass < kRadixPasses; pass++) {
+        auto& histogram = histograms[pass];
+
+        // all the keys share this byte, the pass would not move anything
+        const std::uint32_t firstByte =
+          (mItems.front().key >> (pass * kRadixBits)) & (kRadixBuckets - 1);
+        if (histogram[firstByte] == mItems.size()) {
+            continue;
+        }
+
+        std::uint32_t offset = 0;
+        for (auto& count : histogram) {
+            const std::uint32_t bucketSize = count;
+            count                          = offset;
+            offset += bucketSize;
+        }
+
+        for (const auto& item : mItems) {
+            mScratch[histogram[(item.key >> (pass * kRadixBits)) & (kRadixBuckets - 1)]++] = item;
+        }
+        mItems.swap(mScratch);
+    }
+}
+
+void RenderQueue::build(const RenderList& renderList, const Mat4& view, float maxDistance) {
+    assert(renderList.sortKeys.size() == renderList.size());
+    mItems.resize(renderList.size());
+
+    // the camera look down -z in view space
+    const Vec4 depthRow = view.getRow(2);
+    for (std::size_t i = 0; i < renderList.size(); i++) {
+        const Mat4& world    = renderList.worldMatrices[i];
+        const float distance = -(depthRow.x * world(0, 3) + depthRow.y * world(1, 3) +
+                                 depthRow.z * world(2, 3) + depthRow.w);
+
+        mItems[i].key   = SortKey::WithDepth(renderList.sortKeys[i],
+                                           SortKey::QuantizeDepth(distance, maxDistance));
+        mItems[i].index = static_cast<std::uint32_t>(i);
+    }
+    sort();
+}
+
+RenderQueueStats RenderQueue::computeStats() const noexcept {
+    RenderQueueStats stats;
+    stats.drawCount = static_cast<std::uint32_t>(mItems.size());
+
+    SortKeyFields previous;
+    bool          first = true; // the first draw bind all the states
+    for (const auto& item : mItems) {
+        const SortKeyFields fields = SortKey::Decode(item.key);
+        if (fields.pass == RenderPass::Transparent) {
+            stats.transparentCount++;
+        }
+        if (first || fields.pass != previous.pass) {
+            stats.passChanges++;
+        }
+        if (first || fields.shader != previous.shader) {
+            stats.shaderChanges++;
+        }
+        if (first || fields.material != previous.material) {
+            stats.materialChanges++;
+        }
+        if (first || fields.mesh != previous.mesh) {
+            stats.meshChanges++;
+        }
+        if (first || fields.pass != previous.pass || fields.shader != previous.shader ||
+            fields.material != previous.material || fields.mesh != previous.mesh) {
+            stats.batchCount++;
+        }
+        previous = fields;
+        first    = false;
+    }
+    return stats;
+}
+
+} // namespace fuse
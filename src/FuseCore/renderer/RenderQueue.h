@@ -0,0 +1,137 @@
+#pragma once
+#include <FuseCore/math/Mat4.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fuse {
+
+struct RenderList;
+
+/// @brief Pass of a draw, the passes are drawn in this order.
+enum class RenderPass : std::uint8_t {
+    Opaque      = 0, ///< Drawn front to back, batched by state.
+    Transparent = 1, ///< Drawn back to front after the opaque draws.
+};
+
+/// @brief Fields packed in a sort key.
+struct SortKeyFields {
+    RenderPass    pass{};     ///< The render pass.
+    std::uint32_t shader{};   ///< The shader id (10 bits).
+    std::uint32_t material{}; ///< The material id (16 bits).
+    std::uint32_t mesh{};     ///< The mesh id (16 bits).
+    std::uint32_t depth{};    ///< The quantized depth (20 bits).
+};
+
+/// @brief Layout of the 64 bits sort keys.
+///
+/// The keys are compared as integers, so the most significant fields are the most
+/// expensive state changes:
+/// @code
+/// Opaque:      | pass:2 | shader:10 | material:16 | mesh:16 | depth:20          |
+/// Transparent: | pass:2 | depth:20 (inverted) | shader:10 | material:16 | mesh:16 |
+/// @endcode
+/// Opaque draws are grouped by state then sorted front to back inside a group.
+/// Transparent draws must be blended back to front, so the depth come first.
+class SortKey {
+public:
+    static constexpr unsigned kPassBits     = 2;
+    static constexpr unsigned kShaderBits   = 10;
+    static constexpr unsigned kMaterialBits = 16;
+    static constexpr unsigned kMeshBits     = 16;
+    static constexpr unsigned kDepthBits    = 20;
+
+    static constexpr std::uint32_t kMaxShader   = (1U << kShaderBits) - 1;
+    static constexpr std::uint32_t kMaxMaterial = (1U << kMaterialBits) - 1;
+    static constexpr std::uint32_t kMaxMesh     = (1U << kMeshBits) - 1;
+    static constexpr std::uint32_t kMaxDepth    = (1U << kDepthBits) - 1;
+
+    /// @brief Build the view independent part of a key, the depth field is left to 0.
+    /// @pre The ids must fit in their fields.
+    [[nodiscard]] static std::uint64_t Make(RenderPass    pass,
+                                            std::uint32_t shader,
+                                            std::uint32_t material,
+                                            std::uint32_t mesh) noexcept;
+
+    /// @brief Set the depth field of a key built by Make().
+    /// @param key A key with a depth field to 0.
+    /// @param depth The quantized depth (see QuantizeDepth()).
+    [[nodiscard]] static std::uint64_t WithDepth(std::uint64_t key, std::uint32_t depth) noexcept;
+
+    /// @brief Unpack the fields of a key.
+    [[nodiscard]] static SortKeyFields Decode(std::uint64_t key) noexcept;
+
+    /// @brief Quantize a view distance to the depth field.
+    /// @param distance The distance along the view direction.
+    /// @param maxDistance The distance mapped to the largest depth, further distances are
+    ///                    clamped.
+    [[nodiscard]] static std::uint32_t QuantizeDepth(float distance, float maxDistance) noexcept;
+};
+
+/// @brief Number of draws and state changes of a sorted queue.
+struct RenderQueueStats {
+    std::uint32_t drawCount{};        ///< Number of draws.
+    std::uint32_t transparentCount{}; ///< Number of draws in the transparent pass.
+    std::uint32_t passChanges{};      ///< Number of render pass changes.
+    std::uint32_t shaderChanges{};    ///< Number of shader changes.
+    std::uint32_t materialChanges{};  ///< Number of material changes.
+    std::uint32_t meshChanges{};      ///< Number of mesh changes.
+    std::uint32_t batchCount{};       ///< Number of runs of draws with the same state.
+};
+
+/// @brief Draws of a frame ordered by their sort key.
+///
+/// The queue store pairs of (key, index in the render list) and sort them with a
+/// LSD radix sort, one pass per byte of the keys. The passes over a byte that is the same
+/// for all the keys are skipped, so the unused high fields cost nothing.
+/// The buffers keep their capacity from a frame to the next.
+///
+/// @code
+/// queue.build(renderList, view);
+/// for (const auto& item : queue.getItems()) {
+///     draw(renderList, item.index);
+/// }
+/// @endcode
+class RenderQueue {
+public:
+    /// @brief A draw of the queue.
+    struct Item {
+        std::uint64_t key;   ///< The sort key.
+        std::uint32_t index; ///< The index of the draw in the render list.
+    };
+
+    /// @brief Remove all the draws, keep the capacity.
+    void clear() noexcept { mItems.clear(); }
+
+    /// @brief Add a draw.
+    /// @param key The sort key.
+    /// @param index The index of the draw in the render list.
+    void push(std::uint64_t key, std::uint32_t index) { mItems.push_back({key, index}); }
+
+    /// @brief Sort the draws by increasing key. The sort is stable.
+    void sort();
+
+    /// @brief Fill the queue from a render list and sort it.
+    ///
+    /// The depth of each draw is the distance of it origin along the view direction.
+    /// @param renderList The list to draw, it sort keys give the state of the draws.
+    /// @param view The view matrix.
+    /// @param maxDistance The view distance mapped to the largest depth.
+    void build(const RenderList& renderList, const Mat4& view, float maxDistance = 1000.0f);
+
+    /// @brief Get the draws, in order after sort().
+    [[nodiscard]] std::span<const Item> getItems() const noexcept { return mItems; }
+
+    /// @brief Get the number of draws.
+    [[nodiscard]] std::size_t size() const noexcept { return mItems.size(); }
+
+    /// @brief Count the state changes needed to submit the draws in the queue order.
+    [[nodiscard]] RenderQueueStats computeStats() const noexcept;
+
+private:
+    std::vector<Item> mItems;   ///< The draws.
+    std::vector<Item> mScratch; ///< Destination buffer of the radix sort passes.
+};
+
+} // namespace fuse
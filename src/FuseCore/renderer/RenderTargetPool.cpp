@@ -0,0 +1,89 @@
+#include "RenderTargetPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace fuse {
+
+RenderTargetPool::RenderTargetPool(CreateCallback  create,
+                                   DestroyCallback destroy,
+                                   std::uint32_t   maxUnusedFrames)
+    : mCreate(std::move(create))
+    , mDestroy(std::move(destroy))
+    , mMaxUnusedFrames(maxUnusedFrames) {
+    assert(mCreate && mDestroy);
+}
+
+RenderTargetPool::~RenderTargetPool() {
+    for (const auto& target : mTargets) {
+        mDestroy(target.handle, target.desc);
+    }
+}
+
+RenderTargetPool::Handle RenderTargetPool::acquire(const RenderTargetDesc& desc) {
+    assert(desc.width > 0 && desc.height > 0);
+    const auto it = std::ranges::find_if(
+      mTargets, [&](const Target& target) { return !target.used && target.desc == desc; });
+    if (it != mTargets.end()) {
+        it->used          = true;
+        it->lastUsedFrame = mFrame;
+        mStats.reusedCount++;
+        return it->handle;
+    }
+
+    const Handle handle = mCreate(desc);
+    assert(handle != 0);
+    mTargets.push_back({.handle = handle, .desc = desc, .lastUsedFrame = mFrame, .used = true});
+    mStats.createdCount++;
+    mStats.allocatedPixels += std::uint64_t{desc.width} * desc.height;
+    return handle;
+}
+
+void RenderTargetPool::release(Handle handle, RenderTargetFormat format) {
+    if (handle == 0) {
+        return;
+    }
+    const auto it = std::ranges::find_if(mTargets, [&](const Target& target) {
+        return target.handle == handle && target.desc.format == format;
+    });
+    assert(it != mTargets.end() && it->used);
+    it->used          = false;
+    it->lastUsedFrame = mFrame;
+}
+
+void RenderTargetPool::endFrame() {
+    for (std::size_t i = mTargets.size(); i-- > 0;) {
+        const Target& target = mTargets[i];
+        if (!target.used && mFrame - target.lastUsedFrame >= mMaxUnusedFrames) {
+            destroy(i);
+        }
+    }
+    mFrame++;
+}
+
+void RenderTargetPool::trim() {
+    for (std::size_t i = mTargets.size(); i-- > 0;) {
+        if (!mTargets[i].used) {
+            destroy(i);
+        }
+    }
+}
+
+RenderTargetPoolStats RenderTargetPool::getStats() const noexcept {
+    RenderTargetPoolStats stats = mStats;
+    stats.usedCount = static_cast<std::uint32_t>(std::ranges::count(mTargets, true, &Target::used));
+    stats.freeCount = static_cast<std::uint32_t>(mTargets.size()) - stats.usedCount;
+    return stats;
+}
+
+void RenderTargetPool::destroy(std::size_t index) {
+    const Target target = mTargets[index];
+    mTargets[index]     = mTargets.back();
+    mTargets.pop_back();
+    mDestroy(target.handle, target.desc);
+    mStats.destroyedCount++;
+    mStats.allocatedPixels -= std::uint64_t{target.desc.width} * target.desc.height;
+}
+
+} // namespace fuse
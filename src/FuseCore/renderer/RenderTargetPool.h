@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Format of a render target.
+enum class RenderTargetFormat : std::uint8_t {
+    RGBA8,           ///< 8 bits color, sampled by the editor.
+    Depth24Stencil8, ///< Depth and stencil, never sampled.
+    R32UI,           ///< 32 bits unsigned integer, for ids.
+};
+
+/// @brief Size and format of a render target, the key of the RenderTargetPool.
+struct RenderTargetDesc {
+    std::uint32_t      width{};  ///< Width in pixels.
+    std::uint32_t      height{}; ///< Height in pixels.
+    RenderTargetFormat format{}; ///< Format of the pixels.
+
+    bool operator==(const RenderTargetDesc&) const = default;
+};
+
+/// @brief Round a size up to the next multiple of a bucket.
+///
+/// A viewport resized with the mouse change of size every frame, rounding the size of it
+/// render targets up to a bucket only reallocate them when the size cross a bucket, the
+/// viewport then draw in the bottom left part of the targets.
+/// @param size The size in pixels.
+/// @param bucket The size of a bucket in pixels, not zero.
+/// @return The rounded size, at least one bucket.
+[[nodiscard]] constexpr std::uint32_t roundUpToBucket(std::uint32_t size,
+                                                      std::uint32_t bucket) noexcept {
+    return size <= bucket ? bucket : (size + bucket - 1) / bucket * bucket;
+}
+
+/// @brief Counters of a RenderTargetPool.
+struct RenderTargetPoolStats {
+    std::uint32_t usedCount{};       ///< Targets currently acquired.
+    std::uint32_t freeCount{};       ///< Targets released, kept for reuse.
+    std::uint64_t createdCount{};    ///< Targets created since the creation of the pool.
+    std::uint64_t reusedCount{};     ///< Acquisitions served by a free target.
+    std::uint64_t destroyedCount{};  ///< Targets destroyed since the creation of the pool.
+    std::uint64_t allocatedPixels{}; ///< Pixels of all the targets, used and free.
+};
+
+/// @brief Pool of render targets keyed by size and format.
+///
+/// A target released is not destroyed, it is kept for the next acquisition of the same
+/// size and format, and only destroyed when it was not acquired during maxUnusedFrames
+/// frames (see endFrame()). The pool does not know the graphic API, the targets are
+/// created and destroyed by callbacks and identified by the name returned by the create
+/// callback, which must not be zero, and by their format: the targets of different formats
+/// may take their names from different namespaces (e.g. OpenGL textures and renderbuffers),
+/// so the same name can be used by two targets.
+///
+/// @code
+/// const auto color = pool.acquire({width, height, RenderTargetFormat::RGBA8});
+/// // draw in color...
+/// pool.release(color, RenderTargetFormat::RGBA8);
+/// pool.endFrame();
+/// @endcode
+class RenderTargetPool {
+public:
+    using Handle          = std::uint32_t; ///< Name of a target, zero is not a valid name.
+    using CreateCallback  = std::function<Handle(const RenderTargetDesc&)>;
+    using DestroyCallback = std::function<void(Handle, const RenderTargetDesc&)>;
+
+    /// @brief Construct a pool.
+    /// @param create Create a target, return it name.
+    /// @param destroy Destroy a target created by create.
+    /// @param maxUnusedFrames The number of frames a free target is kept.
+    RenderTargetPool(CreateCallback  create,
+                     DestroyCallback destroy,
+                     std::uint32_t   maxUnusedFrames = 60);
+
+    /// @brief Destroy all the targets, used or not.
+    ~RenderTargetPool();
+
+    RenderTargetPool(const RenderTargetPool&)            = delete;
+    RenderTargetPool(RenderTargetPool&&)                 = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(RenderTargetPool&&)      = delete;
+
+    /// @brief Acquire a target, reuse a free target of the same size and format if any.
+    /// @param desc The size and format of the target, with a non zero size.
+    /// @return The name of the target, it stay valid until release().
+    [[nodiscard]] Handle acquire(const RenderTargetDesc& desc);
+
+    /// @brief Give back a target acquired with acquire(), it can be reused from now.
+    /// @param handle The name of the target, zero is ignored.
+    /// @param format The format of the target.
+    void release(Handle handle, RenderTargetFormat format);
+
+    /// @brief End a frame, destroy the free targets unused for more than maxUnusedFrames.
+    void endFrame();
+
+    /// @brief Destroy all the free targets.
+    void trim();
+
+    /// @brief Get the counters of the pool.
+    [[nodiscard]] RenderTargetPoolStats getStats() const noexcept;
+
+private:
+    struct Target {
+        Handle           handle{};
+        RenderTargetDesc desc;
+        std::uint64_t    lastUsedFrame{}; ///< Last frame the target was acquired or used.
+        bool             used{};
+    };
+
+    void destroy(std::size_t index);
+
+    CreateCallback        mCreate;
+    DestroyCallback       mDestroy;
+    std::vector<Target>   mTargets;
+    std::uint64_t         mFrame{};
+    std::uint32_t         mMaxUnusedFrames{};
+    RenderTargetPoolStats mStats;
+};
+
+} // namespace fuse
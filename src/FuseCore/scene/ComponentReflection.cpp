@@ -0,0 +1,37 @@
+#include "ComponentReflection.h"
+
+#include <array>
+
+namespace {
+
+template <class... Components>
+struct ComponentList {
+    static constexpr std::array kInfos = {&fuse::kComponentInfo<Components>...};
+
+    static void registerMeta() { (fuse::registerComponentMeta<Components>(), ...); }
+};
+
+using ReflectedComponents = ComponentList<fuse::CTransform,
+                                          fuse::CMesh,
+                                          fuse::CStatic,
+                                          fuse::CLod,
+                                          fuse::CRotator,
+                                          fuse::CTranslator>;
+
+} // namespace
+
+namespace fuse {
+
+std::span<const ComponentInfo* const> getReflectedComponents() noexcept {
+    return ReflectedComponents::kInfos;
+}
+
+void registerReflectedComponents() {
+    // The meta types are global, they are shared by all the scenes.
+    [[maybe_unused]] static const bool registered = [] {
+        ReflectedComponents::registerMeta();
+        return true;
+    }();
+}
+
+} // namespace fuse
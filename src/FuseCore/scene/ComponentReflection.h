@@ -0,0 +1,38 @@
+#pragma once
+#include "Components.h"
+#include "Reflection.h"
+
+#include <span>
+
+// The runtime state of the components (CLod::level) is not reflected, it is not edited
+// nor saved. NameComponent and IDComponent are saved with the entities by SceneSerializer.
+
+FUSE_REFLECT_COMPONENT(fuse::CTransform,
+                       FUSE_FIELD(translation),
+                       FUSE_FIELD(rotation),
+                       FUSE_FIELD(scale));
+
+FUSE_REFLECT_COMPONENT(fuse::CMesh, FUSE_FIELD(color), FUSE_FIELD(mesh), FUSE_FIELD(occluder));
+
+FUSE_REFLECT_COMPONENT(fuse::CStatic);
+
+FUSE_REFLECT_COMPONENT(fuse::CLod,
+                       FUSE_FIELD_RANGE(levelCount, 0.0f, static_cast<float>(Type::kMaxLevels)),
+                       FUSE_FIELD(meshes),
+                       FUSE_FIELD_RANGE(screenSizes, 0.0f, 1.0f));
+
+FUSE_REFLECT_COMPONENT(fuse::CRotator, FUSE_FIELD(angle), FUSE_FIELD(axis));
+
+FUSE_REFLECT_COMPONENT(fuse::CTranslator, FUSE_FIELD(direction), FUSE_FIELD(duration));
+
+namespace fuse {
+
+/// @brief Get the reflected components, in the order of the inspector.
+[[nodiscard]] std::span<const ComponentInfo* const> getReflectedComponents() noexcept;
+
+/// @brief Register the reflected components into entt::meta (see findComponentInfo()).
+///
+/// Only the first call register the components, the next calls do nothing.
+void registerReflectedComponents();
+
+} // namespace fuse
@@ -2,26 +2,33 @@
 #include <FuseCore/math/Angle.h>
 #include <FuseCore/math/Vec3.h>
 #include <FuseCore/math/Vec4.h>
+#include <FuseCore/renderer/Mesh.h>
+#include <FuseCore/utils/StringInterner.h>
+#include <FuseCore/utils/UUID.h>
 
-#include <string>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace fuse {
 
+/// @brief Name of an entity.
+///
+/// The name is a handle into the scene string interner, use Scene::getEntityName()
+/// to retrieve it. An invalid handle means the default name is generated on first use.
 struct NameComponent {
-    std::string name;
+    StringId name;
 
     auto operator<=>(const NameComponent&) const = default;
 };
 
+/// @brief Unique identifier of an entity.
+///
+/// A new UUID is generated each time the component is default constructed.
 struct IDComponent {
-    IDComponent() {
-        static unsigned staticId = 0;
-        id                       = staticId++;
-    }
+    UUID id = UUID::Generate();
 
     auto operator<=>(const IDComponent&) const = default;
-
-    unsigned id;
 };
 
 struct CTransform {
@@ -32,6 +39,14 @@ struct CTransform {
 
 static_assert(sizeof(CTransform) == sizeof(float) * 9);
 
+/// @brief Transform of an entity at the previous simulation step.
+///
+/// Used to interpolate the transform between two fixed simulation steps
+/// (see storePreviousTransforms() and interpolateTransform()).
+struct CPreviousTransform {
+    CTransform transform;
+};
+
 struct CRotator {
     Angle angle;
     Vec3  axis{}; // TODO: should be init....
@@ -47,7 +62,36 @@ struct CTranslator {
 static_assert(sizeof(CTranslator) == sizeof(float) * 4);
 
 struct CMesh {
-    Vec4 color{1.f, 1.f, 1.f, 1.f};
+    Vec4       color{1.f, 1.f, 1.f, 1.f};
+    MeshHandle mesh{MeshHandle::kCube}; ///< Mesh in the MeshRegistry of the scene.
+    bool       occluder{false};         ///< Hide the meshes behind it (see OcclusionCuller).
+};
+
+/// @brief Mark a entity which never move or change of mesh.
+///
+/// The opaque meshes of the static entities are pre-transformed and merged in a few
+/// batches by the renderer (see StaticBatcher), instead of being drawn one by one. The
+/// batches are rebuilt when the static entities change (see Scene::getStaticVersion()).
+struct CStatic {};
+
+/// @brief Coarser meshes drawn instead of the CMesh of an entity when it is small on screen.
+///
+/// The level 0 is the mesh of the CMesh, the level i + 1 is meshes[i] and is used when the
+/// bounding sphere of the entity cover less than screenSizes[i] of the viewport height,
+/// so the screen sizes must decrease. The level is updated by selectLods().
+struct CLod {
+    static constexpr std::size_t kMaxLevels = 4; ///< Maximum number of coarser meshes.
+
+    std::array<MeshHandle, kMaxLevels> meshes{};      ///< Coarser meshes, the finest first.
+    std::array<float, kMaxLevels>      screenSizes{}; ///< Screen size under which use meshes[i].
+    std::uint8_t                       levelCount{};  ///< Number of coarser meshes used.
+    std::uint8_t                       level{};       ///< Current level, 0 is the CMesh.
 };
 
+/// @brief Mark a entity selected in the editor.
+///
+/// A empty type, EnTT keep only the entities in it storage: selecting or clearing many
+/// entities is cheap, and the selection is iterated as a view (see SelectionSummary).
+struct CSelected {};
+
 } // namespace fuse
@@ -1,4 +1,6 @@
 #pragma once
+#include "SignatureIndex.h"
+
 #include <entt/entity/entity.hpp>
 #include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
@@ -62,6 +64,7 @@ public:
     template <class Type, class... Args>
     decltype(auto) addComponent(Args... args) {
         assert(!hasComponents<Type>());
+        registerComponentType<Type>();
         return mEntity.emplace<Type>(std::forward<Args>(args)...);
     }
 
@@ -75,6 +78,7 @@ public:
     /// @return A reference to the newly created component or @b void for empty type.
     template <class Type, class... Args>
     decltype(auto) addOrReplaceComponent(Args... args) {
+        registerComponentType<Type>();
         return mEntity.emplace_or_replace<Type>(std::forward<Args>(args)...);
     }
 
@@ -168,6 +172,7 @@ public:
     /// \return References to the components owned by this entity.
     template <class Type, class... Args>
     decltype(auto) getOrAddComponent(Args... args) {
+        registerComponentType<Type>();
         return mEntity.get_or_emplace<Type>(std::forward<Args>(args)...);
     }
 
@@ -200,6 +205,15 @@ public:
 private:
     friend class Scene;
 
+    /// @brief Register a component type into the signature index of the scene (if any).
+    /// @tparam Type The component type to register.
+    template <class Type>
+    void registerComponentType() const {
+        if (auto* index = mEntity.registry()->ctx().template find<SignatureIndex>()) {
+            index->registerComponent<Type>(*mEntity.registry());
+        }
+    }
+
     entt::handle mEntity; ///< The Entt entity handle (pair of entt::entity + entt::registry).
 };
 
@@ -0,0 +1,87 @@
+#include "Lod.h"
+
+#include "RenderList.h"
+#include "Scene.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+/// @brief Get the number of triangles of a mesh.
+std::uint64_t getTriangleCount(const fuse::MeshRegistry& registry, fuse::MeshHandle mesh) {
+    return registry.getInfo(mesh).indexCount / 3;
+}
+
+} // namespace
+
+namespace fuse {
+
+float computeScreenSize(float radius, float distance, const Mat4& proj) noexcept {
+    // proj(1, 1) is cot(fovY / 2) for a perspective and 2 / height for a orthographic
+    // projection, the last row tell which one is used (w = -z or w = 1).
+    const bool perspective = std::abs(proj(3, 2)) > 0.0f;
+    if (!perspective) {
+        return radius * proj(1, 1);
+    }
+    if (distance <= radius) {
+        return std::numeric_limits<float>::max(); // the camera is inside the sphere
+    }
+    return radius * proj(1, 1) / distance;
+}
+
+std::uint8_t selectLodLevel(const CLod& lod, float screenSize, float hysteresis) noexcept {
+    assert(lod.levelCount <= CLod::kMaxLevels);
+    std::uint8_t level = std::min(lod.level, lod.levelCount);
+
+    // coarser when clearly under the threshold of the next level,
+    // finer when clearly above the threshold of the current level.
+    while (level < lod.levelCount && screenSize < lod.screenSizes[level] * (1.0f - hysteresis)) {
+        level++;
+    }
+    while (level > 0 && screenSize >= lod.screenSizes[level - 1] * (1.0f + hysteresis)) {
+        level--;
+    }
+    return level;
+}
+
+MeshHandle getLodMesh(const CMesh& mesh, const CLod& lod) noexcept {
+    const auto level = std::min(lod.level, lod.levelCount);
+    return level == 0 ? mesh.mesh : lod.meshes[level - 1];
+}
+
+LodStats selectLods(Scene& scene, const Mat4& proj, const Mat4& view, float hysteresis) {
+    const auto& meshes = scene.getMeshRegistry();
+    LodStats    stats;
+    for (auto&& [entity, lod, mesh, transform] :
+         scene.getRegistry().view<CLod, CMesh, CTransform>(entt::exclude<CStatic>).each()) {
+        // bounding sphere of the most detailed mesh in view space
+        const MeshInfo& info       = meshes.getInfo(mesh.mesh);
+        const Vec3      center     = (info.boundsMin + info.boundsMax) * 0.5f;
+        const Mat4      world      = computeWorldMatrix(transform);
+        const Vec4      viewCenter = view * world * Vec4(center.x, center.y, center.z, 1.0f);
+        const float     scale      = std::max({std::abs(transform.scale.x),
+                                               std::abs(transform.scale.y),
+                                               std::abs(transform.scale.z)});
+        const float     radius     = (info.boundsMax - info.boundsMin).length() * 0.5f * scale;
+        const float     distance   = Vec3(viewCenter.x, viewCenter.y, viewCenter.z).length();
+        const float     screenSize = computeScreenSize(radius, distance, proj);
+
+        const auto level = selectLodLevel(lod, screenSize, hysteresis);
+        if (level != lod.level) {
+            lod.level = level;
+            stats.levelChanges++;
+        }
+
+        const auto triangleCount = getTriangleCount(meshes, getLodMesh(mesh, lod));
+        const auto fullCount     = getTriangleCount(meshes, mesh.mesh);
+        stats.entityCount++;
+        stats.triangleCount += triangleCount;
+        stats.savedTriangleCount += fullCount > triangleCount ? fullCount - triangleCount : 0;
+    }
+    return stats;
+}
+
+} // namespace fuse
@@ -0,0 +1,59 @@
+#pragma once
+#include "Components.h"
+
+#include <FuseCore/math/Mat4.h>
+
+#include <cstdint>
+
+namespace fuse {
+
+class Scene;
+
+/// @brief Counters of a selectLods() call.
+struct LodStats {
+    std::uint32_t entityCount{};        ///< Number of entities with a CLod.
+    std::uint32_t levelChanges{};       ///< Number of entities which changed of level.
+    std::uint64_t triangleCount{};      ///< Triangles of the selected meshes.
+    std::uint64_t savedTriangleCount{}; ///< Triangles of the CMesh not drawn thanks to the LODs.
+};
+
+/// @brief Compute the part of the viewport height covered by a sphere.
+///
+/// With a perspective projection the size decrease with the distance, with a
+/// orthographic projection only the radius matter.
+/// @param radius The radius of the sphere.
+/// @param distance The distance from the camera to the center of the sphere.
+/// @param proj The projection matrix.
+/// @return The diameter of the sphere on screen divided by the viewport height.
+[[nodiscard]] float computeScreenSize(float radius, float distance, const Mat4& proj) noexcept;
+
+/// @brief Select the level of a CLod for a screen size.
+///
+/// The level only change when the size cross the threshold of a level by more than the
+/// hysteresis (in percent of the threshold), so a entity around a threshold does not
+/// switch of mesh every frame.
+/// @param lod The lod, the current level is lod.level.
+/// @param screenSize The size of the entity on screen (see computeScreenSize()).
+/// @param hysteresis The margin around the thresholds, in range [0, 1).
+/// @return The new level, in range [0, lod.levelCount].
+[[nodiscard]] std::uint8_t selectLodLevel(const CLod& lod,
+                                          float       screenSize,
+                                          float       hysteresis) noexcept;
+
+/// @brief Get the mesh drawn for the current level of a CLod.
+[[nodiscard]] MeshHandle getLodMesh(const CMesh& mesh, const CLod& lod) noexcept;
+
+/// @brief Update the level of the CLod of a scene for a camera.
+///
+/// The screen size of a entity is computed from the bounding sphere of the mesh of
+/// it CMesh. Must be called before the extraction of the scene (see extractRenderList()),
+/// which draw the mesh of the current level. The static entities (see CStatic) are
+/// skipped, they are always drawn with their CMesh.
+/// @param scene The scene to update.
+/// @param proj The projection matrix of the camera.
+/// @param view The view matrix of the camera.
+/// @param hysteresis The margin around the thresholds (see selectLodLevel()).
+/// @return The number of triangles drawn and saved.
+LodStats selectLods(Scene& scene, const Mat4& proj, const Mat4& view, float hysteresis = 0.1f);
+
+} // namespace fuse
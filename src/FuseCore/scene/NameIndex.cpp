@@ -0,0 +1,176 @@
+#include "NameIndex.h"
+
+#include "Components.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <format>
+#include <iterator>
+#include <string>
+
+namespace {
+
+/// @brief Lower case prefix of the default names, see NameIndex::FormatDefaultName().
+constexpr std::string_view kDefaultNamePrefix = "entity (";
+
+/// @brief Characters of the default names.
+constexpr std::string_view kDefaultNameCharacters = "entity ()0123456789";
+
+char toLower(char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); }
+
+/// @brief Check if a name contains a lower case text, ignoring the case of the name.
+bool containsIgnoreCase(std::string_view name, std::string_view lowerText) {
+    return lowerText.empty() || !std::ranges::search(name, lowerText, {}, toLower).empty();
+}
+
+/// @brief Pack 3 lower case characters.
+std::uint32_t makeTrigram(const char* lowerText) {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(lowerText[0])) |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(lowerText[1])) << 8 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(lowerText[2])) << 16;
+}
+
+} // namespace
+
+namespace fuse {
+
+void NameIndex::connect(entt::registry& registry) {
+    registry.on_construct<NameComponent>().connect<&NameIndex::onConstruct>(*this);
+    registry.on_update<NameComponent>().connect<&NameIndex::onUpdate>(*this);
+    registry.on_destroy<NameComponent>().connect<&NameIndex::onDestroy>(*this);
+}
+
+void NameIndex::insert(entt::entity entity, StringId name) {
+    const std::size_t index = entt::to_entity(entity);
+    if (index >= mSlots.size()) {
+        mSlots.resize(index + 1);
+    }
+    assert(!mSlots[index].used && "Entity already in the index.");
+
+    if (name.value() >= mNameEntities.size()) {
+        mNameEntities.resize(name.value() + 1);
+    }
+    auto& entities = mNameEntities[name.value()];
+    mSlots[index]  = {.name     = name.value(),
+                      .position = static_cast<std::uint32_t>(entities.size()),
+                      .used     = true};
+    entities.push_back(entity);
+    mSize++;
+}
+
+void NameIndex::erase(entt::entity entity) {
+    const std::size_t index = entt::to_entity(entity);
+    if (index >= mSlots.size() || !mSlots[index].used) {
+        return;
+    }
+
+    // Swap with the last entity of the name, the order of the entities is not kept.
+    Slot& slot              = mSlots[index];
+    auto& entities          = mNameEntities[slot.name];
+    entities[slot.position] = entities.back();
+    entities.pop_back();
+    if (slot.position < entities.size()) {
+        mSlots[entt::to_entity(entities[slot.position])].position = slot.position;
+    }
+    slot.used = false;
+    mSize--;
+}
+
+void NameIndex::search(const StringInterner&      interner,
+                       std::string_view           text,
+                       std::vector<entt::entity>& entities) {
+    entities.clear();
+    indexNames(interner);
+
+    std::string lowerText(text);
+    std::ranges::transform(lowerText, lowerText.begin(), toLower);
+
+    const auto addName = [&](std::uint32_t name) {
+        if (name < mNameEntities.size() && !mNameEntities[name].empty() &&
+            containsIgnoreCase(interner.resolve(StringId(name)), lowerText)) {
+            entities.insert(entities.end(), mNameEntities[name].begin(), mNameEntities[name].end());
+        }
+    };
+
+    if (lowerText.size() < 3) {
+        // Too short to have a trigram, check every name.
+        for (std::uint32_t name = 1; name < mNameEntities.size(); name++) {
+            addName(name);
+        }
+    } else {
+        // A name containing the text contains all it trigrams, check the rarest one.
+        const std::vector<std::uint32_t>* candidates = nullptr;
+        for (std::size_t i = 0; i + 3 <= lowerText.size(); i++) {
+            const auto it = mTrigrams.find(makeTrigram(lowerText.data() + i));
+            if (it == mTrigrams.end()) {
+                candidates = nullptr;
+                break;
+            }
+            if (!candidates || it->second.size() < candidates->size()) {
+                candidates = &it->second;
+            }
+        }
+        if (candidates) {
+            std::ranges::for_each(*candidates, addName);
+        }
+    }
+
+    // The entities without a name.
+    if (mNameEntities.empty() || mNameEntities[0].empty()) {
+        return;
+    }
+    const auto& unnamed = mNameEntities[0];
+    if (kDefaultNamePrefix.contains(lowerText)) {
+        entities.insert(entities.end(), unnamed.begin(), unnamed.end());
+    } else if (lowerText.find_first_not_of(kDefaultNameCharacters) == std::string::npos) {
+        // The text contains the number of the entity, the default names must be formatted.
+        std::array<char, 32> buffer;
+        std::ranges::copy_if(unnamed, std::back_inserter(entities), [&](entt::entity entity) {
+            return containsIgnoreCase(FormatDefaultName(entity, buffer), lowerText);
+        });
+    }
+}
+
+std::string_view NameIndex::FormatDefaultName(entt::entity          entity,
+                                              std::array<char, 32>& buffer) noexcept {
+    const auto result =
+      std::format_to_n(buffer.data(), buffer.size(), "Entity ({})", entt::to_entity(entity));
+    return {buffer.data(), result.out};
+}
+
+void NameIndex::onConstruct(entt::registry& registry, entt::entity entity) {
+    insert(entity, registry.get<NameComponent>(entity).name);
+}
+
+void NameIndex::onUpdate(entt::registry& registry, entt::entity entity) {
+    erase(entity);
+    insert(entity, registry.get<NameComponent>(entity).name);
+}
+
+void NameIndex::onDestroy(entt::registry& /*registry*/, entt::entity entity) { erase(entity); }
+
+void NameIndex::indexNames(const StringInterner& interner) {
+    const auto nameCount = static_cast<std::uint32_t>(interner.size());
+    if (interner.getGeneration() != mInternerGeneration) {
+        // The interner was cleared, the ids were given again to other names.
+        mTrigrams.clear();
+        mIndexedNames       = 0;
+        mInternerGeneration = interner.getGeneration();
+    }
+
+    std::string lowerName;
+    for (std::uint32_t name = mIndexedNames + 1; name <= nameCount; name++) {
+        lowerName = interner.resolve(StringId(name));
+        std::ranges::transform(lowerName, lowerName.begin(), toLower);
+        for (std::size_t i = 0; i + 3 <= lowerName.size(); i++) {
+            auto& names = mTrigrams[makeTrigram(lowerName.data() + i)];
+            if (names.empty() || names.back() != name) {
+                names.push_back(name);
+            }
+        }
+    }
+    mIndexedNames = nameCount;
+}
+
+} // namespace fuse
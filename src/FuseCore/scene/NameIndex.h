@@ -0,0 +1,85 @@
+#pragma once
+#include <FuseCore/utils/StringInterner.h>
+
+#include <entt/container/dense_map.hpp>
+#include <entt/entity/entity.hpp>
+#include <entt/entity/registry.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Substring search over the names of the entities.
+///
+/// The index keep the entities of each interned name, updated from the construct/update/destroy
+/// signals of the NameComponent storage. The unique names are indexed by their trigrams
+/// (3 consecutive lower case characters): a search only check the names sharing the rarest
+/// trigram of the text, then gather their entities. Many entities usually share a few names,
+/// so a search does not depend on the number of entities but on the number of results.
+///
+/// The entities without a name (default name generated by Scene::getEntityName()) are kept
+/// apart and matched against their default name.
+class NameIndex {
+public:
+    NameIndex() = default;
+
+    /// @brief Connect the index to the NameComponent signals of a registry.
+    /// @param registry The registry to track.
+    void connect(entt::registry& registry);
+
+    /// @brief Add a entity to the index.
+    /// @param entity The entity, not in the index.
+    /// @param name The name of the entity, invalid for the default name.
+    void insert(entt::entity entity, StringId name);
+
+    /// @brief Remove a entity from the index. Does nothing if the entity is not in the index.
+    /// @param entity The entity to remove.
+    void erase(entt::entity entity);
+
+    /// @brief Find the entities with a name containing a text, ignoring the case.
+    ///
+    /// The names interned since the previous search are indexed first.
+    /// @param interner The interner of the names.
+    /// @param text The text to search, a empty text match every entity.
+    /// @param entities Receive the entities found, grouped by name.
+    void search(const StringInterner&      interner,
+                std::string_view           text,
+                std::vector<entt::entity>& entities);
+
+    /// @brief Get the number of entities in the index.
+    [[nodiscard]] std::size_t size() const noexcept { return mSize; }
+
+    /// @brief Format the default name of a entity without a name.
+    /// @param entity The entity.
+    /// @param buffer Receive the characters of the name.
+    /// @return The name, pointing into @p buffer.
+    [[nodiscard]] static std::string_view FormatDefaultName(entt::entity          entity,
+                                                            std::array<char, 32>& buffer) noexcept;
+
+private:
+    void onConstruct(entt::registry& registry, entt::entity entity);
+    void onUpdate(entt::registry& registry, entt::entity entity);
+    void onDestroy(entt::registry& registry, entt::entity entity);
+
+    /// @brief Index the trigrams of the names interned since the last call.
+    void indexNames(const StringInterner& interner);
+
+    /// @brief Position of a entity in the index.
+    struct Slot {
+        std::uint32_t name{};     ///< Raw value of the StringId.
+        std::uint32_t position{}; ///< Index into mNameEntities[name].
+        bool          used{};     ///< The entity is in the index.
+    };
+
+    std::vector<std::vector<entt::entity>> mNameEntities; ///< Entities of each name, 0 is unnamed.
+    std::vector<Slot>                      mSlots;        ///< Slot of each entity, by entity index.
+    std::size_t                            mSize{};       ///< Number of entities in the index.
+    entt::dense_map<std::uint32_t, std::vector<std::uint32_t>> mTrigrams; ///< Names by trigram.
+    std::uint32_t mIndexedNames{};       ///< The names with a greater value are not in mTrigrams.
+    std::uint32_t mInternerGeneration{}; ///< Generation of the interner of mTrigrams.
+};
+
+} // namespace fuse
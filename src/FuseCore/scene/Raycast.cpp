@@ -0,0 +1,289 @@
+#include "Raycast.h"
+
+#include "RenderList.h"
+#include "Scene.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+/// @brief Number of boxes tested before searching the nearest, fit on the stack.
+constexpr std::size_t kTestBlockSize = 64;
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+std::array<float, 3> toArray(const fuse::Vec3& vec) noexcept { return {vec.x, vec.y, vec.z}; }
+
+/// @brief Get the cell of a coordinate on a axis, clamped to the grid.
+std::uint32_t getCell(float value, float gridMin, float cellSize, std::uint32_t cellCount) {
+    const float cell = std::floor((value - gridMin) / cellSize);
+    return static_cast<std::uint32_t>(std::clamp(cell, 0.0f, static_cast<float>(cellCount - 1)));
+}
+
+} // namespace
+
+namespace fuse {
+
+Ray computeRay(const Mat4& invViewProj, float ndcX, float ndcY) noexcept {
+    // unproject the point on the near and far planes
+    const Vec4 nearPoint = invViewProj * Vec4(ndcX, ndcY, -1.0f, 1.0f);
+    const Vec4 farPoint  = invViewProj * Vec4(ndcX, ndcY, 1.0f, 1.0f);
+    const Vec3 origin    = Vec3(nearPoint.x, nearPoint.y, nearPoint.z) / nearPoint.w;
+    const Vec3 target    = Vec3(farPoint.x, farPoint.y, farPoint.z) / farPoint.w;
+    return {.origin = origin, .direction = (target - origin).normalized()};
+}
+
+void RaycastGrid::build(const Scene& scene) {
+    mBoundsMin.clear();
+    mBoundsMax.clear();
+    mEntities.clear();
+
+    const auto& meshes = scene.getMeshRegistry();
+    for (auto&& [entity, mesh, transform] :
+         scene.getRegistry().view<const CMesh, const CTransform>().each()) {
+        const MeshInfo& info  = meshes.getInfo(mesh.mesh);
+        const Mat4      world = computeWorldMatrix(transform);
+
+        // the box transformed is bounded by the center transformed +- the extent
+        // projected on each world axis.
+        const Vec3 center      = (info.boundsMin + info.boundsMax) * 0.5f;
+        const Vec3 extent      = (info.boundsMax - info.boundsMin) * 0.5f;
+        const Vec4 worldCenter = world * Vec4(center.x, center.y, center.z, 1.0f);
+        Vec3       worldExtent;
+        worldExtent.x = std::abs(world(0, 0)) * extent.x + std::abs(world(0, 1)) * extent.y +
+                        std::abs(world(0, 2)) * extent.z;
+        worldExtent.y = std::abs(world(1, 0)) * extent.x + std::abs(world(1, 1)) * extent.y +
+                        std::abs(world(1, 2)) * extent.z;
+        worldExtent.z = std::abs(world(2, 0)) * extent.x + std::abs(world(2, 1)) * extent.y +
+                        std::abs(world(2, 2)) * extent.z;
+
+        const Vec3 position{worldCenter.x, worldCenter.y, worldCenter.z};
+        mBoundsMin.push_back(position - worldExtent);
+        mBoundsMax.push_back(position + worldExtent);
+        mEntities.push_back(entity);
+    }
+    build(mBoundsMin, mBoundsMax, mEntities);
+}
+
+void RaycastGrid::build(std::span<const Vec3>         boundsMin,
+                        std::span<const Vec3>         boundsMax,
+                        std::span<const entt::entity> entities) {
+    assert(boundsMin.size() == entities.size() && boundsMax.size() == entities.size());
+    mEntityCount = entities.size();
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        mPacked.min[axis].clear();
+        mPacked.max[axis].clear();
+    }
+    mPacked.entities.clear();
+
+    // bounds of the grid
+    std::array<float, 3> gridMax{};
+    mGridMin = {};
+    if (!entities.empty()) {
+        mGridMin = toArray(boundsMin[0]);
+        gridMax  = toArray(boundsMax[0]);
+    }
+    for (std::size_t i = 0; i < entities.size(); i++) {
+        const auto min = toArray(boundsMin[i]);
+        const auto max = toArray(boundsMax[i]);
+        for (std::size_t axis = 0; axis < 3; axis++) {
+            mGridMin[axis] = std::min(mGridMin[axis], min[axis]);
+            gridMax[axis]  = std::max(gridMax[axis], max[axis]);
+        }
+    }
+
+    // cubic cells holding kEntitiesPerCell boxes in average, a flat scene get a flat grid.
+    std::array<float, 3> size{};
+    float                volume = 1.0f;
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        size[axis] = std::max(gridMax[axis] - mGridMin[axis], 1e-3f);
+        volume *= size[axis];
+    }
+    const float targetCells =
+      std::max(static_cast<float>(entities.size() / kEntitiesPerCell), 1.0f);
+    const float cellSize = std::cbrt(volume / targetCells);
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        const float count = std::clamp(
+          std::ceil(size[axis] / cellSize), 1.0f, static_cast<float>(kMaxCellsPerAxis));
+        mCellCount[axis] = static_cast<std::uint32_t>(count);
+        mCellSize[axis]  = size[axis] / count;
+    }
+
+    // count the boxes of each cell, then place them (counting sort), the large boxes are
+    // in the slot after the last cell.
+    const std::uint32_t cellCount   = getCellCount();
+    const std::uint32_t largeSlot   = cellCount;
+    const auto          forEachCell = [&](std::size_t index, auto&& callback) {
+        std::array<std::uint32_t, 3> first{};
+        std::array<std::uint32_t, 3> last{};
+        const auto                   min          = toArray(boundsMin[index]);
+        const auto                   max          = toArray(boundsMax[index]);
+        std::uint32_t                overlapCount = 1;
+        for (std::size_t axis = 0; axis < 3; axis++) {
+            first[axis] = getCell(min[axis], mGridMin[axis], mCellSize[axis], mCellCount[axis]);
+            last[axis]  = getCell(max[axis], mGridMin[axis], mCellSize[axis], mCellCount[axis]);
+            overlapCount *= last[axis] - first[axis] + 1;
+        }
+        if (overlapCount > kMaxCellsPerEntity) {
+            callback(largeSlot);
+            return;
+        }
+        for (std::uint32_t z = first[2]; z <= last[2]; z++) {
+            for (std::uint32_t y = first[1]; y <= last[1]; y++) {
+                for (std::uint32_t x = first[0]; x <= last[0]; x++) {
+                    callback((z * mCellCount[1] + y) * mCellCount[0] + x);
+                }
+            }
+        }
+    };
+
+    mCellStart.assign(cellCount + 2, 0);
+    for (std::size_t i = 0; i < entities.size(); i++) {
+        forEachCell(i, [&](std::uint32_t cell) { mCellStart[cell + 1]++; });
+    }
+    for (std::size_t cell = 1; cell < mCellStart.size(); cell++) {
+        mCellStart[cell] += mCellStart[cell - 1];
+    }
+
+    const std::size_t entryCount = mCellStart.back();
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        mPacked.min[axis].resize(entryCount);
+        mPacked.max[axis].resize(entryCount);
+    }
+    mPacked.entities.resize(entryCount);
+    std::vector<std::uint32_t> cursors(mCellStart.begin(), mCellStart.end() - 1);
+    for (std::size_t i = 0; i < entities.size(); i++) {
+        const auto min = toArray(boundsMin[i]);
+        const auto max = toArray(boundsMax[i]);
+        forEachCell(i, [&](std::uint32_t cell) {
+            const std::uint32_t entry = cursors[cell]++;
+            for (std::size_t axis = 0; axis < 3; axis++) {
+                mPacked.min[axis][entry] = min[axis];
+                mPacked.max[axis][entry] = max[axis];
+            }
+            mPacked.entities[entry] = entities[i];
+        });
+    }
+}
+
+RaycastHit RaycastGrid::raycast(const Ray& ray, float maxDistance) const {
+    RaycastHit hit{.entity = entt::null, .distance = maxDistance};
+    if (mEntityCount == 0) {
+        return hit;
+    }
+
+    // a zero direction give a infinite inverse, the slabs of this axis are then
+    // [-inf, inf] if the origin is inside and empty otherwise.
+    const auto           origin    = toArray(ray.origin);
+    const auto           direction = toArray(ray.direction);
+    std::array<float, 3> invDirection{};
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        invDirection[axis] = 1.0f / direction[axis];
+    }
+
+    const std::uint32_t cellCount = getCellCount();
+    testRange(mCellStart[cellCount], mCellStart[cellCount + 1], origin, invDirection, hit);
+
+    // clip the ray to the grid
+    float enter = 0.0f;
+    float exit  = hit.distance;
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        const float gridMax =
+          mGridMin[axis] + mCellSize[axis] * static_cast<float>(mCellCount[axis]);
+        const float t0      = (mGridMin[axis] - origin[axis]) * invDirection[axis];
+        const float t1      = (gridMax - origin[axis]) * invDirection[axis];
+        enter               = std::max(enter, std::min(t0, t1));
+        exit                = std::min(exit, std::max(t0, t1));
+    }
+    if (!(enter <= exit)) {
+        return hit; // miss the grid, or NaN from a origin on a face with a zero direction
+    }
+
+    // walk the cells crossed by the ray, from the nearest (Amanatides & Woo).
+    std::array<std::uint32_t, 3> cell{};
+    std::array<float, 3>         nextBoundary{}; ///< Distance to the next cell on each axis.
+    std::array<float, 3>         cellDistance{}; ///< Distance to cross a cell on each axis.
+    std::array<int, 3>           step{};
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        const float position = origin[axis] + direction[axis] * enter;
+        cell[axis] = getCell(position, mGridMin[axis], mCellSize[axis], mCellCount[axis]);
+        // the boundary of the cell in the direction of the ray
+        const float cellMin = mGridMin[axis] + static_cast<float>(cell[axis]) * mCellSize[axis];
+        if (direction[axis] > 0.0f) {
+            step[axis]         = 1;
+            nextBoundary[axis] = (cellMin + mCellSize[axis] - origin[axis]) * invDirection[axis];
+            cellDistance[axis] = mCellSize[axis] * invDirection[axis];
+        } else if (direction[axis] < 0.0f) {
+            step[axis]         = -1;
+            nextBoundary[axis] = (cellMin - origin[axis]) * invDirection[axis];
+            cellDistance[axis] = -mCellSize[axis] * invDirection[axis];
+        } else {
+            nextBoundary[axis] = kInfinity;
+            cellDistance[axis] = kInfinity;
+        }
+    }
+
+    while (true) {
+        const std::uint32_t index = (cell[2] * mCellCount[1] + cell[1]) * mCellCount[0] + cell[0];
+        testRange(mCellStart[index], mCellStart[index + 1], origin, invDirection, hit);
+
+        // a box hit before the end of the cell can not be hidden by a box of the next cells
+        const auto axis = static_cast<std::size_t>(std::ranges::min_element(nextBoundary) -
+                                                   nextBoundary.begin());
+        const float cellExit = nextBoundary[axis];
+        if (hit.distance <= cellExit || cellExit > exit) {
+            break;
+        }
+        if ((step[axis] < 0 && cell[axis] == 0) ||
+            (step[axis] > 0 && cell[axis] + 1 == mCellCount[axis])) {
+            break;
+        }
+        cell[axis] = static_cast<std::uint32_t>(static_cast<int>(cell[axis]) + step[axis]);
+        nextBoundary[axis] += cellDistance[axis];
+    }
+    return hit;
+}
+
+void RaycastGrid::testRange(std::size_t                 begin,
+                            std::size_t                 end,
+                            const std::array<float, 3>& origin,
+                            const std::array<float, 3>& invDirection,
+                            RaycastHit&                 hit) const {
+    const float* minX = mPacked.min[0].data();
+    const float* minY = mPacked.min[1].data();
+    const float* minZ = mPacked.min[2].data();
+    const float* maxX = mPacked.max[0].data();
+    const float* maxY = mPacked.max[1].data();
+    const float* maxZ = mPacked.max[2].data();
+
+    std::array<float, kTestBlockSize> distances;
+    for (std::size_t block = begin; block < end; block += kTestBlockSize) {
+        const std::size_t count = std::min(kTestBlockSize, end - block);
+
+        // slab test, without branch so the loop is vectorized
+        for (std::size_t i = 0; i < count; i++) {
+            const std::size_t j    = block + i;
+            const float       tx0  = (minX[j] - origin[0]) * invDirection[0];
+            const float       tx1  = (maxX[j] - origin[0]) * invDirection[0];
+            const float       ty0  = (minY[j] - origin[1]) * invDirection[1];
+            const float       ty1  = (maxY[j] - origin[1]) * invDirection[1];
+            const float       tz0  = (minZ[j] - origin[2]) * invDirection[2];
+            const float       tz1  = (maxZ[j] - origin[2]) * invDirection[2];
+            const float       near = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)),
+                                              std::max(std::min(tz0, tz1), 0.0f));
+            const float       far  = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)),
+                                              std::max(tz0, tz1));
+            distances[i]           = near <= far ? near : kInfinity;
+        }
+
+        for (std::size_t i = 0; i < count; i++) {
+            if (distances[i] < hit.distance) {
+                hit = {.entity = mPacked.entities[block + i], .distance = distances[i]};
+            }
+        }
+    }
+}
+
+} // namespace fuse
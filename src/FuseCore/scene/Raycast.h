@@ -0,0 +1,112 @@
+#pragma once
+#include <FuseCore/math/Mat4.h>
+#include <FuseCore/math/Vec3.h>
+
+#include <entt/entity/entity.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace fuse {
+
+class Scene;
+
+/// @brief A half line.
+struct Ray {
+    Vec3 origin;    ///< Start of the ray.
+    Vec3 direction; ///< Normalized direction of the ray.
+};
+
+/// @brief Build the ray going through a point of the screen.
+/// @param invViewProj The inverse of the projection * view matrix of the camera.
+/// @param ndcX The horizontal position of the point in range [-1, 1], -1 is the left.
+/// @param ndcY The vertical position of the point in range [-1, 1], -1 is the bottom.
+/// @return The ray starting on the near plane, going away from the camera.
+[[nodiscard]] Ray computeRay(const Mat4& invViewProj, float ndcX, float ndcY) noexcept;
+
+/// @brief The nearest entity hit by a ray.
+struct RaycastHit {
+    entt::entity entity{entt::null};                               ///< The entity hit, or null.
+    float        distance{std::numeric_limits<float>::infinity()}; ///< Distance along the ray.
+
+    /// @brief Check if a entity was hit.
+    [[nodiscard]] bool isHit() const noexcept { return entity != entt::null; }
+};
+
+/// @brief Raycast the world bounds of many entities.
+///
+/// The bounding boxes are sorted in a uniform grid, each cell keep the boxes overlapping
+/// it packed in one array per coordinate, so the slab test of a cell is a loop without
+/// branch the compiler vectorize. A ray walk the cells it cross from the nearest (3D DDA)
+/// and stop at the first cell where a box is hit, only a few cells are tested.
+/// The boxes overlapping too many cells are kept out of the grid and tested by every ray.
+///
+/// The grid is built once (see Scene::raycast() which rebuild it when a entity move), then
+/// many rays can be tested, from several threads.
+class RaycastGrid {
+public:
+    static constexpr std::size_t   kEntitiesPerCell   = 8;  ///< Average size of a cell.
+    static constexpr std::uint32_t kMaxCellsPerAxis   = 64; ///< Resolution limit of the grid.
+    static constexpr std::uint32_t kMaxCellsPerEntity = 64; ///< Larger boxes are not in the grid.
+
+    /// @brief Build the grid from the world bounds of the meshes of a scene.
+    ///
+    /// The entities with a CMesh and a CTransform are added, with the bounds of their mesh.
+    /// @param scene The scene to raycast.
+    void build(const Scene& scene);
+
+    /// @brief Build the grid from a list of bounding boxes.
+    /// @param boundsMin The minimum corner of each box.
+    /// @param boundsMax The maximum corner of each box.
+    /// @param entities The entity of each box.
+    void build(std::span<const Vec3>         boundsMin,
+               std::span<const Vec3>         boundsMax,
+               std::span<const entt::entity> entities);
+
+    /// @brief Find the nearest box hit by a ray.
+    /// @param ray The ray, with a normalized direction.
+    /// @param maxDistance The boxes farther are ignored.
+    /// @return The nearest hit, the distance is zero when the origin is inside the box.
+    [[nodiscard]] RaycastHit raycast(
+      const Ray& ray, float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+    /// @brief Get the number of boxes in the grid.
+    [[nodiscard]] std::size_t getEntityCount() const noexcept { return mEntityCount; }
+
+    /// @brief Get the number of cells of the grid.
+    [[nodiscard]] std::uint32_t getCellCount() const noexcept {
+        return mCellCount[0] * mCellCount[1] * mCellCount[2];
+    }
+
+private:
+    /// @brief Test the boxes of a range of mPacked, keep the nearest hit.
+    void testRange(std::size_t                 begin,
+                   std::size_t                 end,
+                   const std::array<float, 3>& origin,
+                   const std::array<float, 3>& invDirection,
+                   RaycastHit&                 hit) const;
+
+    /// @brief Boxes of the cells, one array per coordinate.
+    struct PackedBounds {
+        std::array<std::vector<float>, 3> min;
+        std::array<std::vector<float>, 3> max;
+        std::vector<entt::entity>         entities;
+    };
+
+    PackedBounds                 mPacked;
+    std::vector<std::uint32_t>   mCellStart;   ///< First box of each cell, then the large boxes.
+    std::array<float, 3>         mGridMin{};   ///< Minimum corner of the grid.
+    std::array<float, 3>         mCellSize{};  ///< Size of a cell on each axis.
+    std::array<std::uint32_t, 3> mCellCount{}; ///< Number of cells on each axis.
+    std::size_t                  mEntityCount{};
+
+    std::vector<Vec3>         mBoundsMin; ///< World bounds extracted by build(const Scene&).
+    std::vector<Vec3>         mBoundsMax; ///< World bounds extracted by build(const Scene&).
+    std::vector<entt::entity> mEntities;  ///< Entities extracted by build(const Scene&).
+};
+
+} // namespace fuse
@@ -0,0 +1,282 @@
+#pragma once
+#include "UndoJournal.h"
+
+#include <FuseCore/math/Angle.h>
+#include <FuseCore/math/Vec3.h>
+#include <FuseCore/math/Vec4.h>
+#include <FuseCore/renderer/Mesh.h>
+#include <FuseCore/utils/GetTypeName.h>
+
+#include <entt/core/hashed_string.hpp>
+#include <entt/entity/registry.hpp>
+#include <entt/meta/factory.hpp>
+#include <entt/meta/meta.hpp>
+#include <entt/meta/resolve.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Type of the elements of a reflected field.
+enum class FieldType : std::uint8_t {
+    Bool,  ///< bool
+    UInt8, ///< std::uint8_t
+    Float, ///< float
+    Vec3,  ///< Vec3
+    Vec4,  ///< Vec4, displayed as a color by the editor.
+    Angle, ///< Angle, displayed in degrees by the editor.
+    Mesh,  ///< MeshHandle, a mesh of the MeshRegistry of the scene.
+};
+
+/// @brief Description of a member of a component.
+struct FieldInfo {
+    std::string_view name;     ///< Name of the member.
+    std::string_view typeName; ///< Name of the type of the member (see getTypeName()).
+    entt::id_type    id;       ///< Hash of the name, identify the field in the serialized data.
+    std::uint32_t    offset;   ///< Offset of the member in the component.
+    std::uint32_t    size;     ///< Size of the member, in bytes.
+    std::uint32_t    count;    ///< Number of elements, more than one for a std::array.
+    FieldType        type;     ///< Type of the elements.
+    float            min;      ///< Minimum value in the editor, no limit if min == max.
+    float            max;      ///< Maximum value in the editor.
+};
+
+/// @brief Description of a reflected component, built at compile time (see kComponentInfo).
+///
+/// The functions are instantiated for the type of the component, the generic code (the
+/// inspector, the serializer) call them once per component or once per storage and work
+/// on the fields with the table, it does not depend on the type of the components.
+struct ComponentInfo {
+    std::string_view           name;   ///< Name of the type, without namespace.
+    entt::id_type              id;     ///< Hash of the name, stable across builds.
+    std::uint32_t              size;   ///< Size of the component, 0 for a empty component.
+    std::span<const FieldInfo> fields; ///< The reflected members.
+
+    /// @brief Check if a entity has the component.
+    bool (*contains)(const entt::registry& registry, entt::entity entity);
+
+    /// @brief Get the component of a entity, nullptr for a empty component.
+    void* (*get)(entt::registry& registry, entt::entity entity);
+
+    /// @brief Remove the component of a entity.
+    void (*remove)(entt::registry& registry, entt::entity entity);
+
+    /// @brief Construct a default component in a buffer of `size` bytes.
+    void (*construct)(void* value);
+
+    /// @brief Record the change of the component of a entity (see UndoJournal::record()).
+    void (*record)(UndoJournal&  journal,
+                   entt::entity  entity,
+                   const void*   before,
+                   const void*   after,
+                   std::uint64_t mergeKey);
+
+    /// @brief Copy all the components of a registry, and their entities, at the end of buffers.
+    void (*gather)(const entt::registry&      registry,
+                   std::vector<entt::entity>& entities,
+                   std::vector<std::byte>&    values);
+
+    /// @brief Add or replace the components of entities, from a array of components.
+    void (*insert)(entt::registry&               registry,
+                   std::span<const entt::entity> entities,
+                   const std::byte*              values);
+};
+
+/// @brief Description of the type of a member, defined for the supported types only.
+template <class T>
+struct FieldTraits;
+
+/// @brief FieldTraits of a type stored as one element.
+template <FieldType Type>
+struct ScalarFieldTraits {
+    static constexpr FieldType     kType  = Type;
+    static constexpr std::uint32_t kCount = 1;
+};
+
+// clang-format off
+template <> struct FieldTraits<bool>         : ScalarFieldTraits<FieldType::Bool> {};
+template <> struct FieldTraits<std::uint8_t> : ScalarFieldTraits<FieldType::UInt8> {};
+template <> struct FieldTraits<float>        : ScalarFieldTraits<FieldType::Float> {};
+template <> struct FieldTraits<Vec3>         : ScalarFieldTraits<FieldType::Vec3> {};
+template <> struct FieldTraits<Vec4>         : ScalarFieldTraits<FieldType::Vec4> {};
+template <> struct FieldTraits<Angle>        : ScalarFieldTraits<FieldType::Angle> {};
+template <> struct FieldTraits<MeshHandle>   : ScalarFieldTraits<FieldType::Mesh> {};
+// clang-format on
+
+template <class T, std::size_t N>
+struct FieldTraits<std::array<T, N>> {
+    static constexpr FieldType     kType  = FieldTraits<T>::kType;
+    static constexpr std::uint32_t kCount = static_cast<std::uint32_t>(N);
+};
+
+/// @brief Describe a member of a component, see FUSE_FIELD().
+/// @tparam Member The type of the member.
+/// @param name The name of the member.
+/// @param offset The offset of the member in the component.
+/// @param min The minimum value in the editor.
+/// @param max The maximum value in the editor, no limit if equal to @p min.
+template <class Member>
+consteval FieldInfo makeFieldInfo(std::string_view name,
+                                  std::size_t      offset,
+                                  float            min = 0.0f,
+                                  float            max = 0.0f) {
+    return {.name     = name,
+            .typeName = getTypeName<Member>(),
+            .id       = entt::hashed_string::value(name.data(), name.size()),
+            .offset   = static_cast<std::uint32_t>(offset),
+            .size     = static_cast<std::uint32_t>(sizeof(Member)),
+            .count    = FieldTraits<Member>::kCount,
+            .type     = FieldTraits<Member>::kType,
+            .min      = min,
+            .max      = max};
+}
+
+/// @brief Make the table of the fields of a component.
+template <class... Fields>
+consteval std::array<FieldInfo, sizeof...(Fields)> makeFieldTable(Fields... fields) {
+    return {fields...};
+}
+
+/// @brief Remove the namespaces (and the class/struct keyword of MSVC) of a type name.
+consteval std::string_view getShortTypeName(std::string_view name) {
+    const auto start = name.find_last_of(": ");
+    return start == std::string_view::npos ? name : name.substr(start + 1);
+}
+
+/// @brief Reflected members of a component, specialized by FUSE_REFLECT_COMPONENT().
+template <class Component>
+struct ComponentReflection;
+
+/// @brief A component described with FUSE_REFLECT_COMPONENT().
+template <class Component>
+concept ReflectedComponent = requires { ComponentReflection<Component>::kFields; };
+
+/// @brief Build the description of a reflected component.
+template <ReflectedComponent Component>
+consteval ComponentInfo makeComponentInfo() {
+    static_assert(std::is_trivially_copyable_v<Component>,
+                  "The reflected components are copied as bytes.");
+    constexpr bool             kIsEmpty = std::is_empty_v<Component>;
+    constexpr std::string_view kName    = getShortTypeName(getTypeName<Component>());
+
+    ComponentInfo info{};
+    info.name     = kName;
+    info.id       = entt::hashed_string::value(kName.data(), kName.size());
+    info.size     = kIsEmpty ? 0 : static_cast<std::uint32_t>(sizeof(Component));
+    info.fields   = ComponentReflection<Component>::kFields;
+    info.contains = [](const entt::registry& registry, entt::entity entity) {
+        return registry.all_of<Component>(entity);
+    };
+    info.get = [](entt::registry& registry, entt::entity entity) -> void* {
+        if constexpr (kIsEmpty) {
+            return nullptr;
+        } else {
+            return &registry.get<Component>(entity);
+        }
+    };
+    info.remove = [](entt::registry& registry, entt::entity entity) {
+        registry.remove<Component>(entity);
+    };
+    info.construct = [](void* value) { std::construct_at(static_cast<Component*>(value)); };
+    if constexpr (!kIsEmpty) {
+        info.record = [](UndoJournal&  journal,
+                         entt::entity  entity,
+                         const void*   before,
+                         const void*   after,
+                         std::uint64_t mergeKey) {
+            journal.record(entity,
+                           *static_cast<const Component*>(before),
+                           *static_cast<const Component*>(after),
+                           mergeKey);
+        };
+    }
+    info.gather = [](const entt::registry&      registry,
+                     std::vector<entt::entity>& entities,
+                     std::vector<std::byte>&    values) {
+        const auto view = registry.view<const Component>();
+        entities.reserve(entities.size() + view.size());
+        if constexpr (kIsEmpty) {
+            entities.insert(entities.end(), view.begin(), view.end());
+        } else {
+            std::size_t offset = values.size();
+            values.resize(offset + view.size() * sizeof(Component));
+            for (auto [entity, component] : view.each()) {
+                entities.push_back(entity);
+                std::memcpy(values.data() + offset, &component, sizeof(Component));
+                offset += sizeof(Component);
+            }
+        }
+    };
+    info.insert = [](entt::registry&               registry,
+                     std::span<const entt::entity> entities,
+                     const std::byte*              values) {
+        for (const entt::entity entity : entities) {
+            if constexpr (kIsEmpty) {
+                registry.emplace_or_replace<Component>(entity);
+            } else {
+                Component component;
+                std::memcpy(&component, values, sizeof(Component));
+                registry.emplace_or_replace<Component>(entity, component);
+                values += sizeof(Component);
+            }
+        }
+    };
+    return info;
+}
+
+/// @brief Description of a reflected component.
+template <ReflectedComponent Component>
+inline constexpr ComponentInfo kComponentInfo = makeComponentInfo<Component>();
+
+/// @brief Register a reflected component into entt::meta.
+///
+/// The meta type is identified by ComponentInfo::id and hold a pointer to kComponentInfo as
+/// custom data, see findComponentInfo().
+template <ReflectedComponent Component>
+void registerComponentMeta() {
+    const ComponentInfo* info = &kComponentInfo<Component>;
+    entt::meta_factory<Component>{}.type(info->id).template custom<const ComponentInfo*>(info);
+}
+
+/// @brief Find the description of a component registered with registerComponentMeta().
+/// @param id The id of the component (ComponentInfo::id).
+/// @return The description or nullptr if the component is not registered.
+[[nodiscard]] inline const ComponentInfo* findComponentInfo(entt::id_type id) {
+    const entt::meta_type type = entt::resolve(id);
+    if (!type) {
+        return nullptr;
+    }
+    const auto* info = static_cast<const ComponentInfo* const*>(type.custom());
+    return info ? *info : nullptr;
+}
+
+} // namespace fuse
+
+/// @brief Describe a member of the component for FUSE_REFLECT_COMPONENT().
+#define FUSE_FIELD(member) \
+    fuse::makeFieldInfo<decltype(Type::member)>(#member, offsetof(Type, member))
+
+/// @brief Describe a member of the component, with the range of values of the editor.
+#define FUSE_FIELD_RANGE(member, min, max) \
+    fuse::makeFieldInfo<decltype(Type::member)>(#member, offsetof(Type, member), min, max)
+
+/// @brief Reflect the members of a component, at global scope.
+///
+/// @code
+/// FUSE_REFLECT_COMPONENT(fuse::CRotator, FUSE_FIELD(angle), FUSE_FIELD(axis));
+/// FUSE_REFLECT_COMPONENT(fuse::CStatic); // a empty component
+/// @endcode
+#define FUSE_REFLECT_COMPONENT(Component, ...)                                    \
+    template <>                                                                   \
+    struct fuse::ComponentReflection<Component> {                                 \
+        using Type                    = Component;                                \
+        static constexpr auto kFields = fuse::makeFieldTable(__VA_ARGS__);        \
+    }
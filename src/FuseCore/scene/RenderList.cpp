@@ -0,0 +1,155 @@
+#include "RenderList.h"
+
+#include "Lod.h"
+#include "Scene.h"
+#include "StaticBatcher.h"
+#include "TransformInterpolation.h"
+
+#include <FuseCore/renderer/RenderQueue.h>
+#include <FuseCore/utils/WorkerPool.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/// @brief Minimum number of meshes extracted by a thread, under it a thread cost more than it save.
+constexpr std::size_t kMinMeshesPerThread = 4096;
+
+/// @brief Range of the CMesh storage extracted by a thread.
+struct ExtractRange {
+    std::size_t begin;  ///< First index in the CMesh storage.
+    std::size_t end;    ///< Last index (excluded) in the CMesh storage.
+    std::size_t offset; ///< First index in the render list.
+};
+
+/// @brief Storages read by the extraction.
+struct ExtractStorages {
+    const entt::storage_for_t<fuse::CMesh>*              meshes;
+    const entt::storage_for_t<fuse::CTransform>*         transforms;
+    const entt::storage_for_t<fuse::CPreviousTransform>* previousTransforms;
+    const entt::storage_for_t<fuse::CLod>*               lods;
+    const entt::storage_for_t<fuse::CStatic>*            statics; ///< Null to extract them.
+};
+
+/// @brief Check if a entity of the CMesh storage must be extracted.
+bool isExtracted(const ExtractStorages& storages, entt::entity entity) {
+    if (!storages.transforms->contains(entity)) {
+        return false;
+    }
+    return storages.statics == nullptr || !storages.statics->contains(entity) ||
+           !fuse::isStaticBatched(storages.meshes->get(entity));
+}
+
+/// @brief Count the meshes of a range which have a transform.
+std::size_t countRange(const ExtractStorages& storages, std::size_t begin, std::size_t end) {
+    const auto* entities = storages.meshes->data();
+    return static_cast<std::size_t>(
+      std::count_if(entities + begin, entities + end, [&](entt::entity entity) {
+          return isExtracted(storages, entity);
+      }));
+}
+
+void extractRange(const ExtractStorages& storages,
+                  const ExtractRange&    range,
+                  float                  interpolationAlpha,
+                  fuse::RenderList&      renderList) {
+    const auto* entities = storages.meshes->data();
+    std::size_t index    = range.offset;
+    for (std::size_t i = range.begin; i < range.end; i++) {
+        const auto entity = entities[i];
+        if (!isExtracted(storages, entity)) {
+            continue;
+        }
+
+        const auto& transform = storages.transforms->get(entity);
+        const auto& mesh      = storages.meshes->get(entity);
+        const auto* lod       = storages.lods != nullptr && storages.lods->contains(entity)
+                                  ? &storages.lods->get(entity)
+                                  : nullptr;
+        const auto  drawnMesh = lod != nullptr ? fuse::getLodMesh(mesh, *lod) : mesh.mesh;
+
+        const bool interpolate = interpolationAlpha < 1.0f &&
+                                 storages.previousTransforms != nullptr &&
+                                 storages.previousTransforms->contains(entity);
+
+        if (interpolate) {
+            const auto& previous = storages.previousTransforms->get(entity).transform;
+            renderList.worldMatrices[index] = fuse::computeWorldMatrix(
+              fuse::interpolateTransform(previous, transform, interpolationAlpha));
+        } else {
+            renderList.worldMatrices[index] = fuse::computeWorldMatrix(transform);
+        }
+        const auto pass = mesh.color.w < 1.0f ? fuse::RenderPass::Transparent
+                                              : fuse::RenderPass::Opaque;
+        renderList.colors[index]    = mesh.color;
+        renderList.meshIds[index]   = drawnMesh.id;
+        renderList.sortKeys[index]  = fuse::SortKey::Make(pass, 0, 0, renderList.meshIds[index]);
+        renderList.occluders[index] = mesh.occluder ? 1 : 0;
+        renderList.entityIds[index] = fuse::toPickId(entity);
+        index++;
+    }
+}
+
+} // namespace
+
+namespace fuse {
+
+Mat4 computeWorldMatrix(const CTransform& transform) noexcept {
+    const auto translationMat = Mat4::CreateTranslation(transform.translation);
+    const auto scaleMat       = Mat4::CreateScaling(transform.scale);
+    const auto rotationMat    = Mat4::CreateRotationX(degrees(transform.rotation.x)) *
+                             Mat4::CreateRotationY(degrees(transform.rotation.y)) *
+                             Mat4::CreateRotationZ(degrees(transform.rotation.z));
+    return translationMat * rotationMat * scaleMat;
+}
+
+void extractRenderList(const Scene& scene,
+                       float        interpolationAlpha,
+                       RenderList&  renderList,
+                       WorkerPool*  workers,
+                       bool         skipStatic) {
+    const auto&           registry = scene.getRegistry();
+    const auto*           statics  = skipStatic ? registry.storage<CStatic>() : nullptr;
+    const ExtractStorages storages{.meshes             = registry.storage<CMesh>(),
+                                   .transforms         = registry.storage<CTransform>(),
+                                   .previousTransforms = registry.storage<CPreviousTransform>(),
+                                   .lods               = registry.storage<CLod>(),
+                                   .statics            = statics};
+    if (storages.meshes == nullptr || storages.transforms == nullptr) {
+        renderList.clear();
+        return;
+    }
+
+    const std::size_t meshCount   = storages.meshes->size();
+    const unsigned    threadCount = workers != nullptr ? workers->getThreadCount() : 1;
+    const std::size_t chunkCount =
+      std::clamp<std::size_t>(meshCount / kMinMeshesPerThread, 1, threadCount);
+    const auto getRange = [&](std::size_t chunk) {
+        return ExtractRange{.begin  = meshCount * chunk / chunkCount,
+                            .end    = meshCount * (chunk + 1) / chunkCount,
+                            .offset = renderList.chunkOffsets[chunk]};
+    };
+
+    // split the storage in chunks, count the entries of each chunk to know where
+    // each chunk write in the list, then fill the chunks in parallel.
+    renderList.chunkOffsets.resize(chunkCount);
+    std::size_t entryCount = 0;
+    for (std::size_t chunk = 0; chunk < chunkCount; chunk++) {
+        renderList.chunkOffsets[chunk] = entryCount;
+        const ExtractRange range       = getRange(chunk);
+        entryCount += countRange(storages, range.begin, range.end);
+    }
+    renderList.resize(entryCount);
+
+    const auto extractChunk = [&](std::size_t chunk) {
+        extractRange(storages, getRange(chunk), interpolationAlpha, renderList);
+    };
+    if (workers != nullptr) {
+        workers->run(chunkCount, extractChunk);
+    } else {
+        extractChunk(0);
+    }
+}
+
+} // namespace fuse
@@ -0,0 +1,125 @@
+#pragma once
+#include "Components.h"
+
+#include <FuseCore/math/Mat4.h>
+#include <FuseCore/math/Vec4.h>
+
+#include <entt/entity/entity.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fuse {
+
+class Scene;
+class WorkerPool;
+
+/// @brief Get the id of a entity written in a picking buffer.
+///
+/// The renderer write the id of the entity drawn in each pixel, the background is cleared
+/// to zero, so the ids are offset by one.
+[[nodiscard]] constexpr std::uint32_t toPickId(entt::entity entity) noexcept {
+    return entt::to_integral(entity) + 1;
+}
+
+/// @brief Get the entity of a id read from a picking buffer (see toPickId()).
+/// @return The entity, or entt::null for the background.
+[[nodiscard]] constexpr entt::entity fromPickId(std::uint32_t pickId) noexcept {
+    return pickId == 0 ? entt::entity{entt::null} : entt::entity{pickId - 1};
+}
+
+/// @brief Flat list of what must be drawn for a frame, extracted from a scene.
+///
+/// The data are packed in parallel arrays (one entry per drawn mesh) so the renderer
+/// does not need to access the registry, and the simulation can update the scene
+/// while a previous list is drawn.
+/// The arrays keep their capacity when the list is cleared or refilled, so a list reused
+/// every frame does not allocate once the scene size is stable.
+struct RenderList {
+    std::vector<Mat4>          worldMatrices; ///< World matrix of each mesh.
+    std::vector<Vec4>          colors;        ///< Color of each mesh.
+    std::vector<std::uint32_t> meshIds;       ///< Mesh of each entry.
+    std::vector<std::uint64_t> sortKeys;      ///< Sort key of each entry, without the depth.
+    std::vector<std::uint8_t>  occluders;     ///< 1 if the entry is a occluder, 0 otherwise.
+    std::vector<std::uint32_t> entityIds;     ///< Entity of each entry, see toPickId().
+    std::vector<std::size_t>   chunkOffsets;  ///< Scratch of extractRenderList(), not a entry.
+
+    /// @brief Get the number of meshes to draw.
+    [[nodiscard]] std::size_t size() const noexcept { return worldMatrices.size(); }
+
+    /// @brief Check if there is nothing to draw.
+    [[nodiscard]] bool isEmpty() const noexcept { return worldMatrices.empty(); }
+
+    /// @brief Change the number of entries, keep the capacity.
+    void resize(std::size_t size) {
+        worldMatrices.resize(size);
+        colors.resize(size);
+        meshIds.resize(size);
+        sortKeys.resize(size);
+        occluders.resize(size);
+        entityIds.resize(size);
+    }
+
+    /// @brief Remove all the entries, keep the capacity.
+    void clear() noexcept {
+        worldMatrices.clear();
+        colors.clear();
+        meshIds.clear();
+        sortKeys.clear();
+        occluders.clear();
+        entityIds.clear();
+    }
+
+    /// @brief Remove the entries not flagged in @p keep, the others keep their order.
+    /// @param keep 1 to keep the entry, 0 to remove it. One value per entry.
+    /// @return The number of entries removed.
+    std::size_t compact(std::span<const std::uint8_t> keep) {
+        assert(keep.size() == size());
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < keep.size(); i++) {
+            if (keep[i] == 0) {
+                continue;
+            }
+            if (count != i) {
+                worldMatrices[count] = worldMatrices[i];
+                colors[count]        = colors[i];
+                meshIds[count]       = meshIds[i];
+                sortKeys[count]      = sortKeys[i];
+                occluders[count]     = occluders[i];
+                entityIds[count]     = entityIds[i];
+            }
+            count++;
+        }
+        const std::size_t removed = size() - count;
+        resize(count);
+        return removed;
+    }
+};
+
+/// @brief Compute the world matrix of a transform (translation * rotation * scale).
+/// @param transform The transform.
+[[nodiscard]] Mat4 computeWorldMatrix(const CTransform& transform) noexcept;
+
+/// @brief Extract the meshes of a scene into a render list.
+///
+/// The previous content of the list is replaced. The entries follow the order of the
+/// CMesh storage, whatever the number of threads used. The entities with a CLod use the
+/// mesh of their current level (see selectLods()).
+/// The scene is only read, it must not be modified during the extraction.
+///
+/// @param scene The scene to extract.
+/// @param interpolationAlpha Interpolation factor between the previous and the current
+///                           transform of the entities (see interpolateTransform()).
+/// @param renderList The list to fill.
+/// @param workers The threads used to extract the list, or nullptr to extract it on the
+///                calling thread. Small scenes are always extracted on the calling thread.
+/// @param skipStatic Skip the static entities drawn from static batches (see StaticBatcher).
+void extractRenderList(const Scene& scene,
+                       float        interpolationAlpha,
+                       RenderList&  renderList,
+                       WorkerPool*  workers    = nullptr,
+                       bool         skipStatic = false);
+
+} // namespace fuse
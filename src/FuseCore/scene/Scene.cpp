@@ -1,13 +1,105 @@
 #include "Scene.h"
 
+#include "ComponentReflection.h"
 #include "Components.h"
 
 #include <algorithm>
-#include <format>
+#include <array>
+#include <bit>
+
+namespace {
+
+/// @brief Counter of the changes of the static entities, stored in the registry context
+///        so the signals stay valid when the scene is moved.
+struct StaticVersion {
+    std::uint64_t value{};
+};
+
+void onStaticChanged(entt::registry& registry, entt::entity /*entity*/) {
+    registry.ctx().get<StaticVersion>().value++;
+}
+
+void onStaticComponentChanged(entt::registry& registry, entt::entity entity) {
+    if (registry.all_of<fuse::CStatic>(entity)) {
+        registry.ctx().get<StaticVersion>().value++;
+    }
+}
+
+/// @brief Counter of the changes of the transforms and meshes, see StaticVersion.
+struct TransformVersion {
+    std::uint64_t value{};
+};
+
+void onTransformChanged(entt::registry& registry, entt::entity /*entity*/) {
+    registry.ctx().get<TransformVersion>().value++;
+}
+
+/// @brief Counter of the changes of the names, see StaticVersion.
+struct NameVersion {
+    std::uint64_t value{};
+};
+
+void onNameChanged(entt::registry& registry, entt::entity /*entity*/) {
+    registry.ctx().get<NameVersion>().value++;
+}
+
+template <class Type>
+void connectTransformComponent(entt::registry& registry) {
+    registry.on_construct<Type>().template connect<&onTransformChanged>();
+    registry.on_update<Type>().template connect<&onTransformChanged>();
+    registry.on_destroy<Type>().template connect<&onTransformChanged>();
+}
+
+template <class Type>
+void connectStaticComponent(entt::registry& registry) {
+    registry.on_construct<Type>().template connect<&onStaticComponentChanged>();
+    registry.on_update<Type>().template connect<&onStaticComponentChanged>();
+    registry.on_destroy<Type>().template connect<&onStaticComponentChanged>();
+}
+
+} // namespace
 
 namespace fuse {
 
-Scene::Scene() { mRegistry.ctx().emplace<Scene&>(*this); }
+Scene::Scene()
+    : mSignatureIndex(std::make_unique<SignatureIndex>())
+    , mUUIDIndex(std::make_unique<UUIDIndex>())
+    , mNameIndex(std::make_unique<NameIndex>()) {
+    mRegistry.ctx().emplace<Scene&>(*this);
+    mRegistry.ctx().emplace<SignatureIndex&>(*mSignatureIndex);
+    mUUIDIndex->connect(mRegistry);
+    mNameIndex->connect(mRegistry);
+
+    mRegistry.ctx().emplace<StaticVersion>();
+    mRegistry.on_construct<CStatic>().connect<&onStaticChanged>();
+    mRegistry.on_destroy<CStatic>().connect<&onStaticChanged>();
+    connectStaticComponent<CTransform>(mRegistry);
+    connectStaticComponent<CMesh>(mRegistry);
+
+    mRegistry.ctx().emplace<TransformVersion>();
+    connectTransformComponent<CTransform>(mRegistry);
+    connectTransformComponent<CMesh>(mRegistry);
+
+    mRegistry.ctx().emplace<NameVersion>();
+    mRegistry.on_construct<NameComponent>().connect<&onNameChanged>();
+    mRegistry.on_update<NameComponent>().connect<&onNameChanged>();
+    mRegistry.on_destroy<NameComponent>().connect<&onNameChanged>();
+
+    // engine components
+    registerComponent<NameComponent>();
+    registerComponent<IDComponent>();
+    registerComponent<CTransform>();
+    registerComponent<CPreviousTransform>();
+    registerComponent<CRotator>();
+    registerComponent<CTranslator>();
+    registerComponent<CMesh>();
+    registerComponent<CLod>();
+    registerComponent<CStatic>();
+    registerComponent<CSelected>();
+
+    // the reflected components are found by id when loading a scene (see SceneSerializer)
+    registerReflectedComponents();
+}
 
 Scene& Scene::getRegistryAsScene(const entt::registry& registry) {
     const auto* scene = registry.ctx().find<Scene>();
@@ -15,45 +107,136 @@ Scene& Scene::getRegistryAsScene(const entt::registry& registry) {
     return const_cast<Scene&>(*scene);
 }
 
-Entity Scene::createEntity(std::string name) {
+Entity Scene::createEntity(std::string_view name) {
     entt::handle handle = {mRegistry, mRegistry.create()};
 
-    if (name.empty()) {
-        name = std::format("Entity ({})", getEntityCount());
-    }
-
-    handle.emplace<NameComponent>(std::move(name));
+    // An empty name give an invalid id, the default name will be generated on demand.
+    handle.emplace<NameComponent>(mStringInterner.intern(name));
     handle.emplace<IDComponent>();
 
     return handle;
 }
 
+Entity Scene::createEntity(std::string_view name, UUID uuid) {
+    assert(mUUIDIndex->find(uuid) == entt::null && "The UUID is already used by a entity.");
+    entt::handle handle = {mRegistry, mRegistry.create()};
+    handle.emplace<NameComponent>(mStringInterner.intern(name));
+    handle.emplace<IDComponent>(uuid);
+    return handle;
+}
+
+std::string_view Scene::getEntityName(const Entity& entity) {
+    if (!entity) {
+        return {};
+    }
+
+    auto* nameComponent = mRegistry.try_get<NameComponent>(entity.mEntity);
+    if (!nameComponent) {
+        return {};
+    }
+
+    if (!nameComponent->name.isValid()) {
+        std::array<char, 32> buffer;
+        nameComponent->name =
+          mStringInterner.intern(NameIndex::FormatDefaultName(entity.mEntity.entity(), buffer));
+    }
+
+    return mStringInterner.resolve(nameComponent->name);
+}
+
+void Scene::setEntityName(const Entity& entity, std::string_view name) {
+    assert(entity && "Entity is invalid.");
+    mRegistry.emplace_or_replace<NameComponent>(entity.mEntity, mStringInterner.intern(name));
+}
+
+void Scene::findEntitiesByName(std::string_view text, std::vector<entt::entity>& entities) {
+    mNameIndex->search(mStringInterner, text, entities);
+}
+
+std::uint64_t Scene::getNameVersion() const noexcept {
+    return mRegistry.ctx().get<NameVersion>().value;
+}
+
+std::uint64_t Scene::getStaticVersion() const noexcept {
+    return mRegistry.ctx().get<StaticVersion>().value;
+}
+
+void Scene::markStaticChanged() noexcept { mRegistry.ctx().get<StaticVersion>().value++; }
+
+std::uint64_t Scene::getTransformVersion() const noexcept {
+    return mRegistry.ctx().get<TransformVersion>().value;
+}
+
+void Scene::markTransformsChanged() noexcept {
+    mRegistry.ctx().get<TransformVersion>().value++;
+}
+
+RaycastHit Scene::raycast(const Vec3& origin, const Vec3& direction, float maxDistance) {
+    if (mRaycastVersion != getTransformVersion()) {
+        mRaycastGrid.build(*this);
+        mRaycastVersion = getTransformVersion();
+    }
+    return mRaycastGrid.raycast({.origin = origin, .direction = direction.normalized()},
+                                maxDistance);
+}
+
+Entity Scene::findEntity(UUID uuid) noexcept {
+    const auto entity = mUUIDIndex->find(uuid);
+    if (entity == entt::null) {
+        return {};
+    }
+    return {entity, mRegistry};
+}
+
 void Scene::destroyEntity(Entity& entity) noexcept {
     mRegistry.destroy(entity.mEntity);
     entity = {};
 }
 
+void Scene::destroyEntities(std::span<const entt::entity> entities) noexcept {
+    mRegistry.destroy(entities.begin(), entities.end());
+}
+
 bool Scene::isEmpty() const noexcept { return mRegistry.storage<entt::entity>()->free_list() == 0; }
 
 std::size_t Scene::getEntityCount() const noexcept {
     return mRegistry.storage<entt::entity>()->free_list();
 }
 
-void Scene::clear() noexcept { mRegistry.clear(); }
+void Scene::clear() noexcept {
+    mRegistry.clear();
+    mStringInterner.clear();
+}
+
+ComponentSignature Scene::getEntitySignature(const Entity& entity) const noexcept {
+    assert(isSignatureIndexComplete() && "A component type is not registered.");
+    return mSignatureIndex->getSignature(entity.mEntity);
+}
 
 std::size_t Scene::getEntityComponentCount(const Entity& entity) const noexcept {
-    std::size_t nbComponent = 0;
-    for (const auto [id, storage] : mRegistry.storage()) {
-        if (storage.contains(entity.mEntity)) {
-            nbComponent++;
-        }
-    }
-    return nbComponent;
+    std::size_t count = mSignatureIndex->getSignature(entity.mEntity).count();
+    forEachUntrackedStorage([&](entt::id_type /*storageId*/, const auto& storage) {
+        count += storage.contains(entity.mEntity) ? 1 : 0;
+    });
+    return count;
 }
 
 bool Scene::hasSameComponentType(const Entity& entity1, const Entity& entity2) const noexcept {
-    return std::ranges::all_of(mRegistry.storage(), [&entity1, &entity2](const auto& it) {
-        return it.second.contains(entity1.mEntity) == it.second.contains(entity2.mEntity);
+    if (mSignatureIndex->getSignature(entity1.mEntity) !=
+        mSignatureIndex->getSignature(entity2.mEntity)) {
+        return false;
+    }
+    bool isSame = true;
+    forEachUntrackedStorage([&](entt::id_type /*storageId*/, const auto& storage) {
+        isSame = isSame && storage.contains(entity1.mEntity) == storage.contains(entity2.mEntity);
+    });
+    return isSame;
+}
+
+bool Scene::isSignatureIndexComplete() const noexcept {
+    // empty storages (e.g. created by a view) don't change the signatures.
+    return std::ranges::all_of(mRegistry.storage(), [this](const auto& it) {
+        return it.second.empty() || mSignatureIndex->isRegistered(it.first);
     });
 }
 
@@ -65,25 +248,89 @@ Entity Scene::duplicateEntity(const Entity& entity) {
 
     entt::handle newEntity = {mRegistry, mRegistry.create()};
 
-    for (const auto [id, storage] : mRegistry.storage()) {
-        // only copy component if the source entity contains this component.
-        if (storage.contains(entity.mEntity)) {
-            // Calling storage.push() with data will call the copy constructor.
-            // Without data, it will call the default constructor.
-            // For the IDComponent, we don't want to copy the ID and end up with 2 entity with the same id.
-            if (id == entt::type_hash<IDComponent>()) {
-                [[maybe_unused]] const auto it = storage.push(newEntity);
-                assert(it != storage.end());
-            } else {
-                // this will call copy constructor if available,
-                const void*                 componentData = storage.value(entity.mEntity);
-                [[maybe_unused]] const auto it            = storage.push(newEntity, componentData);
-                assert(it != storage.end());
-            }
+    const auto copyComponent = [&](entt::id_type storageId) {
+        auto* storage = mRegistry.storage(storageId);
+        assert(storage && storage->contains(entity.mEntity));
+
+        // The copy is not selected.
+        if (storageId == entt::type_hash<CSelected>()) {
+            return;
+        }
+
+        // Calling storage.push() with data will call the copy constructor.
+        // Without data, it will call the default constructor.
+        // For the IDComponent, we don't want to copy the ID and end up with 2 entity with
+        // the same id.
+        if (storageId == entt::type_hash<IDComponent>()) {
+            [[maybe_unused]] const auto it = storage->push(newEntity);
+            assert(it != storage->end());
+        } else {
+            // this will call copy constructor if available,
+            const void*                 componentData = storage->value(entity.mEntity);
+            [[maybe_unused]] const auto it            = storage->push(newEntity, componentData);
+            assert(it != storage->end());
         }
+    };
+
+    // only visit the storages of the components owned by the source entity.
+    auto bits = mSignatureIndex->getSignature(entity.mEntity).to_ullong();
+    while (bits != 0) {
+        const auto bit = static_cast<std::size_t>(std::countr_zero(bits));
+        bits &= bits - 1;
+        copyComponent(mSignatureIndex->getStorageId(bit));
     }
+    forEachUntrackedStorage([&](entt::id_type storageId, const auto& storage) {
+        if (storage.contains(entity.mEntity)) {
+            copyComponent(storageId);
+        }
+    });
 
     return newEntity;
 }
 
+void Scene::instantiate(const Entity& prototype, std::span<entt::entity> entities) {
+    assert(prototype && "Prototype entity is invalid.");
+    if (!prototype || entities.empty()) {
+        return;
+    }
+
+    auto& entityStorage = mRegistry.storage<entt::entity>();
+    entityStorage.reserve(entityStorage.size() + entities.size());
+    mRegistry.create(entities.begin(), entities.end());
+
+    const auto copyComponent = [&](entt::id_type storageId) {
+        auto* storage = mRegistry.storage(storageId);
+        assert(storage && storage->contains(prototype.mEntity));
+        if (storageId == entt::type_hash<CSelected>()) {
+            return;
+        }
+
+        storage->reserve(storage->size() + entities.size());
+        if (storageId == entt::type_hash<IDComponent>()) {
+            // default construct to get a new id for each entity.
+            storage->push(entities.begin(), entities.end());
+        } else {
+            // Components are stored in pages, the address of the prototype component
+            // stay valid while the storage grow.
+            const void* componentData = storage->value(prototype.mEntity);
+            for (const auto entity : entities) {
+                [[maybe_unused]] const auto it = storage->push(entity, componentData);
+                assert(it != storage->end());
+            }
+        }
+    };
+
+    auto bits = mSignatureIndex->getSignature(prototype.mEntity).to_ullong();
+    while (bits != 0) {
+        const auto bit = static_cast<std::size_t>(std::countr_zero(bits));
+        bits &= bits - 1;
+        copyComponent(mSignatureIndex->getStorageId(bit));
+    }
+    forEachUntrackedStorage([&](entt::id_type storageId, const auto& storage) {
+        if (storage.contains(prototype.mEntity)) {
+            copyComponent(storageId);
+        }
+    });
+}
+
 } // namespace fuse
@@ -1,10 +1,24 @@
 #pragma once
+#include "Components.h"
 #include "Entity.h"
+#include "NameIndex.h"
+#include "Raycast.h"
+#include "SignatureIndex.h"
+#include "UUIDIndex.h"
+
+#include <FuseCore/renderer/MeshRegistry.h>
+#include <FuseCore/utils/StringInterner.h>
 
 #include <entt/entity/handle.hpp>
 #include <entt/entity/registry.hpp>
 
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace fuse {
 
@@ -30,19 +44,136 @@ public:
     Scene& operator=(Scene&&) = default;
 
     /// @brief Create a new entity.
+    ///
+    /// If no name is given, a default name is generated the first time
+    /// getEntityName() is called, so creating entity does not allocate memory per entity.
+    ///
+    /// @param name The name of the entity.
+    /// @return The new created entity.
+    Entity createEntity(std::string_view name = {});
+
+    /// @brief Create a new entity with a given UUID (e.g. when loading a scene).
     /// @param name The name of the entity.
+    /// @param uuid The UUID of the entity, it should not be used by another entity.
     /// @return The new created entity.
-    Entity createEntity(std::string name = {});
+    Entity createEntity(std::string_view name, UUID uuid);
+
+    /// @brief Create many entities at once.
+    ///
+    /// The storages are reserved up front and the components are inserted with one call
+    /// per component type, which is much faster than calling createEntity() in a loop.
+    /// Entities are created without name, see createEntity().
+    ///
+    /// @tparam Components Types of the components to add to each entity.
+    /// @param entities    Receive the created entities. One entity is created per element.
+    /// @param components  The value used to initialize the components of every entity.
+    template <class... Components>
+    void createEntities(std::span<entt::entity> entities, const Components&... components);
 
     /// @brief Delete a entity and it component from the scene.
     /// @param entity The entity to delete.
     void destroyEntity(Entity& entity) noexcept;
 
+    /// @brief Delete many entities and there components from the scene.
+    /// @param entities The entities to delete. All entities must be valid.
+    void destroyEntities(std::span<const entt::entity> entities) noexcept;
+
     /// @brief Duplicate (clone) a entity with it's comopenent.
     /// @param entity The entity to clone.
     /// @return The new entity.
     Entity duplicateEntity(const Entity& entity);
 
+    /// @brief Clone a prototype entity many times.
+    ///
+    /// Each component storage of the prototype is visited once and all the copies are
+    /// pushed in a row. As for duplicateEntity(), the IDComponent is not copied.
+    ///
+    /// @param prototype The entity to clone.
+    /// @param entities  Receive the new entities. One clone is created per element.
+    void instantiate(const Entity& prototype, std::span<entt::entity> entities);
+
+    /// @brief Get the name of a entity.
+    ///
+    /// If the entity doesn't have a name yet, a default name is generated and interned.
+    ///
+    /// @param entity The entity to query the name.
+    /// @return The name of the entity (null-terminated) or an empty string if the entity
+    ///         doesn't have a NameComponent.
+    [[nodiscard]] std::string_view getEntityName(const Entity& entity);
+
+    /// @brief Set the name of a entity.
+    /// @param entity The entity to rename.
+    /// @param name   The new name of the entity.
+    void setEntityName(const Entity& entity, std::string_view name);
+
+    /// @brief Get a counter incremented each time a name change.
+    ///
+    /// Creating, renaming or destroying a entity increment it. The default names generated
+    /// by getEntityName() does not, the name displayed stay the same.
+    /// @return The version of the names, compared by the editor to refresh it search results.
+    [[nodiscard]] std::uint64_t getNameVersion() const noexcept;
+
+    /// @brief Find the entities with a name containing a text, ignoring the case.
+    ///
+    /// The names are indexed by trigram (see NameIndex), the search does not iterate over
+    /// all the entities.
+    /// @param text The text to search, a empty text match every entity.
+    /// @param entities Receive the entities found.
+    void findEntitiesByName(std::string_view text, std::vector<entt::entity>& entities);
+
+    /// @brief Get the string interner used to store the names of the entities.
+    [[nodiscard]] const StringInterner& getStringInterner() const noexcept {
+        return mStringInterner;
+    }
+
+    /// @brief Get the meshes referenced by the CMesh of the entities.
+    [[nodiscard]] MeshRegistry& getMeshRegistry() noexcept { return mMeshRegistry; }
+
+    /// @copydoc getMeshRegistry()
+    [[nodiscard]] const MeshRegistry& getMeshRegistry() const noexcept { return mMeshRegistry; }
+
+    /// @brief Get a counter incremented each time the static entities change.
+    ///
+    /// Adding or removing a CStatic, and adding, replacing or removing the CTransform or
+    /// the CMesh of a static entity increment it. The components of a static entity
+    /// modified in place must be reported with markStaticChanged().
+    /// @return The version of the static entities, compared by the renderers to rebuild
+    ///         their static batches only when needed.
+    [[nodiscard]] std::uint64_t getStaticVersion() const noexcept;
+
+    /// @brief Report that a static entity was modified in place.
+    void markStaticChanged() noexcept;
+
+    /// @brief Get a counter incremented each time a entity move.
+    ///
+    /// Adding, replacing or removing a CTransform or a CMesh increment it. The components
+    /// modified in place must be reported with markTransformsChanged().
+    /// @return The version of the transforms, compared to rebuild the raycast grid.
+    [[nodiscard]] std::uint64_t getTransformVersion() const noexcept;
+
+    /// @brief Report that a CTransform or a CMesh was modified in place.
+    void markTransformsChanged() noexcept;
+
+    /// @brief Find the nearest entity hit by a ray.
+    ///
+    /// The ray is tested against the world bounds of the meshes (entities with a CMesh and
+    /// a CTransform). The bounds are packed in a RaycastGrid rebuilt by the first raycast
+    /// after the transforms changed (see getTransformVersion()), the next rays of the
+    /// frame only test a few cells of the grid.
+    /// @param origin The start of the ray.
+    /// @param direction The direction of the ray, not zero.
+    /// @param maxDistance The entities farther are ignored.
+    /// @return The entity hit and it distance, or a null entity.
+    [[nodiscard]] RaycastHit raycast(
+      const Vec3& origin,
+      const Vec3& direction,
+      float       maxDistance = std::numeric_limits<float>::infinity());
+
+    /// @brief Find an entity from it UUID.
+    /// @param uuid The UUID of the entity (see IDComponent).
+    /// @return The entity or an invalid entity if no entity has this UUID.
+    [[nodiscard]] Entity findEntity(UUID uuid) noexcept;
+
     /// @brief Query if the scene if empty or not.
     /// @return true if the scene is empty, false otherwise.
     [[nodiscard]] bool isEmpty() const noexcept;
@@ -65,6 +196,24 @@ public:
     [[nodiscard]] const entt::registry& getRegistry() const noexcept { return mRegistry; }
 #endif
 
+    /// @brief Register a component type to track it in the entity signatures.
+    ///
+    /// Components added through Entity or createEntities() are registered automatically.
+    /// Components added directly with the registry should be registered first, otherwise
+    /// their storage is probed for each entity duplicated, counted or compared. The storages
+    /// of the types registered after the first kMaxComponentTypes ones are probed too.
+    ///
+    /// @tparam Type The component type to register.
+    template <class Type>
+    void registerComponent() {
+        mSignatureIndex->registerComponent<Type>(mRegistry);
+    }
+
+    /// @brief Get the component signature of an entity.
+    /// @param entity The entity to query.
+    /// @return The set of component type owned by the entity.
+    [[nodiscard]] ComponentSignature getEntitySignature(const Entity& entity) const noexcept;
+
     /// @brief Get the number of component for an entity.
     /// @param The entity to query the number of component for an entity.
     /// @return The number of component for an entity.
@@ -81,8 +230,67 @@ public:
     [[nodiscard]] static Scene& getRegistryAsScene(const entt::registry& registry);
 
 private:
+    /// @brief Check that every storage of the registry is tracked by the signature index.
+    [[nodiscard]] bool isSignatureIndexComplete() const noexcept;
+
+    /// @brief Call a function for each non empty storage not tracked by the signature index.
+    ///
+    /// The components added directly with the registry are not in the signatures, their
+    /// storages are probed instead.
+    /// @param func Called with the storage id and the storage, `void(entt::id_type, const
+    ///             entt::sparse_set&)`.
+    template <class Func>
+    void forEachUntrackedStorage(Func&& func) const;
+
+    /// @brief Make sure the storages of the given components can receive @p count more entities.
+    template <class... Components>
+    void reserveStorages(std::size_t count);
+
     std::string    mName = "Untitle"; ///< The name of the scene.
-    entt::registry mRegistry;
+    /// Indices of the entities. Allocated on the heap so the signals connected
+    /// in the registry stay valid when the scene is moved. Must outlive the registry.
+    std::unique_ptr<SignatureIndex> mSignatureIndex;
+    std::unique_ptr<UUIDIndex>      mUUIDIndex;
+    std::unique_ptr<NameIndex>      mNameIndex;
+    entt::registry                  mRegistry;
+    StringInterner                  mStringInterner; ///< Storage of the entity names.
+    MeshRegistry                    mMeshRegistry;   ///< Storage of the meshes.
+    RaycastGrid                     mRaycastGrid;    ///< Bounds of the meshes for raycast().
+    /// Transform version of mRaycastGrid, the grid is built on the first raycast().
+    std::uint64_t                   mRaycastVersion = std::numeric_limits<std::uint64_t>::max();
 };
 
+template <class... Components>
+void Scene::createEntities(std::span<entt::entity> entities, const Components&... components) {
+    (registerComponent<Components>(), ...);
+    reserveStorages<NameComponent, IDComponent, Components...>(entities.size());
+
+    mRegistry.create(entities.begin(), entities.end());
+    mRegistry.insert<NameComponent>(entities.begin(), entities.end());
+    // IDComponent must be default constructed for each entity to get unique id.
+    mRegistry.storage<IDComponent>().push(entities.begin(), entities.end());
+    (mRegistry.insert<Components>(entities.begin(), entities.end(), components), ...);
+}
+
+template <class Func>
+void Scene::forEachUntrackedStorage(Func&& func) const {
+    for (const auto& [storageId, storage] : mRegistry.storage()) {
+        if (!storage.empty() && !mSignatureIndex->isRegistered(storageId)) {
+            func(storageId, storage);
+        }
+    }
+}
+
+template <class... Components>
+void Scene::reserveStorages(std::size_t count) {
+    auto& entityStorage = mRegistry.storage<entt::entity>();
+    entityStorage.reserve(entityStorage.size() + count);
+    (
+      [this, count]() {
+          auto& storage = mRegistry.storage<Components>();
+          storage.reserve(storage.size() + count);
+      }(),
+      ...);
+}
+
 } // namespace fuse
@@ -0,0 +1,369 @@
+#include "SceneSerializer.h"
+
+#include "ComponentReflection.h"
+#include "Components.h"
+#include "Scene.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+constexpr std::array<char, 4> kMagic   = {'F', 'S', 'C', 'N'};
+constexpr std::uint16_t       kVersion = 1;
+
+/// @brief Index of a entity which is not saved (without IDComponent).
+constexpr std::uint32_t kNoIndex = std::numeric_limits<std::uint32_t>::max();
+
+/// @brief Offset of a field of the data which is not a field of the component.
+constexpr std::uint32_t kSkippedField = std::numeric_limits<std::uint32_t>::max();
+
+/// @brief Header of the data.
+struct Header {
+    std::array<char, 4> magic;
+    std::uint16_t       version;
+    std::uint16_t       blockCount;  ///< Number of component blocks.
+    std::uint32_t       entityCount; ///< Number of entities.
+};
+
+/// @brief Where to copy a field of the data into the component.
+struct FieldMapping {
+    std::uint32_t offset; ///< Offset in the component or kSkippedField.
+    std::uint32_t size;   ///< Size of the field in the data.
+};
+
+template <class T>
+void write(std::vector<char>& buffer, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+void writeString(std::vector<char>& buffer, std::string_view str) {
+    const auto size = static_cast<std::uint16_t>(
+      std::min<std::size_t>(str.size(), std::numeric_limits<std::uint16_t>::max()));
+    write(buffer, size);
+    buffer.insert(buffer.end(), str.data(), str.data() + size);
+}
+
+/// @brief Bounds checked reader over the data.
+class Reader {
+public:
+    explicit Reader(std::span<const char> data) noexcept
+        : mData(data) {}
+
+    template <class T>
+    bool read(T& value) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (mData.size() - mOffset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, mData.data() + mOffset, sizeof(T));
+        mOffset += sizeof(T);
+        return true;
+    }
+
+    bool readString(std::string& str) {
+        std::uint16_t size{};
+        if (!read(size) || mData.size() - mOffset < size) {
+            return false;
+        }
+        str.assign(mData.data() + mOffset, size);
+        mOffset += size;
+        return true;
+    }
+
+    /// @brief Skip bytes of the data.
+    /// @return The skipped bytes or nullptr if the data is too short.
+    const char* skip(std::size_t size) noexcept {
+        if (mData.size() - mOffset < size) {
+            return nullptr;
+        }
+        const char* bytes = mData.data() + mOffset;
+        mOffset += size;
+        return bytes;
+    }
+
+    [[nodiscard]] std::size_t getRemaining() const noexcept { return mData.size() - mOffset; }
+
+private:
+    std::span<const char> mData;
+    std::size_t           mOffset{};
+};
+
+/// @brief Write the block of a component.
+/// @param data Receive the block.
+/// @param info The component.
+/// @param entities The entities with the component.
+/// @param values The components of the entities.
+/// @param indices Index of the entities in the data, by entity id.
+/// @return False if no component was written.
+bool writeBlock(std::vector<char>&                data,
+                const fuse::ComponentInfo&        info,
+                std::span<const entt::entity>     entities,
+                std::span<const std::byte>        values,
+                const std::vector<std::uint32_t>& indices) {
+    const std::size_t blockOffset = data.size();
+    write(data, info.id);
+    const std::size_t countOffset = data.size();
+    write(data, std::uint32_t{0});
+    write(data, static_cast<std::uint16_t>(info.fields.size()));
+    std::size_t stride = 0;
+    for (const fuse::FieldInfo& field : info.fields) {
+        write(data, field.id);
+        write(data, field.type);
+        write(data, field.size);
+        stride += field.size;
+    }
+
+    std::uint32_t count = 0;
+    for (const entt::entity entity : entities) {
+        const auto slot = static_cast<std::size_t>(entt::to_entity(entity));
+        if (slot < indices.size() && indices[slot] != kNoIndex) {
+            write(data, indices[slot]);
+            count++;
+        }
+    }
+    if (count == 0) {
+        data.resize(blockOffset);
+        return false;
+    }
+    std::memcpy(data.data() + countOffset, &count, sizeof(count));
+
+    // Pack the fields, the values of the padding and of the fields not reflected are not saved.
+    std::size_t offset = data.size();
+    data.resize(offset + count * stride);
+    for (std::size_t i = 0; i < entities.size(); i++) {
+        const auto slot = static_cast<std::size_t>(entt::to_entity(entities[i]));
+        if (slot >= indices.size() || indices[slot] == kNoIndex) {
+            continue;
+        }
+        const std::byte* component = values.data() + i * info.size;
+        for (const fuse::FieldInfo& field : info.fields) {
+            std::memcpy(data.data() + offset, component + field.offset, field.size);
+            offset += field.size;
+        }
+    }
+    return true;
+}
+
+/// @brief Reset the values of the fields of a component which are not valid in a scene.
+///
+/// The data may be corrupted or saved with other meshes: a mesh handle not in the scene
+/// take the value of a default component, the values of a field with a range are clamped.
+/// @param info The component.
+/// @param component The component to check.
+/// @param defaults A default component.
+/// @param meshCount The number of meshes of the scene.
+void sanitizeFields(const fuse::ComponentInfo& info,
+                    std::byte*                 component,
+                    const std::byte*           defaults,
+                    std::size_t                meshCount) {
+    for (const fuse::FieldInfo& field : info.fields) {
+        const std::size_t elementSize = field.size / field.count;
+        const bool        hasRange    = field.min < field.max;
+        for (std::size_t i = 0; i < field.count; i++) {
+            std::byte* element = component + field.offset + i * elementSize;
+            if (field.type == fuse::FieldType::Mesh) {
+                fuse::MeshHandle mesh;
+                std::memcpy(&mesh, element, sizeof(mesh));
+                if (mesh.id >= meshCount) {
+                    std::memcpy(element, defaults + (element - component), sizeof(mesh));
+                }
+            } else if (field.type == fuse::FieldType::UInt8 && hasRange) {
+                std::uint8_t value{};
+                std::memcpy(&value, element, sizeof(value));
+                value = static_cast<std::uint8_t>(
+                  std::clamp(static_cast<float>(value), field.min, field.max));
+                std::memcpy(element, &value, sizeof(value));
+            } else if (field.type == fuse::FieldType::Float && hasRange) {
+                float value{};
+                std::memcpy(&value, element, sizeof(value));
+                value = std::clamp(value, field.min, field.max);
+                std::memcpy(element, &value, sizeof(value));
+            }
+        }
+    }
+}
+
+/// @brief Read the block of a component and add the components to the entities.
+/// @param reader Read the block.
+/// @param registry The registry of the entities.
+/// @param entities The entities of the data, by index.
+/// @param meshCount The number of meshes of the scene.
+/// @return False if the block is not valid.
+bool readBlock(Reader&                       reader,
+               entt::registry&               registry,
+               std::span<const entt::entity> entities,
+               std::size_t                   meshCount) {
+    entt::id_type id{};
+    std::uint32_t count{};
+    std::uint16_t fieldCount{};
+    if (!reader.read(id) || !reader.read(count) || !reader.read(fieldCount)) {
+        return false;
+    }
+
+    // The unknown components are skipped, the fields are matched by name, type and size.
+    const fuse::ComponentInfo* info   = fuse::findComponentInfo(id);
+    const auto                 fields = info ? info->fields : std::span<const fuse::FieldInfo>{};
+    std::vector<FieldMapping>  mappings(fieldCount);
+    std::size_t                stride = 0;
+    for (FieldMapping& mapping : mappings) {
+        entt::id_type   fieldId{};
+        fuse::FieldType type{};
+        if (!reader.read(fieldId) || !reader.read(type) || !reader.read(mapping.size)) {
+            return false;
+        }
+        mapping.offset = kSkippedField;
+        for (const fuse::FieldInfo& field : fields) {
+            if (field.id == fieldId && field.type == type && field.size == mapping.size) {
+                mapping.offset = field.offset;
+            }
+        }
+        stride += mapping.size;
+    }
+
+    if (reader.getRemaining() / (sizeof(std::uint32_t) + stride) < count) {
+        return false;
+    }
+    std::vector<entt::entity> componentEntities(count);
+    for (entt::entity& entity : componentEntities) {
+        std::uint32_t index{};
+        if (!reader.read(index) || index >= entities.size()) {
+            return false;
+        }
+        entity = entities[index];
+    }
+    const char* source = reader.skip(count * stride);
+    if (!source) {
+        return false;
+    }
+    if (!info) {
+        return true;
+    }
+
+    // The fields missing in the data keep the value of a default component.
+    std::vector<std::byte> defaults(info->size);
+    std::vector<std::byte> values(std::size_t{count} * info->size);
+    if (info->size > 0 && count > 0) {
+        info->construct(defaults.data());
+        std::byte* component = values.data();
+        for (std::size_t i = 0; i < count; i++) {
+            std::memcpy(component, defaults.data(), info->size);
+            for (const FieldMapping& mapping : mappings) {
+                if (mapping.offset != kSkippedField) {
+                    std::memcpy(component + mapping.offset, source, mapping.size);
+                }
+                source += mapping.size;
+            }
+            sanitizeFields(*info, component, defaults.data(), meshCount);
+            component += info->size;
+        }
+    }
+    info->insert(registry, componentEntities, values.data());
+    return true;
+}
+
+} // namespace
+
+namespace fuse {
+
+std::vector<char> SceneSerializer::Serialize(const Scene& scene) {
+    const entt::registry& registry = scene.getRegistry();
+    std::vector<char>     data;
+    Header                header{};
+    header.magic   = kMagic;
+    header.version = kVersion;
+    write(data, header);
+
+    // The entities are saved in the order of the IDComponent storage.
+    std::vector<std::uint32_t> indices;
+    for (auto [entity, id] : registry.view<const IDComponent>().each()) {
+        const auto slot = static_cast<std::size_t>(entt::to_entity(entity));
+        if (slot >= indices.size()) {
+            indices.resize(slot + 1, kNoIndex);
+        }
+        indices[slot]    = header.entityCount++;
+        const auto* name = registry.try_get<NameComponent>(entity);
+        write(data, id.id.value());
+        writeString(data,
+                    name ? scene.getStringInterner().resolve(name->name) : std::string_view{});
+    }
+
+    std::vector<entt::entity> entities;
+    std::vector<std::byte>    values;
+    for (const ComponentInfo* info : getReflectedComponents()) {
+        entities.clear();
+        values.clear();
+        info->gather(registry, entities, values);
+        if (writeBlock(data, *info, entities, values, indices)) {
+            header.blockCount++;
+        }
+    }
+
+    std::memcpy(data.data(), &header, sizeof(header));
+    return data;
+}
+
+bool SceneSerializer::Deserialize(std::span<const char> data, Scene& scene) {
+    Reader reader(data);
+    Header header{};
+    if (!reader.read(header) || header.magic != kMagic || header.version != kVersion) {
+        return false;
+    }
+
+    // A entity use at least it UUID and the size of it name.
+    constexpr std::size_t kMinEntitySize = sizeof(std::uint64_t) + sizeof(std::uint16_t);
+    if (reader.getRemaining() / kMinEntitySize < header.entityCount) {
+        return false;
+    }
+
+    entt::registry&           registry  = scene.getRegistry();
+    const std::size_t         meshCount = scene.getMeshRegistry().getMeshCount();
+    std::vector<entt::entity> entities;
+    entities.reserve(header.entityCount);
+    std::string name;
+    for (std::uint32_t i = 0; i < header.entityCount; i++) {
+        std::uint64_t uuid{};
+        if (!reader.read(uuid) || !reader.readString(name)) {
+            return false;
+        }
+        // a entity already in the scene is loaded as a copy, with a new UUID
+        const UUID id = scene.findEntity(UUID(uuid)) ? UUID::Generate() : UUID(uuid);
+        entities.push_back(static_cast<entt::entity>(scene.createEntity(name, id).getId()));
+    }
+
+    for (std::uint16_t block = 0; block < header.blockCount; block++) {
+        if (!readBlock(reader, registry, entities, meshCount)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::expected<void, FileError> SceneSerializer::Save(const std::filesystem::path& path,
+                                                     const Scene&                 scene) {
+    return FileSystem::WriteFile(path, Serialize(scene));
+}
+
+std::expected<void, FileError> SceneSerializer::Load(const std::filesystem::path& path,
+                                                     Scene&                       scene) {
+    const auto data = FileSystem::ReadFile(path);
+    if (!data) {
+        return std::unexpected(data.error());
+    }
+    if (!Deserialize(data.value(), scene)) {
+        return std::unexpected(FileError{.errorCode = FileErrorCode::ReadFailure, .path = path});
+    }
+    return {};
+}
+
+} // namespace fuse
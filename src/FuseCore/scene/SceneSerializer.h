@@ -0,0 +1,57 @@
+#pragma once
+#include <FuseCore/fileSystem/FileSystem.h>
+
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace fuse {
+class Scene;
+
+/// @brief Save and load the entities of a scene in a compact binary format.
+///
+/// The data start with the entities (UUID and name) followed by one block per reflected
+/// component (see ComponentReflection.h): the id of the component, the description of it
+/// fields, the index of the entities and the values of the fields, packed.
+///
+/// The components and the fields are identified by the hash of their name, so a scene
+/// can be loaded after fields were added, removed or reordered: the unknown components
+/// and fields are skipped, the missing fields keep their default value.
+///
+/// A storage is saved and loaded in one pass with the precomputed field tables, the code
+/// specific to a component is called once per storage.
+///
+/// @note The data use the native byte order.
+class SceneSerializer {
+public:
+    /// @brief Save the entities of a scene.
+    /// @param scene The scene to save.
+    /// @return The binary data.
+    [[nodiscard]] static std::vector<char> Serialize(const Scene& scene);
+
+    /// @brief Add the entities saved by Serialize() to a scene.
+    ///
+    /// The entities keep their UUID, a entity whose UUID is already used in the scene is
+    /// loaded as a copy with a new UUID. The values not valid in the scene (a mesh not in
+    /// the MeshRegistry, a value out of the range of a field) are reset or clamped.
+    /// @param data The binary data.
+    /// @param scene The scene receiving the entities.
+    /// @return False if the data are not valid, the entities read before the error are kept.
+    static bool Deserialize(std::span<const char> data, Scene& scene);
+
+    /// @brief Save the entities of a scene into a file.
+    /// @param path The file to write.
+    /// @param scene The scene to save.
+    /// @return Nothing or a \p FileError if the file can't be written.
+    static std::expected<void, FileError> Save(const std::filesystem::path& path,
+                                               const Scene&                 scene);
+
+    /// @brief Add the entities saved in a file to a scene.
+    /// @param path The file to read.
+    /// @param scene The scene receiving the entities.
+    /// @return Nothing or a \p FileError if the file can't be read or is not valid.
+    static std::expected<void, FileError> Load(const std::filesystem::path& path, Scene& scene);
+};
+
+} // namespace fuse
@@ -0,0 +1,196 @@
+#pragma once
+#include "Components.h"
+#include "UndoJournal.h"
+
+#include <entt/entity/registry.hpp>
+#include <entt/signal/sigh.hpp>
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Values of a component over the selected entities (see CSelected), for the editor.
+///
+/// The component is seen as an array of floats (the fields). A field is mixed when the
+/// selected entities do not all have the same value, the value shown is the one of the
+/// first entity.
+///
+/// The summary follow the signals of the registry: selecting entities add their values to
+/// it, deselecting entities or replacing, adding or removing the component of a selected
+/// entity mark it dirty, and it is recomputed by the next update(). The components modified
+/// in place are detected with a version counter (see Scene::getTransformVersion()).
+///
+/// @tparam Component A trivially copyable component made of floats (CTransform).
+template <class Component>
+class SelectionSummary {
+public:
+    static_assert(std::is_trivially_copyable_v<Component>);
+    static_assert(sizeof(Component) % sizeof(float) == 0, "The component must be floats.");
+
+    static constexpr std::size_t kFieldCount = sizeof(Component) / sizeof(float);
+    using Fields                             = std::array<float, kFieldCount>;
+
+    SelectionSummary() = default;
+
+    SelectionSummary(const SelectionSummary&)            = delete;
+    SelectionSummary(SelectionSummary&&)                 = delete;
+    SelectionSummary& operator=(const SelectionSummary&) = delete;
+    SelectionSummary& operator=(SelectionSummary&&)      = delete;
+
+    /// @brief Follow the changes of the selection of a registry.
+    /// @param registry The registry, must outlive the summary.
+    void connect(entt::registry& registry);
+
+    /// @brief Recompute the summary if the selection or the components changed.
+    /// @param registry The registry connected.
+    /// @param version A counter incremented when the components are modified in place.
+    void update(const entt::registry& registry, std::uint64_t version);
+
+    /// @brief Take a version as up to date, after setField() modified the components.
+    void acceptVersion(std::uint64_t version) noexcept { mVersion = version; }
+
+    /// @brief Set a field of the components of all the selected entities.
+    ///
+    /// The components are modified in place, in one pass over the selection. The changes
+    /// are recorded as one entry of the journal, merged with the previous entry when the
+    /// merge key is the same (a drag).
+    /// @param registry The registry connected.
+    /// @param field The index of the field.
+    /// @param value The new value of the field.
+    /// @param journal Record the changes, can be nullptr.
+    /// @param mergeKey The merge key of the entry in the journal.
+    void setField(entt::registry& registry,
+                  std::size_t     field,
+                  float           value,
+                  UndoJournal*    journal  = nullptr,
+                  std::uint64_t   mergeKey = 0);
+
+    /// @brief Get the number of selected entities with the component.
+    [[nodiscard]] std::size_t getCount() const noexcept { return mCount; }
+
+    /// @brief Get the value of a field for the first selected entity.
+    [[nodiscard]] float getValue(std::size_t field) const noexcept { return mValues[field]; }
+
+    /// @brief Check if the selected entities have different values for a field.
+    [[nodiscard]] bool isMixed(std::size_t field) const noexcept { return mMixed[field]; }
+
+private:
+    /// @brief Add the component of a entity to the summary.
+    void add(const Component& component) noexcept;
+
+    void onSelect(entt::registry& registry, entt::entity entity);
+    void onConstruct(entt::registry& registry, entt::entity entity);
+    void onChange(entt::registry& registry, entt::entity entity);
+    void onDeselect(entt::registry& registry, entt::entity entity);
+
+    Fields                               mValues{};    ///< Values of the first entity.
+    std::array<bool, kFieldCount>        mMixed{};     ///< The fields with different values.
+    std::size_t                          mCount{};     ///< Number of components summarized.
+    bool                                 mDirty{true}; ///< Must be recomputed.
+    std::uint64_t                        mVersion{};   ///< Version of the last update().
+    std::vector<entt::scoped_connection> mConnections; ///< Disconnected with the summary.
+};
+
+template <class Component>
+void SelectionSummary<Component>::connect(entt::registry& registry) {
+    using Self = SelectionSummary<Component>;
+    mConnections.clear();
+    mConnections.emplace_back(registry.on_construct<CSelected>().connect<&Self::onSelect>(*this));
+    mConnections.emplace_back(registry.on_destroy<CSelected>().connect<&Self::onDeselect>(*this));
+    mConnections.emplace_back(
+      registry.on_construct<Component>().template connect<&Self::onConstruct>(*this));
+    mConnections.emplace_back(
+      registry.on_update<Component>().template connect<&Self::onChange>(*this));
+    mConnections.emplace_back(
+      registry.on_destroy<Component>().template connect<&Self::onChange>(*this));
+    mDirty = true;
+}
+
+template <class Component>
+void SelectionSummary<Component>::update(const entt::registry& registry, std::uint64_t version) {
+    if (!mDirty && version == mVersion) {
+        return;
+    }
+
+    mCount = 0;
+    mMixed = {};
+    registry.view<const Component, const CSelected>().each(
+      [this](const Component& component) { add(component); });
+    mDirty   = false;
+    mVersion = version;
+}
+
+template <class Component>
+void SelectionSummary<Component>::setField(entt::registry& registry,
+                                           std::size_t     field,
+                                           float           value,
+                                           UndoJournal*    journal,
+                                           std::uint64_t   mergeKey) {
+    assert(field < kFieldCount);
+    if (journal) {
+        journal->beginGroup(mergeKey);
+    }
+    for (auto [entity, component] : registry.view<Component, const CSelected>().each()) {
+        const Component before = component;
+        auto            fields = std::bit_cast<Fields>(component);
+        fields[field]          = value;
+        component              = std::bit_cast<Component>(fields);
+        if (journal) {
+            journal->record(entity, before, component);
+        }
+    }
+    if (journal) {
+        journal->endGroup();
+    }
+
+    mValues[field] = value;
+    mMixed[field]  = false;
+}
+
+template <class Component>
+void SelectionSummary<Component>::add(const Component& component) noexcept {
+    const auto fields = std::bit_cast<Fields>(component);
+    if (mCount++ == 0) {
+        mValues = fields;
+        return;
+    }
+    for (std::size_t i = 0; i < kFieldCount; i++) {
+        mMixed[i] |= fields[i] != mValues[i];
+    }
+}
+
+template <class Component>
+void SelectionSummary<Component>::onSelect(entt::registry& registry, entt::entity entity) {
+    // A entity added to the selection does not require to recompute the summary.
+    if (!mDirty) {
+        if (const auto* component = registry.try_get<Component>(entity)) {
+            add(*component);
+        }
+    }
+}
+
+template <class Component>
+void SelectionSummary<Component>::onConstruct(entt::registry& registry, entt::entity entity) {
+    if (!mDirty && registry.all_of<CSelected>(entity)) {
+        add(registry.get<Component>(entity));
+    }
+}
+
+template <class Component>
+void SelectionSummary<Component>::onChange(entt::registry& registry, entt::entity entity) {
+    mDirty = mDirty || registry.all_of<CSelected>(entity);
+}
+
+template <class Component>
+void SelectionSummary<Component>::onDeselect(entt::registry& /*registry*/,
+                                             entt::entity /*entity*/) {
+    mDirty = true;
+}
+
+} // namespace fuse
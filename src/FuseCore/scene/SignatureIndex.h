@@ -0,0 +1,109 @@
+#pragma once
+#include <entt/core/type_info.hpp>
+#include <entt/entity/entity.hpp>
+#include <entt/entity/registry.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Maximum number of component types tracked by a SignatureIndex.
+inline constexpr std::size_t kMaxComponentTypes = 64;
+
+/// @brief Set of component types owned by an entity (one bit per component type).
+using ComponentSignature = std::bitset<kMaxComponentTypes>;
+
+/// @brief Keep track of the component signature of every entity of a registry.
+///
+/// Each registered component type get a bit, the signatures are updated from the
+/// construct/destroy signals of the registry. This allow to count or compare
+/// components of entities without probing every storage of the registry.
+///
+/// @note A component type must be registered to be tracked.
+///       Entity and Scene register the component types they add automatically.
+///       The storages not tracked must be probed by the users of the index.
+class SignatureIndex {
+public:
+    SignatureIndex() = default;
+
+    /// @brief Register a component type and connect to the signals of it storage.
+    ///
+    /// Entities which already have this component are added to the index.
+    /// Registering a type more than once does nothing. Once kMaxComponentTypes types are
+    /// registered, the next types are not tracked (see isRegistered()).
+    ///
+    /// @tparam Type The component type to register.
+    /// @param registry The registry owning the storage.
+    template <class Type>
+    void registerComponent(entt::registry& registry) {
+        const auto typeIndex = entt::type_index<Type>::value();
+        if (typeIndex < mTypeBits.size() && mTypeBits[typeIndex] != 0) {
+            return;
+        }
+
+        if (mStorageIds.size() == kMaxComponentTypes) {
+            return; // no bit left, the storage stay untracked
+        }
+        if (typeIndex >= mTypeBits.size()) {
+            mTypeBits.resize(typeIndex + 1, 0);
+        }
+        mStorageIds.push_back(entt::type_hash<Type>::value());
+        mTypeBits[typeIndex] = static_cast<std::uint8_t>(mStorageIds.size()); // bit + 1
+
+        registry.on_construct<Type>().template connect<&SignatureIndex::onConstruct<Type>>(*this);
+        registry.on_destroy<Type>().template connect<&SignatureIndex::onDestroy<Type>>(*this);
+
+        for (const auto entity : registry.storage<Type>()) {
+            onConstruct<Type>(registry, entity);
+        }
+    }
+
+    /// @brief Check if a storage is tracked by the index.
+    /// @param storageId The id of the storage.
+    [[nodiscard]] bool isRegistered(entt::id_type storageId) const noexcept {
+        return std::ranges::find(mStorageIds, storageId) != mStorageIds.end();
+    }
+
+    /// @brief Get the signature of an entity.
+    /// @param entity The entity to query.
+    /// @return The set of registered component owned by the entity.
+    [[nodiscard]] ComponentSignature getSignature(entt::entity entity) const noexcept {
+        const auto index = entt::to_entity(entity);
+        return index < mSignatures.size() ? mSignatures[index] : ComponentSignature{};
+    }
+
+    /// @brief Get the id of the storage associated to a bit of the signature.
+    /// @param bit The bit of the signature.
+    [[nodiscard]] entt::id_type getStorageId(std::size_t bit) const noexcept {
+        assert(bit < mStorageIds.size());
+        return mStorageIds[bit];
+    }
+
+    /// @brief Get the number of component types registered.
+    [[nodiscard]] std::size_t getComponentTypeCount() const noexcept { return mStorageIds.size(); }
+
+private:
+    template <class Type>
+    void onConstruct(entt::registry& /*registry*/, entt::entity entity) {
+        const auto index = entt::to_entity(entity);
+        if (index >= mSignatures.size()) {
+            mSignatures.resize(index + 1);
+        }
+        mSignatures[index].set(mTypeBits[entt::type_index<Type>::value()] - 1U);
+    }
+
+    template <class Type>
+    void onDestroy(entt::registry& /*registry*/, entt::entity entity) {
+        mSignatures[entt::to_entity(entity)].reset(mTypeBits[entt::type_index<Type>::value()] - 1U);
+    }
+
+    std::vector<ComponentSignature> mSignatures; ///< Signature of entities, by entity index.
+    std::vector<std::uint8_t>       mTypeBits;   ///< Bit + 1 of each type, indexed by type index.
+    std::vector<entt::id_type>      mStorageIds; ///< Storage id of each bit.
+};
+
+} // namespace fuse
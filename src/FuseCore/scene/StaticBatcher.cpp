@@ -0,0 +1,133 @@
+#include "StaticBatcher.h"
+
+#include "RenderList.h"
+#include "Scene.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <numeric>
+
+namespace {
+
+/// @brief Bits of a color, to group the meshes with exactly the same color.
+std::array<std::uint32_t, 4> getColorKey(const fuse::Vec4& color) noexcept {
+    return {std::bit_cast<std::uint32_t>(color.x),
+            std::bit_cast<std::uint32_t>(color.y),
+            std::bit_cast<std::uint32_t>(color.z),
+            std::bit_cast<std::uint32_t>(color.w)};
+}
+
+/// @brief Append the indices of a mesh, offset by the first vertex of the mesh in the batch.
+template <class Index>
+void appendIndices(std::vector<std::uint32_t>& output,
+                   std::span<const Index>      indices,
+                   std::uint32_t               baseVertex,
+                   bool                        flipWinding) {
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        const std::uint32_t a = baseVertex + indices[i];
+        const std::uint32_t b = baseVertex + indices[i + 1];
+        const std::uint32_t c = baseVertex + indices[i + 2];
+        output.insert(output.end(), {a, flipWinding ? c : b, flipWinding ? b : c});
+    }
+}
+
+} // namespace
+
+namespace fuse {
+
+bool StaticBatcher::update(const Scene& scene) {
+    if (&scene == mScene && scene.getStaticVersion() == mStaticVersion) {
+        return false;
+    }
+    mScene         = &scene;
+    mStaticVersion = scene.getStaticVersion();
+
+    mEntries.clear();
+    mOccluders.clear();
+    const auto& registry = scene.getRegistry();
+    for (auto&& [entity, mesh, transform] : registry.view<CStatic, CMesh, CTransform>().each()) {
+        if (!isStaticBatched(mesh)) {
+            continue; // extracted every frame
+        }
+        const Mat4 world = computeWorldMatrix(transform);
+        mEntries.push_back({.world    = world,
+                            .color    = mesh.color,
+                            .mesh     = mesh.mesh,
+                            .entityId = toPickId(entity)});
+        if (mesh.occluder) {
+            mOccluders.push_back({.world = world, .mesh = mesh.mesh});
+        }
+    }
+    build(mEntries, scene.getMeshRegistry());
+    return true;
+}
+
+void StaticBatcher::build(std::span<const StaticEntry> entries, const MeshRegistry& registry) {
+    mVertices.clear();
+    mEntityIds.clear();
+    mIndices.clear();
+    mBatches.clear();
+    mEntityCount = entries.size();
+
+    // group the meshes by color, in the order of the entries inside a group.
+    mOrder.resize(entries.size());
+    std::iota(mOrder.begin(), mOrder.end(), 0U);
+    std::ranges::stable_sort(mOrder, {}, [&](std::uint32_t index) {
+        return getColorKey(entries[index].color);
+    });
+
+    for (const auto index : mOrder) {
+        const StaticEntry& entry = entries[index];
+        const MeshInfo&    info  = registry.getInfo(entry.mesh);
+        if (mBatches.empty() || getColorKey(mBatches.back().color) != getColorKey(entry.color)) {
+            mBatches.push_back({.color      = entry.color,
+                                .firstIndex = static_cast<std::uint32_t>(mIndices.size()),
+                                .indexCount = 0});
+        }
+
+        // the normals are transformed by the cofactor matrix of the world matrix, which is
+        // it inverse transpose scaled by it determinant, so it handle the scaling by zero.
+        const Vec3 c0{entry.world(0, 0), entry.world(1, 0), entry.world(2, 0)};
+        const Vec3 c1{entry.world(0, 1), entry.world(1, 1), entry.world(2, 1)};
+        const Vec3 c2{entry.world(0, 2), entry.world(1, 2), entry.world(2, 2)};
+        const Vec3 n0          = c1.crossRH(c2);
+        const Vec3 n1          = c2.crossRH(c0);
+        const Vec3 n2          = c0.crossRH(c1);
+        const bool flipWinding = c0.dot(n0) < 0.0f; // a mirror reverse the triangles
+
+        const auto baseVertex = static_cast<std::uint32_t>(mVertices.size());
+        const auto vertices   = registry.getVertices().subspan(info.baseVertex, info.vertexCount);
+        for (const Vertex& vertex : vertices) {
+            const Vec3& p        = vertex.position;
+            const Vec3& n        = vertex.normal;
+            const Vec4  position = entry.world * Vec4(p.x, p.y, p.z, 1.0f);
+            Vec3        normal   = n0 * n.x + n1 * n.y + n2 * n.z;
+            const float length   = normal.length();
+            if (length > 0.0f) {
+                normal *= (flipWinding ? -1.0f : 1.0f) / length;
+            } else {
+                normal = n; // degenerated matrix, nothing visible anyway
+            }
+            mVertices.push_back({.position = {position.x, position.y, position.z},
+                                 .normal   = normal});
+        }
+        mEntityIds.insert(mEntityIds.end(), vertices.size(), entry.entityId);
+
+        if (info.indexType == IndexType::UInt16) {
+            appendIndices(mIndices,
+                          registry.getIndices16().subspan(info.firstIndex, info.indexCount),
+                          baseVertex,
+                          flipWinding);
+        } else {
+            appendIndices(mIndices,
+                          registry.getIndices32().subspan(info.firstIndex, info.indexCount),
+                          baseVertex,
+                          flipWinding);
+        }
+        mBatches.back().indexCount += info.indexCount;
+        mBatches.back().entityCount++;
+    }
+}
+
+} // namespace fuse
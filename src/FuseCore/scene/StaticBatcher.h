@@ -0,0 +1,102 @@
+#pragma once
+#include "Components.h"
+
+#include <FuseCore/math/Mat4.h>
+#include <FuseCore/math/Vec4.h>
+#include <FuseCore/renderer/MeshRegistry.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fuse {
+
+class Scene;
+
+/// @brief Check if the mesh of a static entity is merged in the static batches.
+///
+/// Only the opaque meshes are, the transparent meshes must be sorted every frame.
+[[nodiscard]] constexpr bool isStaticBatched(const CMesh& mesh) noexcept {
+    return mesh.color.w >= 1.0f;
+}
+
+/// @brief A mesh to merge in the static batches.
+struct StaticEntry {
+    Mat4          world;      ///< World matrix of the mesh.
+    Vec4          color;      ///< Color of the mesh.
+    MeshHandle    mesh;       ///< The mesh to merge.
+    std::uint32_t entityId{}; ///< Entity of the mesh, see toPickId().
+};
+
+/// @brief Meshes of the same color merged into a single draw.
+struct StaticBatch {
+    Vec4          color;         ///< Color of the meshes.
+    std::uint32_t firstIndex{};  ///< First index in StaticBatcher::getIndices().
+    std::uint32_t indexCount{};  ///< Number of indices.
+    std::uint32_t entityCount{}; ///< Number of meshes merged.
+};
+
+/// @brief A static occluder, the static meshes are not in the render list anymore.
+struct StaticOccluder {
+    Mat4       world; ///< World matrix of the occluder.
+    MeshHandle mesh;  ///< The mesh of the occluder.
+};
+
+/// @brief Merge the geometry of the static entities (see CStatic) into a few batches.
+///
+/// The vertices of each mesh are transformed in world space and appended to a single
+/// vertex buffer, the meshes of the same color (the only material for now) share a batch
+/// so a renderer draw all the static entities with one draw per color and an identity
+/// world matrix. The batches are rebuilt only when the static entities of the scene change.
+///
+/// The static entities use the most detailed mesh of their CMesh, their CLod is ignored.
+class StaticBatcher {
+public:
+    /// @brief Rebuild the batches if the static entities of the scene changed.
+    /// @param scene The scene to batch.
+    /// @return True if the batches were rebuilt.
+    bool update(const Scene& scene);
+
+    /// @brief Rebuild the batches from a list of meshes.
+    /// @param entries The meshes to merge.
+    /// @param registry The registry of the meshes.
+    void build(std::span<const StaticEntry> entries, const MeshRegistry& registry);
+
+    /// @brief Get the vertices of all the batches, in world space.
+    [[nodiscard]] std::span<const Vertex> getVertices() const noexcept { return mVertices; }
+
+    /// @brief Get the entity of each vertex (see StaticEntry::entityId), for the picking.
+    [[nodiscard]] std::span<const std::uint32_t> getEntityIds() const noexcept {
+        return mEntityIds;
+    }
+
+    /// @brief Get the indices of all the batches, relative to the first vertex.
+    [[nodiscard]] std::span<const std::uint32_t> getIndices() const noexcept {
+        return mIndices;
+    }
+
+    /// @brief Get the batches, one per color.
+    [[nodiscard]] std::span<const StaticBatch> getBatches() const noexcept { return mBatches; }
+
+    /// @brief Get the static entities flagged as occluder (see CMesh::occluder).
+    [[nodiscard]] std::span<const StaticOccluder> getOccluders() const noexcept {
+        return mOccluders;
+    }
+
+    /// @brief Get the number of meshes merged.
+    [[nodiscard]] std::size_t getEntityCount() const noexcept { return mEntityCount; }
+
+private:
+    std::vector<Vertex>         mVertices;
+    std::vector<std::uint32_t>  mEntityIds;
+    std::vector<std::uint32_t>  mIndices;
+    std::vector<StaticBatch>    mBatches;
+    std::vector<StaticOccluder> mOccluders;
+    std::vector<StaticEntry>    mEntries;         ///< Entries of the last update().
+    std::vector<std::uint32_t>  mOrder;           ///< Entries sorted by color.
+    std::size_t                 mEntityCount{};   ///< Number of meshes merged.
+    const Scene*                mScene{};         ///< Scene of the last update().
+    std::uint64_t               mStaticVersion{}; ///< Static version of the last update().
+};
+
+} // namespace fuse
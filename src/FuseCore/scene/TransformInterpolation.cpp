@@ -0,0 +1,53 @@
+#include "TransformInterpolation.h"
+
+#include "Scene.h"
+
+#include <vector>
+
+namespace {
+
+float lerp(float a, float b, float alpha) noexcept { return a + (b - a) * alpha; }
+
+/// @brief Interpolate a angle in degrees along the shortest path.
+float lerpDegrees(float a, float b, float alpha) noexcept {
+    return a + fuse::degrees(b - a).wrapSigned().asDegrees() * alpha;
+}
+
+} // namespace
+
+namespace fuse {
+
+void storePreviousTransforms(Scene& scene) {
+    auto& registry = scene.getRegistry();
+
+    // plain copy, no signal is needed to update a existing component.
+    for (auto&& [entity, transform, previous] :
+         registry.view<CTransform, CPreviousTransform>().each()) {
+        previous.transform = transform;
+    }
+
+    const auto missing = registry.view<CTransform>(entt::exclude<CPreviousTransform>);
+    if (missing.begin() != missing.end()) {
+        const std::vector<entt::entity> entities(missing.begin(), missing.end());
+        for (const auto entity : entities) {
+            registry.emplace<CPreviousTransform>(entity, registry.get<CTransform>(entity));
+        }
+    }
+}
+
+CTransform interpolateTransform(const CTransform& previous,
+                                const CTransform& current,
+                                float             alpha) noexcept {
+    const auto lerpVec3 = [alpha](const Vec3& a, const Vec3& b) {
+        return Vec3{lerp(a.x, b.x, alpha), lerp(a.y, b.y, alpha), lerp(a.z, b.z, alpha)};
+    };
+    return {
+      .translation = lerpVec3(previous.translation, current.translation),
+      .rotation    = {lerpDegrees(previous.rotation.x, current.rotation.x, alpha),
+                      lerpDegrees(previous.rotation.y, current.rotation.y, alpha),
+                      lerpDegrees(previous.rotation.z, current.rotation.z, alpha)},
+      .scale       = lerpVec3(previous.scale, current.scale),
+    };
+}
+
+} // namespace fuse
@@ -0,0 +1,27 @@
+#pragma once
+#include "Components.h"
+
+namespace fuse {
+
+class Scene;
+
+/// @brief Save the transform of every entity as it previous transform.
+///
+/// Must be called before each fixed simulation step, so the renderer can interpolate
+/// between the state before and after the step. Entities without a CPreviousTransform
+/// get one.
+/// @param scene The scene to update.
+void storePreviousTransforms(Scene& scene);
+
+/// @brief Interpolate between two transforms.
+///
+/// The rotations are interpolated along the shortest path, per euler angle.
+/// @param previous The transform at the previous simulation step.
+/// @param current The transform at the current simulation step.
+/// @param alpha The interpolation factor in range [0, 1], 0 give \p previous and 1 \p current.
+/// @return The interpolated transform.
+[[nodiscard]] CTransform interpolateTransform(const CTransform& previous,
+                                              const CTransform& current,
+                                              float             alpha) noexcept;
+
+} // namespace fuse
@@ -0,0 +1,50 @@
+#include "UUIDIndex.h"
+
+#include "Components.h"
+
+#include <cassert>
+
+namespace fuse {
+
+void UUIDIndex::connect(entt::registry& registry) {
+    registry.on_construct<IDComponent>().connect<&UUIDIndex::onConstruct>(*this);
+    registry.on_update<IDComponent>().connect<&UUIDIndex::onUpdate>(*this);
+    registry.on_destroy<IDComponent>().connect<&UUIDIndex::onDestroy>(*this);
+}
+
+entt::entity UUIDIndex::find(UUID uuid) const noexcept {
+    const auto it = mEntities.find(uuid);
+    return it != mEntities.end() ? it->second : entt::entity{entt::null};
+}
+
+void UUIDIndex::onConstruct(entt::registry& registry, entt::entity entity) {
+    const UUID uuid  = registry.get<IDComponent>(entity).id;
+    const auto index = entt::to_entity(entity);
+    if (index >= mUUIDs.size()) {
+        mUUIDs.resize(index + 1);
+    }
+    mUUIDs[index] = uuid;
+
+    // A UUID already used keep it entity, the index does not switch silently to the new one.
+    [[maybe_unused]] const auto [it, inserted] = mEntities.try_emplace(uuid, entity);
+    assert(inserted && "The UUID is already used by another entity.");
+}
+
+void UUIDIndex::onUpdate(entt::registry& registry, entt::entity entity) {
+    erase(entity);
+    onConstruct(registry, entity);
+}
+
+void UUIDIndex::onDestroy(entt::registry& /*registry*/, entt::entity entity) {
+    erase(entity);
+    mUUIDs[entt::to_entity(entity)] = UUID();
+}
+
+void UUIDIndex::erase(entt::entity entity) {
+    const auto it = mEntities.find(mUUIDs[entt::to_entity(entity)]);
+    if (it != mEntities.end() && it->second == entity) {
+        mEntities.erase(it);
+    }
+}
+
+} // namespace fuse
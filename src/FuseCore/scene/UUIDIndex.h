@@ -0,0 +1,46 @@
+#pragma once
+#include <FuseCore/utils/UUID.h>
+
+#include <entt/container/dense_map.hpp>
+#include <entt/entity/entity.hpp>
+#include <entt/entity/registry.hpp>
+
+#include <vector>
+
+namespace fuse {
+
+/// @brief Hash index to retrieve an entity from the UUID of it IDComponent.
+///
+/// The index is updated from the construct/update/destroy signals of the IDComponent storage.
+/// Entries are stored in a dense map, inserting an entity does not allocate a node. The UUID
+/// of each entity is kept, so the previous UUID is removed when a IDComponent is replaced.
+/// The UUIDs must be unique: a UUID already used stay mapped to the first entity (asserted).
+class UUIDIndex {
+public:
+    UUIDIndex() = default;
+
+    /// @brief Connect the index to the IDComponent signals of a registry.
+    /// @param registry The registry to track.
+    void connect(entt::registry& registry);
+
+    /// @brief Find the entity with the given UUID.
+    /// @param uuid The UUID of the entity to find.
+    /// @return The entity or entt::null if not found.
+    [[nodiscard]] entt::entity find(UUID uuid) const noexcept;
+
+    /// @brief Get the number of entries in the index.
+    [[nodiscard]] std::size_t size() const noexcept { return mEntities.size(); }
+
+private:
+    void onConstruct(entt::registry& registry, entt::entity entity);
+    void onUpdate(entt::registry& registry, entt::entity entity);
+    void onDestroy(entt::registry& registry, entt::entity entity);
+
+    /// @brief Remove the UUID indexed for a entity.
+    void erase(entt::entity entity);
+
+    entt::dense_map<UUID, entt::entity, std::hash<UUID>> mEntities; ///< Entity of each UUID.
+    std::vector<UUID> mUUIDs; ///< UUID indexed for each entity, by entity index.
+};
+
+} // namespace fuse
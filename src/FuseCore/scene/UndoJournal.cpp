@@ -0,0 +1,175 @@
+#include "UndoJournal.h"
+
+#include <algorithm>
+#include <ranges>
+
+namespace fuse {
+
+UndoJournal::UndoJournal(std::size_t memoryBudget) {
+    mChunks.resize(std::max<std::size_t>(1, memoryBudget / kChunkSize));
+}
+
+UndoJournal::~UndoJournal() { clear(); }
+
+void UndoJournal::beginGroup(std::uint64_t mergeKey) {
+    if (mGroupDepth++ == 0) {
+        mDiscard = false;
+        beginEntry(mergeKey);
+    }
+}
+
+void UndoJournal::endGroup() {
+    assert(mGroupDepth > 0 && "endGroup() called without beginGroup().");
+    if (--mGroupDepth > 0) {
+        return;
+    }
+
+    // A group without change does not create a entry.
+    if (!mDiscard && !mMerging && mEntries.back().begin == mEntries.back().end) {
+        mEntries.pop_back();
+        mUndoCount = mEntries.size();
+        mMergeOpen = false;
+    }
+    mDiscard = false;
+}
+
+bool UndoJournal::undo(entt::registry& registry) {
+    assert(mGroupDepth == 0 && "Cannot undo while recording a group.");
+    closeMerge();
+    if (!canUndo()) {
+        return false;
+    }
+
+    // The changes are undone in reverse order, the first value before is restored last.
+    collectRecords(mEntries[--mUndoCount]);
+    for (RecordHeader* header : std::views::reverse(mRecords)) {
+        header->ops->apply(registry, header->entity, getValue(header));
+    }
+    return true;
+}
+
+bool UndoJournal::redo(entt::registry& registry) {
+    assert(mGroupDepth == 0 && "Cannot redo while recording a group.");
+    closeMerge();
+    if (!canRedo()) {
+        return false;
+    }
+
+    collectRecords(mEntries[mUndoCount++]);
+    for (RecordHeader* header : mRecords) {
+        header->ops->apply(registry, header->entity, getValue(header) + header->ops->size);
+    }
+    return true;
+}
+
+void UndoJournal::clear() {
+    for (const Entry& entry : mEntries) {
+        destroyRecords(entry);
+    }
+    mEntries.clear();
+    mUndoCount = 0;
+    mTail      = mHead;
+    mMergeOpen = false;
+    mMerging   = false;
+    mDiscard   = mGroupDepth > 0;
+}
+
+UndoJournal::RecordHeader* UndoJournal::getRecord(std::uint64_t position) noexcept {
+    auto& chunk = mChunks[(position / kChunkSize) % mChunks.size()];
+    if (!chunk) {
+        chunk = std::make_unique_for_overwrite<std::byte[]>(kChunkSize);
+    }
+    return reinterpret_cast<RecordHeader*>(chunk.get() + position % kChunkSize);
+}
+
+UndoJournal::RecordHeader* UndoJournal::findRecord(const RecordOps* ops, entt::entity entity) {
+    // The changes of a drag are recorded in the same order each frame, the search start
+    // after the last record found.
+    const Entry& entry  = mEntries.back();
+    const auto   search = [&](std::uint64_t begin, std::uint64_t end) -> RecordHeader* {
+        for (std::uint64_t position = begin; position < end;) {
+            RecordHeader* header = getRecord(position);
+            position += header->size;
+            if (header->ops == ops && header->entity == entity) {
+                mMergeCursor = position;
+                return header;
+            }
+        }
+        return nullptr;
+    };
+    RecordHeader* header = search(mMergeCursor, entry.end);
+    return header ? header : search(entry.begin, mMergeCursor);
+}
+
+void UndoJournal::beginEntry(std::uint64_t mergeKey) {
+    mMerging = mergeKey != 0 && mMergeOpen && canUndo() && !canRedo() &&
+               mEntries.back().mergeKey == mergeKey;
+    if (!mMerging) {
+        dropRedo();
+        mEntries.push_back({.begin = mHead, .end = mHead, .mergeKey = mergeKey});
+        mUndoCount   = mEntries.size();
+        mMergeOpen   = mergeKey != 0;
+        mMergeCursor = mHead;
+    }
+}
+
+UndoJournal::RecordHeader* UndoJournal::allocate(std::size_t size) {
+    // A record does not cross the end of a chunk.
+    const std::size_t offset  = mHead % kChunkSize;
+    const std::size_t padding = offset + size > kChunkSize ? kChunkSize - offset : 0;
+
+    // Drop the oldest entries to make room.
+    while (mHead + padding + size - mTail > getMemoryBudget()) {
+        if (mEntries.size() == 1) {
+            // The entry being recorded does not fit alone, it cannot be undone.
+            clear();
+            return nullptr;
+        }
+        destroyRecords(mEntries.front());
+        mEntries.pop_front();
+        mUndoCount--;
+        mTail = mEntries.front().begin;
+    }
+
+    if (padding > 0) {
+        *getRecord(mHead) = {
+          .ops = nullptr, .entity = entt::null, .size = static_cast<std::uint32_t>(padding)};
+        mHead += padding;
+    }
+    RecordHeader* header = getRecord(mHead);
+    mHead += size;
+    mEntries.back().end = mHead;
+    return header;
+}
+
+void UndoJournal::collectRecords(const Entry& entry) {
+    mRecords.clear();
+    for (std::uint64_t position = entry.begin; position < entry.end;) {
+        RecordHeader* header = getRecord(position);
+        position += header->size;
+        if (header->ops) {
+            mRecords.push_back(header);
+        }
+    }
+}
+
+void UndoJournal::destroyRecords(const Entry& entry) {
+    for (std::uint64_t position = entry.begin; position < entry.end;) {
+        RecordHeader* header = getRecord(position);
+        position += header->size;
+        if (header->ops && header->ops->destroy) {
+            header->ops->destroy(getValue(header));
+            header->ops->destroy(getValue(header) + header->ops->size);
+        }
+    }
+}
+
+void UndoJournal::dropRedo() {
+    while (canRedo()) {
+        destroyRecords(mEntries.back());
+        mEntries.pop_back();
+    }
+    mHead = mEntries.empty() ? mTail : mEntries.back().end;
+}
+
+} // namespace fuse
@@ -0,0 +1,252 @@
+#pragma once
+#include <entt/entity/entity.hpp>
+#include <entt/entity/registry.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Undo/redo history of the changes of the components.
+///
+/// Each change keep the value of the component before and after it. The trivially copyable
+/// components are stored as bytes, the others are copy constructed. The changes are written
+/// one after the other into a ring of fixed size chunks (allocated once, up to the memory
+/// budget), the oldest entries are dropped to make room for the new ones, so recording a
+/// change does not allocate memory.
+///
+/// An entry is a group of changes undone in one step:
+/// - the changes recorded between beginGroup() and endGroup() form one entry, for the bulk
+///   operations over many entities;
+/// - the consecutive changes (or groups) with the same merge key form one entry, only the
+///   first value before and the last value after of each component are kept (a drag of a
+///   field, over one or many entities).
+///
+/// Undoing or redoing replace the components with EnTT, the update signals are sent. The
+/// entities destroyed and the components removed since the change are ignored.
+class UndoJournal {
+public:
+    static constexpr std::size_t kChunkSize     = 64 * 1024;        ///< Size of a arena chunk.
+    static constexpr std::size_t kDefaultBudget = 16 * 1024 * 1024; ///< Default memory budget.
+
+    /// @brief Create a empty journal.
+    /// @param memoryBudget The maximum memory used by the changes, at least one chunk.
+    explicit UndoJournal(std::size_t memoryBudget = kDefaultBudget);
+    ~UndoJournal();
+
+    UndoJournal(const UndoJournal&)            = delete;
+    UndoJournal(UndoJournal&&)                 = delete;
+    UndoJournal& operator=(const UndoJournal&) = delete;
+    UndoJournal& operator=(UndoJournal&&)      = delete;
+
+    /// @brief Start a group, the changes until endGroup() are undone in one step.
+    ///
+    /// The groups can be nested, only the outer group create a entry.
+    /// @param mergeKey Merge the group into the previous entry if it has the same key and
+    ///                 closeMerge() was not called since, zero to never merge. The merge keys
+    ///                 of the changes recorded in the group are ignored.
+    void beginGroup(std::uint64_t mergeKey = 0);
+
+    /// @brief End the group started by beginGroup().
+    void endGroup();
+
+    /// @brief Record the change of a component.
+    ///
+    /// The component must already have the value @p after, record() does not modify it.
+    /// The redo history is dropped.
+    /// @tparam Component The type of the component.
+    /// @param entity The entity owning the component.
+    /// @param before The value of the component before the change.
+    /// @param after The value of the component after the change.
+    /// @param mergeKey Merge the change into the previous entry if it has the same key and
+    ///                 closeMerge() was not called since, zero to never merge. Ignored in a
+    ///                 group.
+    template <class Component>
+    void record(entt::entity     entity,
+                const Component& before,
+                const Component& after,
+                std::uint64_t    mergeKey = 0);
+
+    /// @brief Stop merging the next changes into the last entry (the drag ended).
+    void closeMerge() noexcept { mMergeOpen = false; }
+
+    /// @brief Undo the last entry.
+    /// @param registry The registry of the entities.
+    /// @return False if there was nothing to undo.
+    bool undo(entt::registry& registry);
+
+    /// @brief Redo the last entry undone.
+    /// @param registry The registry of the entities.
+    /// @return False if there was nothing to redo.
+    bool redo(entt::registry& registry);
+
+    /// @brief Remove all the entries.
+    void clear();
+
+    /// @brief Check if a entry can be undone.
+    [[nodiscard]] bool canUndo() const noexcept { return mUndoCount > 0; }
+
+    /// @brief Check if a entry can be redone.
+    [[nodiscard]] bool canRedo() const noexcept { return mUndoCount < mEntries.size(); }
+
+    /// @brief Get the number of entries which can be undone.
+    [[nodiscard]] std::size_t getUndoCount() const noexcept { return mUndoCount; }
+
+    /// @brief Get the number of entries which can be redone.
+    [[nodiscard]] std::size_t getRedoCount() const noexcept {
+        return mEntries.size() - mUndoCount;
+    }
+
+    /// @brief Get the memory used by the entries, in bytes.
+    [[nodiscard]] std::size_t getMemoryUsage() const noexcept {
+        return static_cast<std::size_t>(mHead - mTail);
+    }
+
+    /// @brief Get the maximum memory used by the entries, in bytes.
+    [[nodiscard]] std::size_t getMemoryBudget() const noexcept {
+        return mChunks.size() * kChunkSize;
+    }
+
+private:
+    /// @brief Operations of a type of component, shared by it records.
+    struct RecordOps {
+        void (*apply)(entt::registry& registry, entt::entity entity, const void* value);
+        void (*assign)(void* destination, const void* source);
+        void (*destroy)(void* value); ///< nullptr for the trivially destructible components.
+        std::uint32_t size;           ///< Size of the component.
+    };
+
+    /// @brief Start of a change, followed by the value before then the value after.
+    ///
+    /// A header without operations pad the end of a chunk.
+    struct alignas(std::max_align_t) RecordHeader {
+        const RecordOps* ops;
+        entt::entity     entity;
+        std::uint32_t    size; ///< Size of the record, header included.
+    };
+
+    /// @brief A group of changes undone in one step.
+    struct Entry {
+        std::uint64_t begin;    ///< Position of the first record.
+        std::uint64_t end;      ///< Position after the last record.
+        std::uint64_t mergeKey; ///< Key of the merged changes, zero for none.
+    };
+
+    template <class Component>
+    static const RecordOps kRecordOps;
+
+    /// @brief Get the value before of a record, the value after follow it.
+    [[nodiscard]] static std::byte* getValue(RecordHeader* header) noexcept {
+        return reinterpret_cast<std::byte*>(header) + sizeof(RecordHeader);
+    }
+
+    /// @brief Get the record at a position.
+    [[nodiscard]] RecordHeader* getRecord(std::uint64_t position) noexcept;
+
+    /// @brief Find the record of a component in the last entry, to merge a change.
+    [[nodiscard]] RecordHeader* findRecord(const RecordOps* ops, entt::entity entity);
+
+    /// @brief Create the entry receiving the next records, or reuse the last one to merge.
+    ///
+    /// mMerging is set if the last entry is reused.
+    void beginEntry(std::uint64_t mergeKey);
+
+    /// @brief Reserve memory for a record at the end of the last entry.
+    /// @return nullptr if the record does not fit in the budget.
+    RecordHeader* allocate(std::size_t size);
+
+    /// @brief Collect the records of a entry into mRecords.
+    void collectRecords(const Entry& entry);
+
+    /// @brief Destroy the records of a entry.
+    void destroyRecords(const Entry& entry);
+
+    /// @brief Drop the entries which can be redone.
+    void dropRedo();
+
+    std::vector<std::unique_ptr<std::byte[]>> mChunks;        ///< Ring of chunks, allocated lazily.
+    std::uint64_t                             mHead{};        ///< Position of the next record.
+    std::uint64_t                             mTail{};        ///< Position of the oldest record.
+    std::deque<Entry>                         mEntries;       ///< Oldest entry first.
+    std::size_t                               mUndoCount{};   ///< The entries before can be undone.
+    std::uint32_t                             mGroupDepth{};  ///< Number of groups not ended.
+    bool                                      mMergeOpen{};   ///< The last entry can be merged.
+    bool                                      mMerging{};     ///< The last entry is being merged.
+    bool                                      mDiscard{};     ///< The group is over the budget.
+    std::uint64_t                             mMergeCursor{}; ///< Record after the last merged one.
+    std::vector<RecordHeader*>                mRecords;       ///< Records being undone or redone.
+};
+
+template <class Component>
+const UndoJournal::RecordOps UndoJournal::kRecordOps = {
+  .apply =
+    [](entt::registry& registry, entt::entity entity, const void* value) {
+        if (registry.valid(entity) && registry.all_of<Component>(entity)) {
+            registry.replace<Component>(entity, *static_cast<const Component*>(value));
+        }
+    },
+  .assign =
+    [](void* destination, const void* source) {
+        if constexpr (std::is_trivially_copyable_v<Component>) {
+            std::memcpy(destination, source, sizeof(Component));
+        } else {
+            *static_cast<Component*>(destination) = *static_cast<const Component*>(source);
+        }
+    },
+  .destroy = std::is_trivially_destructible_v<Component>
+               ? nullptr
+               : +[](void* value) { std::destroy_at(static_cast<Component*>(value)); },
+  .size    = static_cast<std::uint32_t>(sizeof(Component)),
+};
+
+template <class Component>
+void UndoJournal::record(entt::entity     entity,
+                         const Component& before,
+                         const Component& after,
+                         std::uint64_t    mergeKey) {
+    static_assert(!std::is_empty_v<Component>, "A empty component does not have value.");
+    static_assert(alignof(Component) <= alignof(RecordHeader));
+    const RecordOps* ops = &kRecordOps<Component>;
+
+    if (mGroupDepth == 0) {
+        beginEntry(mergeKey);
+    } else if (mDiscard) {
+        return;
+    }
+    if (mMerging) {
+        if (RecordHeader* header = findRecord(ops, entity)) {
+            ops->assign(getValue(header) + sizeof(Component), &after);
+            return;
+        }
+    }
+
+    constexpr std::size_t recordSize =
+      (sizeof(RecordHeader) + 2 * sizeof(Component) + alignof(RecordHeader) - 1) /
+      alignof(RecordHeader) * alignof(RecordHeader);
+    static_assert(recordSize <= kChunkSize, "The component is too large for the journal.");
+    RecordHeader* header = allocate(recordSize);
+    if (!header) {
+        return;
+    }
+    header->ops    = ops;
+    header->entity = entity;
+    header->size   = static_cast<std::uint32_t>(recordSize);
+
+    std::byte* value = getValue(header);
+    if constexpr (std::is_trivially_copyable_v<Component>) {
+        std::memcpy(value, &before, sizeof(Component));
+        std::memcpy(value + sizeof(Component), &after, sizeof(Component));
+    } else {
+        std::construct_at(reinterpret_cast<Component*>(value), before);
+        std::construct_at(reinterpret_cast<Component*>(value + sizeof(Component)), after);
+    }
+}
+
+} // namespace fuse
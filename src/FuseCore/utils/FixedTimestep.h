@@ -0,0 +1,78 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace fuse {
+
+/// @brief Accumulate the frame time and split it into simulation steps of fixed duration.
+///
+/// Each frame, advance() return the number of steps to simulate. The time left in the
+/// accumulator give the interpolation factor between the two latest simulation states.
+/// The number of steps per frame is bounded, when the simulation can't keep up the
+/// extra time is dropped instead of accumulating forever (spiral of death).
+///
+/// @code
+/// const unsigned steps = timestep.advance(deltaTime);
+/// for (unsigned i = 0; i < steps; i++) {
+///     simulate(timestep.getStep());
+/// }
+/// render(timestep.getAlpha());
+/// @endcode
+class FixedTimestep {
+public:
+    /// @brief Construct a fixed timestep.
+    /// @param rate The number of steps per second.
+    /// @param maxSteps The maximum number of steps per frame.
+    explicit FixedTimestep(float rate = 60.0f, unsigned maxSteps = 5) noexcept
+        : mStep(1.0f / rate)
+        , mMaxSteps(maxSteps) {
+        assert(rate > 0.0f && maxSteps > 0);
+    }
+
+    /// @brief Add the time of a frame.
+    /// @param deltaTime The frame time in seconds. Negative time is ignored.
+    /// @return The number of steps to simulate this frame.
+    unsigned advance(float deltaTime) noexcept {
+        mAccumulator += std::max(deltaTime, 0.0f);
+
+        const auto steps = static_cast<unsigned>(
+          std::min(std::floor(mAccumulator / mStep), static_cast<float>(mMaxSteps)));
+        mAccumulator -= static_cast<float>(steps) * mStep;
+
+        // too far behind, drop the time the simulation can't catch up.
+        if (steps == mMaxSteps && mAccumulator >= mStep) {
+            const float remainder = std::fmod(mAccumulator, mStep);
+            mDroppedTime += mAccumulator - remainder;
+            mAccumulator = remainder;
+        }
+        return steps;
+    }
+
+    /// @brief Get the duration of a step in seconds.
+    [[nodiscard]] float getStep() const noexcept { return mStep; }
+
+    /// @brief Get the maximum number of steps per frame.
+    [[nodiscard]] unsigned getMaxSteps() const noexcept { return mMaxSteps; }
+
+    /// @brief Get the interpolation factor between the previous and the current state.
+    /// @return The fraction of a step left in the accumulator in range [0, 1).
+    [[nodiscard]] float getAlpha() const noexcept { return mAccumulator / mStep; }
+
+    /// @brief Get the total time dropped because the simulation was too slow.
+    [[nodiscard]] float getDroppedTime() const noexcept { return mDroppedTime; }
+
+    /// @brief Reset the accumulated and dropped time.
+    void reset() noexcept {
+        mAccumulator = 0.0f;
+        mDroppedTime = 0.0f;
+    }
+
+private:
+    float    mStep;          ///< Duration of a step in seconds.
+    unsigned mMaxSteps;      ///< Maximum number of steps per frame.
+    float    mAccumulator{}; ///< Time not yet simulated.
+    float    mDroppedTime{}; ///< Time dropped to avoid the spiral of death.
+};
+
+} // namespace fuse
@@ -0,0 +1,109 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace fuse {
+
+/// @brief Bounded lock-free queue, written by many threads and read by one thread.
+///
+/// Each cell has a sequence number telling if it is free for the producer of a position or
+/// ready for the consumer (bounded queue of D. Vyukov). A producer reserve a position with a
+/// compare-exchange on the head then write the value directly in the cell, it never wait:
+/// tryPush() fail when the ring is full. The consumer read the values in place.
+///
+/// @code
+/// ring.tryPush([&](Message& message) { message = makeMessage(); }); // any thread
+/// ring.drain([](const Message& message) { use(message); });          // one thread
+/// @endcode
+/// @tparam T The type of the values, default constructible.
+template <class T>
+class MpscRing {
+public:
+    /// @brief Create a empty ring.
+    /// @param capacity The number of values, a power of two.
+    explicit MpscRing(std::size_t capacity)
+        : mCells(std::make_unique<Cell[]>(capacity))
+        , mMask(capacity - 1) {
+        assert(std::has_single_bit(capacity) && "The capacity must be a power of two.");
+        for (std::size_t i = 0; i < capacity; i++) {
+            mCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&)            = delete;
+    MpscRing(MpscRing&&)                 = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+    MpscRing& operator=(MpscRing&&)      = delete;
+
+    /// @brief Add a value, from any thread.
+    /// @param writer Called with the value to fill, `void(T&)`. The value may hold the data
+    ///               of a previous push.
+    /// @return False if the ring is full, the writer is not called.
+    template <class Writer>
+    bool tryPush(Writer&& writer) {
+        std::uint64_t position = mHead.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell&               cell     = mCells[position & mMask];
+            const std::uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto          distance = static_cast<std::int64_t>(sequence - position);
+            if (distance == 0) {
+                if (mHead.compare_exchange_weak(
+                      position, position + 1, std::memory_order_relaxed)) {
+                    writer(cell.value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (distance < 0) {
+                return false; // the consumer did not read the cell yet
+            } else {
+                position = mHead.load(std::memory_order_relaxed); // taken by another producer
+            }
+        }
+    }
+
+    /// @brief Read the values pushed, oldest first. Only called from the consumer thread.
+    ///
+    /// A value pushed while draining may be read or left for the next drain.
+    /// @param reader Called with each value, `void(const T&)`.
+    /// @param maxCount The maximum number of values to read.
+    /// @return The number of values read.
+    template <class Reader>
+    std::size_t drain(Reader&&    reader,
+                      std::size_t maxCount = std::numeric_limits<std::size_t>::max()) {
+        std::size_t count = 0;
+        for (; count < maxCount; count++) {
+            Cell& cell = mCells[mTail & mMask];
+            if (cell.sequence.load(std::memory_order_acquire) != mTail + 1) {
+                break; // empty, or the producer is still writing the value
+            }
+            reader(static_cast<const T&>(cell.value));
+            cell.sequence.store(mTail + mMask + 1, std::memory_order_release);
+            mTail++;
+        }
+        return count;
+    }
+
+    /// @brief Get the maximum number of values in the ring.
+    [[nodiscard]] std::size_t getCapacity() const noexcept { return mMask + 1; }
+
+private:
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    /// @brief A value, on its own cache lines to not be shared between two producers.
+    struct alignas(kCacheLineSize) Cell {
+        std::atomic<std::uint64_t> sequence; ///< Position + 1 when the value is ready.
+        T                          value;
+    };
+
+    std::unique_ptr<Cell[]>                          mCells;
+    std::size_t                                      mMask;
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> mHead{}; ///< Next position to write.
+    alignas(kCacheLineSize) std::uint64_t              mTail{}; ///< Next position to read.
+};
+
+} // namespace fuse
@@ -0,0 +1,123 @@
+#include "StringInterner.h"
+
+#include <cassert>
+#include <cstring>
+#include <functional>
+
+namespace {
+
+constexpr std::size_t kBlockSize       = 64 * 1024; ///< Size of a arena block in bytes.
+constexpr std::size_t kInitialCapacity = 1024;      ///< Initial number of slots of the hash table.
+
+std::uint32_t hashString(std::string_view str) noexcept {
+    return static_cast<std::uint32_t>(std::hash<std::string_view>{}(str));
+}
+
+} // namespace
+
+namespace fuse {
+
+StringInterner::StringInterner()
+    : mBlockUsed(kBlockSize)         // force a new block on the first allocation
+    , mEntries(1, Entry{"", 0, 0}) { // index 0 is reserved for invalid id
+}
+
+StringId StringInterner::intern(std::string_view str) {
+    if (str.empty()) {
+        return {};
+    }
+
+    // keep the load factor under 50%
+    if ((mEntries.size() + 1) * 2 > mTable.size()) {
+        grow();
+    }
+
+    const auto hash = hashString(str);
+    const auto slot = findSlot(str, hash);
+    if (mTable[slot] != 0) {
+        return StringId(mTable[slot]);
+    }
+
+    const auto index = static_cast<std::uint32_t>(mEntries.size());
+    mEntries.push_back({allocate(str), static_cast<std::uint32_t>(str.size()), hash});
+    mTable[slot] = index;
+    return StringId(index);
+}
+
+StringId StringInterner::find(std::string_view str) const noexcept {
+    if (str.empty() || mTable.empty()) {
+        return {};
+    }
+    return StringId(mTable[findSlot(str, hashString(str))]);
+}
+
+std::string_view StringInterner::resolve(StringId id) const noexcept {
+    if (!id.isValid() || id.value() >= mEntries.size()) {
+        return {};
+    }
+    const Entry& entry = mEntries[id.value()];
+    return {entry.data, entry.size};
+}
+
+void StringInterner::clear() noexcept {
+    mBlocks.clear();
+    mBlockUsed = kBlockSize; // force a new block on the next allocation
+    mEntries.resize(1);      // keep the reserved invalid entry
+    mTable.clear();
+    mGeneration++;
+}
+
+std::size_t StringInterner::findSlot(std::string_view str, std::uint32_t hash) const noexcept {
+    assert(!mTable.empty());
+    const std::size_t mask = mTable.size() - 1;
+    for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        const auto index = mTable[slot];
+        if (index == 0) {
+            return slot;
+        }
+        const Entry& entry = mEntries[index];
+        if (entry.hash == hash && std::string_view(entry.data, entry.size) == str) {
+            return slot;
+        }
+    }
+}
+
+const char* StringInterner::allocate(std::string_view str) {
+    const std::size_t size = str.size() + 1; // null-terminated
+    char*             dst  = nullptr;
+    if (size > kBlockSize) {
+        // Large string get a dedicated block. Insert it before the current block
+        // so the remaining space of the current block is still used.
+        auto block = std::make_unique_for_overwrite<char[]>(size);
+        dst        = block.get();
+        mBlocks.insert(mBlocks.empty() ? mBlocks.end() : std::prev(mBlocks.end()),
+                       std::move(block));
+    } else {
+        if (mBlockUsed + size > kBlockSize) {
+            mBlocks.push_back(std::make_unique_for_overwrite<char[]>(kBlockSize));
+            mBlockUsed = 0;
+        }
+        dst = mBlocks.back().get() + mBlockUsed;
+        mBlockUsed += size;
+    }
+    std::memcpy(dst, str.data(), str.size());
+    dst[str.size()] = '\0';
+    return dst;
+}
+
+void StringInterner::grow() {
+    const std::size_t newCapacity = mTable.empty() ? kInitialCapacity : mTable.size() * 2;
+    mTable.assign(newCapacity, 0);
+
+    // re-insert all entries, the hash is cached so no string comparison is needed.
+    const std::size_t mask = newCapacity - 1;
+    for (std::uint32_t index = 1; index < mEntries.size(); index++) {
+        std::size_t slot = mEntries[index].hash & mask;
+        while (mTable[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        mTable[slot] = index;
+    }
+}
+
+} // namespace fuse
@@ -0,0 +1,96 @@
+#pragma once
+#include <compare>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Handle to a string stored into a StringInterner.
+///
+/// A default constructed StringId is invalid and resolve to an empty string.
+/// Two StringId from the same interner are equal if and only if their strings are equal.
+class StringId {
+public:
+    /// @brief Default constructor. Create a invalid id.
+    constexpr StringId() noexcept = default;
+
+    /// @brief Create a id from it raw value.
+    /// @param value The raw value of the id (0 is invalid).
+    constexpr explicit StringId(std::uint32_t value) noexcept
+        : mValue(value) {}
+
+    auto operator<=>(const StringId&) const = default;
+
+    /// @brief Checks if the id refers to a interned string.
+    [[nodiscard]] constexpr bool isValid() const noexcept { return mValue != 0; }
+
+    /// @brief Get the raw value of the id.
+    [[nodiscard]] constexpr std::uint32_t value() const noexcept { return mValue; }
+
+private:
+    std::uint32_t mValue{};
+};
+
+/// @brief Store unique copy of strings and give back a small handle to it.
+///
+/// Strings are copied into large blocks (arena) and indexed by hash, so interning a
+/// string already known does not allocate. Interned strings are null-terminated
+/// and stay valid until clear() is called or the interner is destroyed.
+class StringInterner {
+public:
+    /// @brief Default constructor. Create a empty interner.
+    StringInterner();
+
+    ~StringInterner() = default;
+
+    StringInterner(const StringInterner&)            = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+    StringInterner(StringInterner&&)                 = default;
+    StringInterner& operator=(StringInterner&&)      = default;
+
+    /// @brief Intern a string.
+    /// @param str The string to intern.
+    /// @return The id of the string. An empty string return an invalid id.
+    StringId intern(std::string_view str);
+
+    /// @brief Find the id of a string without interning it.
+    /// @param str The string to find.
+    /// @return The id of the string or an invalid id if the string is not interned.
+    [[nodiscard]] StringId find(std::string_view str) const noexcept;
+
+    /// @brief Retrieve the string of an id.
+    /// @param id The id to resolve.
+    /// @return The interned string (null-terminated) or an empty string for an invalid id.
+    [[nodiscard]] std::string_view resolve(StringId id) const noexcept;
+
+    /// @brief Get the number of unique strings interned.
+    [[nodiscard]] std::size_t size() const noexcept { return mEntries.size() - 1; }
+
+    /// @brief Get the number of calls to clear(), the ids of a generation are not valid in
+    ///        the next ones.
+    [[nodiscard]] std::uint32_t getGeneration() const noexcept { return mGeneration; }
+
+    /// @brief Remove all strings. All previous ids and string_view become invalid.
+    void clear() noexcept;
+
+private:
+    struct Entry {
+        const char*   data;
+        std::uint32_t size;
+        std::uint32_t hash;
+    };
+
+    [[nodiscard]] std::size_t findSlot(std::string_view str, std::uint32_t hash) const noexcept;
+    const char*               allocate(std::string_view str);
+    void                      grow();
+
+    std::vector<std::unique_ptr<char[]>> mBlocks;        ///< Arena blocks holding the characters.
+    std::size_t                          mBlockUsed{};   ///< Number of bytes used in the last block.
+    std::vector<Entry>                   mEntries;       ///< Interned strings, index 0 is invalid.
+    std::vector<std::uint32_t>           mTable;         ///< Open-addressing table of entry index.
+    std::uint32_t                        mGeneration{};  ///< Incremented by clear().
+};
+
+} // namespace fuse
@@ -0,0 +1,50 @@
+#include "UUID.h"
+
+#if defined(FUSE_PLATFORM_LINUX)
+#include <sys/random.h>
+#endif
+
+#include <random>
+
+namespace {
+
+/// @brief Get a random seed from the operating system.
+std::uint64_t getRandomSeed() noexcept {
+    std::uint64_t seed{};
+#if defined(FUSE_PLATFORM_LINUX)
+    if (getrandom(&seed, sizeof(seed), 0) == sizeof(seed)) {
+        return seed;
+    }
+#endif
+    std::random_device device;
+    seed = (static_cast<std::uint64_t>(device()) << 32U) | device();
+    return seed;
+}
+
+/// @brief SplitMix64 generator.
+///
+/// Each thread start at a random position of the 2^64 period, so sequences
+/// of different threads are very unlikely to overlap.
+/// See https://prng.di.unimi.it/splitmix64.c
+std::uint64_t nextRandom() noexcept {
+    thread_local std::uint64_t state = getRandomSeed();
+
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z               = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z               = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+}
+
+} // namespace
+
+namespace fuse {
+
+UUID UUID::Generate() noexcept {
+    std::uint64_t value = nextRandom();
+    while (value == 0) { // 0 is reserved for invalid UUID
+        value = nextRandom();
+    }
+    return UUID(value);
+}
+
+} // namespace fuse
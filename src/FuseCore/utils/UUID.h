@@ -1,11 +1,70 @@
 #pragma once
+#include <compare>
+#include <cstdint>
+#include <format>
+#include <functional>
 
 namespace fuse {
 
+/// @brief 64 bits universally unique identifier.
+///
+/// A UUID identify an entity across runs (serialization, network, ...).
+/// New UUID are generated from a thread-local generator seeded from the
+/// operating system entropy, so generation is lock-free and does not allocate.
+/// A default constructed UUID is invalid (0).
 class UUID {
 public:
+    /// @brief Default constructor. Create an invalid UUID.
+    constexpr UUID() noexcept = default;
+
+    /// @brief Create a UUID from it raw value (e.g. when deserializing).
+    /// @param value The raw value of the UUID.
+    constexpr explicit UUID(std::uint64_t value) noexcept
+        : mValue(value) {}
+
+    auto operator<=>(const UUID&) const = default;
+
+    /// @brief Generate a new random UUID.
+    /// @return A new valid UUID.
+    /// @note Thread-safe.
+    [[nodiscard]] static UUID Generate() noexcept;
+
+    /// @brief Checks if the UUID is valid (not zero).
+    [[nodiscard]] constexpr bool isValid() const noexcept { return mValue != 0; }
+
+    /// @brief Get the raw value of the UUID.
+    [[nodiscard]] constexpr std::uint64_t value() const noexcept { return mValue; }
 
 private:
+    std::uint64_t mValue{};
 };
 
 } // namespace fuse
+
+namespace std {
+
+/// @related fuse::UUID
+template <>
+struct hash<fuse::UUID> {
+    std::size_t operator()(const fuse::UUID& uuid) const noexcept {
+        // The value is already random, no need to hash it.
+        return static_cast<std::size_t>(uuid.value());
+    }
+};
+
+/// @related fuse::UUID
+template <>
+struct formatter<fuse::UUID> {
+
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext& ctx) {
+        return ctx.begin();
+    }
+
+    template <typename FormatContext>
+    auto format(const fuse::UUID& uuid, FormatContext& ctx) const {
+        return format_to(ctx.out(), "{:016x}", uuid.value());
+    }
+};
+
+} // namespace std
@@ -0,0 +1,63 @@
+#include "WorkerPool.h"
+
+namespace fuse {
+
+WorkerPool::WorkerPool(unsigned threadCount) {
+    const unsigned workerCount = std::max(threadCount, 1U) - 1;
+    mThreads.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; i++) {
+        mThreads.emplace_back([this](std::stop_token stopToken) { workerLoop(stopToken); });
+    }
+}
+
+void WorkerPool::dispatch(std::size_t taskCount, TaskFunction function, void* context) {
+    const Job job{.function = function, .context = context, .taskCount = taskCount};
+    if (taskCount <= 1 || mThreads.empty()) {
+        for (std::size_t task = 0; task < taskCount; task++) {
+            function(context, task);
+        }
+        return;
+    }
+
+    {
+        const std::scoped_lock lock(mMutex);
+        mJob = job;
+        mNextTask.store(0, std::memory_order_relaxed);
+        mIsOpen = true;
+        mGeneration++;
+    }
+    mWakeUp.notify_all();
+    runTasks(job);
+
+    // All the tasks are taken, close the job so a late worker does not join it, then wait
+    // for the workers still running a task.
+    std::unique_lock lock(mMutex);
+    mIsOpen = false;
+    mDone.wait(lock, [this] { return mActiveCount == 0; });
+}
+
+void WorkerPool::runTasks(const Job& job) noexcept {
+    std::size_t task = mNextTask.fetch_add(1, std::memory_order_relaxed);
+    while (task < job.taskCount) {
+        job.function(job.context, task);
+        task = mNextTask.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void WorkerPool::workerLoop(const std::stop_token& stopToken) {
+    std::uint64_t    generation = 0;
+    std::unique_lock lock(mMutex);
+    while (mWakeUp.wait(lock, stopToken, [&] { return mIsOpen && mGeneration != generation; })) {
+        generation    = mGeneration;
+        const Job job = mJob;
+        mActiveCount++;
+        lock.unlock();
+        runTasks(job);
+        lock.lock();
+        if (--mActiveCount == 0) {
+            mDone.notify_one();
+        }
+    }
+}
+
+} // namespace fuse
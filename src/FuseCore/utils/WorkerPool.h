@@ -0,0 +1,101 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fuse {
+
+/// @brief Persistent threads running the tasks of a parallel loop.
+///
+/// The threads are created once and sleep between the jobs, so a job split across threads
+/// every frame does not pay the creation of the threads. The calling thread run tasks too
+/// and return when all the tasks of the job are done. The tasks are taken in order with a
+/// atomic counter, a job does not allocate memory.
+///
+/// @code
+/// WorkerPool workers;
+/// workers.parallelFor(items.size(), 256, [&](std::size_t begin, std::size_t end) {
+///     process(items.subspan(begin, end - begin));
+/// });
+/// @endcode
+/// @note A job is started by one thread at a time.
+class WorkerPool {
+public:
+    /// @brief Create the threads of the pool.
+    /// @param threadCount The number of threads running the tasks, including the calling
+    ///                    thread: threadCount - 1 threads are created.
+    explicit WorkerPool(unsigned threadCount = std::thread::hardware_concurrency());
+
+    WorkerPool(const WorkerPool&)            = delete;
+    WorkerPool(WorkerPool&&)                 = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&)      = delete;
+
+    /// @brief Get the number of threads running the tasks, including the calling thread.
+    [[nodiscard]] unsigned getThreadCount() const noexcept {
+        return static_cast<unsigned>(mThreads.size()) + 1;
+    }
+
+    /// @brief Call @p task(index) for each index in [0, taskCount), across the threads.
+    /// @param taskCount The number of tasks.
+    /// @param task Called once per task, `void(std::size_t)`, from any thread of the pool.
+    template <class Task>
+    void run(std::size_t taskCount, Task task) {
+        dispatch(taskCount, &invoke<Task>, &task);
+    }
+
+    /// @brief Run @p function(begin, end) over @p count items split in up to
+    ///        getThreadCount() chunks.
+    /// @param count The number of items.
+    /// @param minPerThread The minimum number of items per chunk, a job smaller than that
+    ///                     run on the calling thread only.
+    /// @param function Called once per chunk, `void(std::size_t, std::size_t)`.
+    template <class Function>
+    void parallelFor(std::size_t count, std::size_t minPerThread, Function&& function) {
+        const std::size_t chunkCount = std::clamp<std::size_t>(
+          count / std::max<std::size_t>(minPerThread, 1), 1, getThreadCount());
+        run(chunkCount, [&](std::size_t chunk) {
+            function(count * chunk / chunkCount, count * (chunk + 1) / chunkCount);
+        });
+    }
+
+private:
+    using TaskFunction = void (*)(void* context, std::size_t task);
+
+    /// @brief The job being run.
+    struct Job {
+        TaskFunction function{};
+        void*        context{};
+        std::size_t  taskCount{};
+    };
+
+    template <class Task>
+    static void invoke(void* context, std::size_t task) {
+        (*static_cast<Task*>(context))(task);
+    }
+
+    /// @brief Start a job, run tasks on the calling thread and wait for the end of the job.
+    void dispatch(std::size_t taskCount, TaskFunction function, void* context);
+
+    /// @brief Run the tasks of a job not taken yet.
+    void runTasks(const Job& job) noexcept;
+
+    void workerLoop(const std::stop_token& stopToken);
+
+    std::mutex                  mMutex;
+    std::condition_variable_any mWakeUp;        ///< Signaled when a job start.
+    std::condition_variable     mDone;          ///< Signaled when the last worker leave a job.
+    Job                         mJob;           ///< The current job, protected by mMutex.
+    std::uint64_t               mGeneration{};  ///< Incremented per job, protected by mMutex.
+    bool                        mIsOpen{};      ///< Workers can join the job (mMutex).
+    unsigned                    mActiveCount{}; ///< Workers running the job (mMutex).
+    std::atomic<std::size_t>    mNextTask{};    ///< Next task of the job to run.
+    std::vector<std::jthread>   mThreads;       ///< Last member, joined first.
+};
+
+} // namespace fuse
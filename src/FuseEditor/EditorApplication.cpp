@@ -1,7 +1,9 @@
 #include "EditorApplication.h"
 
+#include "FuseApp/LogRingSink.h"
 #include "FuseCore/scene/Components.h"
 #include "FuseCore/scene/Scene.h"
+#include "FuseCore/scene/UndoJournal.h"
 #include "panel/InspectorPanel.h"
 #include "panel/LogPanel.h"
 #include "panel/SceneHierachyPanel.h"
@@ -9,6 +11,9 @@
 
 #include <imgui.h>
 #include <imgui_internal.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
 
 namespace {
 bool showDemoWindow        = false;
@@ -24,9 +29,16 @@ bool viewportOpen  = true;
 
 namespace fuse {
 
-EditorApplication::EditorApplication() = default;
+EditorApplication::EditorApplication()
+    : mLogSink(std::make_shared<LogRingSink>()) {
+    // Added before the application start, to display the messages of the initialization.
+    spdlog::default_logger()->sinks().push_back(mLogSink);
+}
 
-EditorApplication::~EditorApplication() = default;
+EditorApplication::~EditorApplication() {
+    auto& sinks = spdlog::default_logger()->sinks();
+    sinks.erase(std::ranges::remove(sinks, mLogSink).begin(), sinks.end());
+}
 
 void EditorApplication::onUpdate(float /*deltaTime*/) {
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
@@ -88,6 +100,14 @@ void EditorApplication::onImGui() {
 
     imguiDrawMainMenuBar();
 
+    // The text inputs own the shortcuts while they are active, to undo the text.
+    if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_Z, ImGuiInputFlags_RouteGlobal)) {
+        undo();
+    }
+    if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_Y, ImGuiInputFlags_RouteGlobal)) {
+        redo();
+    }
+
     if (showDemoWindow) {
         ImGui::ShowDemoWindow(&showDemoWindow);
     }
@@ -113,11 +133,13 @@ bool EditorApplication::onInit() {
     mInspectorPanel      = std::make_unique<InspectorPanel>();
     mLogPanel            = std::make_unique<LogPanel>();
     mScenePanel          = std::make_unique<ScenePanel>();
+    mUndoJournal         = std::make_unique<UndoJournal>();
 
     {
         auto e = mScene->createEntity("Floor");
-        e.addComponent<CTransform>(Vec3{0, -10, 0}, Vec3{0, 0, 0}, Vec3{100, 0, 100});
-        e.addComponent<CMesh>(Vec4{0.5f, 0.5f, 0.5f, 1.f});
+        e.addComponent<CTransform>(Vec3{0, -10, 0}, Vec3{0, 0, 0}, Vec3{100, 1, 100});
+        e.addComponent<CMesh>(Vec4{0.5f, 0.5f, 0.5f, 1.f}, MeshHandle::kPlane, true);
+        e.addComponent<CStatic>();
     }
     {
         auto e = mScene->createEntity("Cube");
@@ -127,8 +149,13 @@ bool EditorApplication::onInit() {
 
     mScenePanel->setScene(mScene.get());
     mSceneHierarchyPanel->setScene(mScene.get());
+    mInspectorPanel->setScene(mScene.get());
+    mInspectorPanel->setUndoJournal(mUndoJournal.get());
+    mLogPanel->setSink(mLogSink);
     mSceneHierarchyPanel->setSelectionCallback(
       [&](Entity entity) { mInspectorPanel->setEntity(entity); });
+    mScenePanel->setSelectionCallback(
+      [&](Entity entity) { mSceneHierarchyPanel->setSelectedEntity(entity); });
 
     return true;
 }
@@ -165,9 +192,11 @@ void EditorApplication::imguiDrawMainMenuBar() {
     // Edit menu
     //
     if (ImGui::BeginMenu("Edit", true /*enabled*/)) {
-        if (ImGui::MenuItem("Undo", "Ctrl+Z", nullptr, false)) {
+        if (ImGui::MenuItem("Undo", "Ctrl+Z", nullptr, mUndoJournal->canUndo())) {
+            undo();
         }
-        if (ImGui::MenuItem("Redo", "Ctrl+Y", nullptr, false)) {
+        if (ImGui::MenuItem("Redo", "Ctrl+Y", nullptr, mUndoJournal->canRedo())) {
+            redo();
         }
 
         ImGui::Separator();
@@ -219,4 +248,8 @@ void EditorApplication::imguiDrawMainMenuBar() {
     }
 }
 
+void EditorApplication::undo() { mUndoJournal->undo(mScene->getRegistry()); }
+
+void EditorApplication::redo() { mUndoJournal->redo(mScene->getRegistry()); }
+
 } // namespace fuse
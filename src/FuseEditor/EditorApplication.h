@@ -9,7 +9,9 @@ class Scene;
 class SceneHierarchyPanel;
 class InspectorPanel;
 class LogPanel;
+class LogRingSink;
 class ScenePanel;
+class UndoJournal;
 
 class EditorApplication : public fuse::Application {
 public:
@@ -30,11 +32,19 @@ private:
 
     void imguiDrawMainMenuBar();
 
+    /// @brief Undo the last change recorded in mUndoJournal.
+    void undo();
+
+    /// @brief Redo the last change undone.
+    void redo();
+
     std::unique_ptr<Scene>               mScene;
     std::unique_ptr<SceneHierarchyPanel> mSceneHierarchyPanel;
     std::unique_ptr<InspectorPanel>      mInspectorPanel;
     std::unique_ptr<LogPanel>            mLogPanel;
     std::unique_ptr<ScenePanel>          mScenePanel;
+    std::unique_ptr<UndoJournal>         mUndoJournal; ///< History of the edits of the scene.
+    std::shared_ptr<LogRingSink>         mLogSink;     ///< Messages displayed by mLogPanel.
 };
 
 } // namespace fuse
@@ -63,6 +63,10 @@ Mat4 EditorCamera::getViewMatrix() noexcept {
     return Mat4::CreateViewLookTo(mPosition, mDirection, Vec3::kAxisY);
 }
 
+Ray EditorCamera::computeRay(float ndcX, float ndcY) noexcept {
+    return fuse::computeRay((getProjMatrix() * getViewMatrix()).inversed(), ndcX, ndcY);
+}
+
 void EditorCamera::pitch(const Angle& angle) {
     mPitch += angle;
     if (mPitch > degrees(89.f)) {
@@ -1,6 +1,7 @@
 #pragma once
 #include <FuseCore/math/Mat4.h>
 #include <FuseCore/math/Vec3.h>
+#include <FuseCore/scene/Raycast.h>
 
 namespace fuse {
 
@@ -28,6 +29,11 @@ public:
     [[nodiscard]] Mat4 getProjMatrix() const noexcept;
     [[nodiscard]] Mat4 getViewMatrix() noexcept;
 
+    /// @brief Build the ray going through a point of the viewport (see fuse::computeRay()).
+    /// @param ndcX The horizontal position of the point in range [-1, 1], -1 is the left.
+    /// @param ndcY The vertical position of the point in range [-1, 1], -1 is the bottom.
+    [[nodiscard]] Ray computeRay(float ndcX, float ndcY) noexcept;
+
     // rotation around local x-axis
     void pitch(const Angle& angle);
 
@@ -2,8 +2,11 @@
 
 #include <memory>
 
-int main() {
+int main(int argc, char** argv) {
     auto app = std::make_unique<fuse::EditorApplication>();
+    if (!app->parseCommandLine(argc, argv)) {
+        return 1;
+    }
     app->run();
     app.reset();
     return 0;
@@ -2,57 +2,23 @@
 
 #include <FuseApp/ImGui/Widget.h>
 #include <FuseCore/math/Vec3.h>
+#include <FuseCore/scene/ComponentReflection.h>
 #include <FuseCore/scene/Components.h>
+#include <FuseCore/scene/Scene.h>
+#include <FuseCore/scene/UndoJournal.h>
 #include <FuseEditor/embed/fonts/IconsMaterialDesignIcons.h>
 
 #include <imgui.h>
 
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <string>
+#include <vector>
+
 namespace {
 const char* panelName = ICON_MDI_INFORMATION " Inspector###Inspector";
 
-/// @brief Draw an entity component
-/// @tparam Component The type of component to render.
-/// @tparam Callback
-/// @param label
-/// @param entity
-/// @param callback
-template <class Component, class Callback>
-void drawComponent(const char* label, fuse::Entity entity, Callback callback) {
-    ImGui::PushID(label);
-
-    if (entity.hasComponents<Component>()) {
-        const auto& contentRegionAvail = ImGui::GetContentRegionAvail();
-
-        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2{4.F, 4.F});
-
-        ImGuiTreeNodeFlags collapsingHeaderFlags = 0;
-        collapsingHeaderFlags |= ImGuiTreeNodeFlags_DefaultOpen;
-        collapsingHeaderFlags |= ImGuiTreeNodeFlags_AllowItemOverlap;
-        const bool isOpen = ImGui::CollapsingHeader(label, collapsingHeaderFlags);
-
-        const float lineHeight = ImGui::GetFontSize() + (ImGui::GetStyle().FramePadding.y * 2.0F);
-        ImGui::SameLine(contentRegionAvail.x - (lineHeight * 0.5F));
-
-        if (ImGui::Button("+", ImVec2{lineHeight, lineHeight})) {
-            ImGui::OpenPopup("ComponentSettings");
-        }
-        ImGui::PopStyleVar();
-
-        if (isOpen) {
-            callback();
-        }
-
-        if (ImGui::BeginPopup("ComponentSettings")) {
-            if (ImGui::MenuItem("Remove")) {
-                entity.removeComponents<Component>();
-                ImGui::CloseCurrentPopup();
-            }
-            ImGui::EndPopup();
-        }
-    }
-    ImGui::PopID();
-}
-
 bool drawInputText(const std::string& label, std::string& text) {
     // TODO: FIXME
     char buffer[256]{};
@@ -99,11 +65,13 @@ bool dragFloat(const std::string& label, float& value) {
 /// @brief
 /// @param label
 /// @param angle
-void dragAngle(const std::string& label, fuse::Angle& angle) {
+bool dragAngle(const std::string& label, fuse::Angle& angle) {
     auto degree = angle.asDegrees();
     if (dragFloat(label, degree)) {
         angle = fuse::degrees(degree);
+        return true;
     }
+    return false;
 }
 
 /// @brief Draw a 3d vector drag slider widget with button to reset the value.
@@ -111,7 +79,8 @@ void dragAngle(const std::string& label, fuse::Angle& angle) {
 /// @param values     The 3d vector to display/edit.
 /// @param resetValue The value to use to reset the vector component.
 /// @param columnWidth
-void dragVec3(const std::string& label,
+/// @return True if the vector was modified.
+bool dragVec3(const std::string& label,
               fuse::Vec3&        values,
               float              resetValue  = 0.0F,
               float              columnWidth = 100.0F) {
@@ -131,6 +100,7 @@ void dragVec3(const std::string& label,
     // draw each component vector on the next column.
     ImGui::NextColumn();
 
+    bool hasChanged = false;
     ImGui::PushMultiItemsWidths(3, ImGui::CalcItemWidth());
     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2{0, 0});
 
@@ -142,13 +112,14 @@ void dragVec3(const std::string& label,
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.8F, 0.1F, 0.15F, 1.0F});
     ImGui::PushFont(boldFont);
     if (ImGui::Button("X", buttonSize)) {
-        values.x = resetValue;
+        values.x   = resetValue;
+        hasChanged = true;
     }
     ImGui::PopFont();
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
-    ImGui::DragFloat("##X", &values.x, 0.1F, 0.0F, 0.0F, "%.2f");
+    hasChanged |= ImGui::DragFloat("##X", &values.x, 0.1F, 0.0F, 0.0F, "%.2f");
     ImGui::PopItemWidth();
     ImGui::SameLine();
 
@@ -160,13 +131,14 @@ void dragVec3(const std::string& label,
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.2F, 0.7F, 0.2F, 1.0F});
     ImGui::PushFont(boldFont);
     if (ImGui::Button("Y", buttonSize)) {
-        values.y = resetValue;
+        values.y   = resetValue;
+        hasChanged = true;
     }
     ImGui::PopFont();
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
-    ImGui::DragFloat("##Y", &values.y, 0.1F, 0.0F, 0.0F, "%.2f");
+    hasChanged |= ImGui::DragFloat("##Y", &values.y, 0.1F, 0.0F, 0.0F, "%.2f");
     ImGui::PopItemWidth();
     ImGui::SameLine();
 
@@ -178,13 +150,14 @@ void dragVec3(const std::string& label,
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.1F, 0.25F, 0.8F, 1.0F});
     ImGui::PushFont(boldFont);
     if (ImGui::Button("Z", buttonSize)) {
-        values.z = resetValue;
+        values.z   = resetValue;
+        hasChanged = true;
     }
     ImGui::PopFont();
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
-    ImGui::DragFloat("##Z", &values.z, 0.1F, 0.0F, 0.0F, "%.2f");
+    hasChanged |= ImGui::DragFloat("##Z", &values.z, 0.1F, 0.0F, 0.0F, "%.2f");
     ImGui::PopItemWidth();
 
     ImGui::PopStyleVar();
@@ -192,8 +165,198 @@ void dragVec3(const std::string& label,
     ImGui::Columns(1);
 
     ImGui::PopID();
+
+    return hasChanged;
 }
 
+/// @brief Draw a 3d vector shared by many entities, the mixed values are displayed with a "-".
+/// @param label      The label to display.
+/// @param summary    The values of the selected entities.
+/// @param firstField The field of the x component in the summary.
+/// @param field      Receive the field modified.
+/// @param value      Receive the new value of the field.
+/// @return True if a field was modified.
+bool dragMixedVec3(const std::string&                              label,
+                   const fuse::SelectionSummary<fuse::CTransform>& summary,
+                   std::size_t                                     firstField,
+                   std::size_t&                                    field,
+                   float&                                          value) {
+    ImGui::PushID(label.c_str());
+    ImGui::Columns(2);
+    ImGui::SetColumnWidth(0, 100);
+    ImGui::TextUnformatted(label.c_str());
+    ImGui::NextColumn();
+
+    bool hasChanged = false;
+    ImGui::PushMultiItemsWidths(3, ImGui::CalcItemWidth());
+    for (std::size_t i = 0; i < 3; i++) {
+        const std::size_t current = firstField + i;
+        float             drag    = summary.getValue(current);
+        const char*       format  = summary.isMixed(current) ? "-" : "%.2f";
+        ImGui::PushID(static_cast<int>(i));
+        if (ImGui::DragFloat("##drag", &drag, 0.1F, 0.0F, 0.0F, format)) {
+            field      = current;
+            value      = drag;
+            hasChanged = true;
+        }
+        ImGui::PopID();
+        ImGui::PopItemWidth();
+        if (i < 2) {
+            ImGui::SameLine();
+        }
+    }
+
+    ImGui::Columns(1);
+    ImGui::PopID();
+    return hasChanged;
+}
+
+/// @brief Draw the widget of a reflected field, one per element of a std::array.
+/// @param field        The field to display.
+/// @param value        The field in the component.
+/// @param defaultValue The field in a default component, used to reset the 3d vectors.
+/// @param meshes       The meshes of the scene, for the mesh fields.
+/// @return True if the field was modified.
+bool drawField(const fuse::FieldInfo&    field,
+               std::byte*                value,
+               const std::byte*          defaultValue,
+               const fuse::MeshRegistry& meshes) {
+    const std::size_t elementSize = field.size / field.count;
+    const bool        hasRange    = field.min != field.max;
+    bool              hasChanged  = false;
+    for (std::uint32_t i = 0; i < field.count; i++) {
+        const std::string label =
+          field.count > 1 ? std::format("{}[{}]", field.name, i) : std::string(field.name);
+        std::byte*       element        = value + i * elementSize;
+        const std::byte* defaultElement = defaultValue + i * elementSize;
+        ImGui::PushID(static_cast<int>(i));
+        switch (field.type) {
+            case fuse::FieldType::Bool:
+                hasChanged |= ImGui::Checkbox(label.c_str(), reinterpret_cast<bool*>(element));
+                break;
+            case fuse::FieldType::UInt8: {
+                auto& integer = *reinterpret_cast<std::uint8_t*>(element);
+                int   drag    = integer;
+                bool  edited  = false;
+                if (hasRange) {
+                    const auto min = static_cast<int>(field.min);
+                    const auto max = static_cast<int>(field.max);
+                    edited         = ImGui::SliderInt(label.c_str(), &drag, min, max);
+                } else {
+                    edited = ImGui::DragInt(label.c_str(), &drag, 1.0F, 0, 255);
+                }
+                if (edited) {
+                    integer    = static_cast<std::uint8_t>(drag);
+                    hasChanged = true;
+                }
+                break;
+            }
+            case fuse::FieldType::Float: {
+                auto& real = *reinterpret_cast<float*>(element);
+                if (hasRange) {
+                    hasChanged |= ImGui::SliderFloat(label.c_str(), &real, field.min, field.max);
+                } else {
+                    hasChanged |= dragFloat(label, real);
+                }
+                break;
+            }
+            case fuse::FieldType::Vec3:
+                hasChanged |= dragVec3(label,
+                                       *reinterpret_cast<fuse::Vec3*>(element),
+                                       reinterpret_cast<const fuse::Vec3*>(defaultElement)->x);
+                break;
+            case fuse::FieldType::Vec4:
+                hasChanged |= ImGui::ColorEdit4(label.c_str(), reinterpret_cast<float*>(element));
+                break;
+            case fuse::FieldType::Angle:
+                hasChanged |= dragAngle(label, *reinterpret_cast<fuse::Angle*>(element));
+                break;
+            case fuse::FieldType::Mesh: {
+                auto& mesh = *reinterpret_cast<fuse::MeshHandle*>(element);
+                if (ImGui::BeginCombo(label.c_str(), meshes.getName(mesh).data())) {
+                    for (std::uint32_t id = 0; id < meshes.getMeshCount(); id++) {
+                        const fuse::MeshHandle handle{id};
+                        if (ImGui::Selectable(meshes.getName(handle).data(), handle == mesh)) {
+                            mesh       = handle;
+                            hasChanged = true;
+                        }
+                    }
+                    ImGui::EndCombo();
+                }
+                break;
+            }
+        }
+        ImGui::PopID();
+    }
+    return hasChanged;
+}
+
+/// @brief Draw a reflected component of an entity, with a widget per field.
+/// @param info    The component to render.
+/// @param scene   The scene of the entity.
+/// @param entity  The entity.
+/// @param journal Record the edits of the component, can be nullptr.
+/// @param buffer  Receive the component before the edit and a default component.
+void drawComponent(const fuse::ComponentInfo& info,
+                   fuse::Scene&               scene,
+                   entt::entity               entity,
+                   fuse::UndoJournal*         journal,
+                   std::vector<std::byte>&    buffer) {
+    entt::registry& registry = scene.getRegistry();
+    if (!info.contains(registry, entity)) {
+        return;
+    }
+
+    const std::string label(info.name);
+    ImGui::PushID(label.c_str());
+    const auto& contentRegionAvail = ImGui::GetContentRegionAvail();
+
+    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2{4.F, 4.F});
+
+    ImGuiTreeNodeFlags collapsingHeaderFlags = 0;
+    collapsingHeaderFlags |= ImGuiTreeNodeFlags_DefaultOpen;
+    collapsingHeaderFlags |= ImGuiTreeNodeFlags_AllowItemOverlap;
+    const bool isOpen = ImGui::CollapsingHeader(label.c_str(), collapsingHeaderFlags);
+
+    const float lineHeight = ImGui::GetFontSize() + (ImGui::GetStyle().FramePadding.y * 2.0F);
+    ImGui::SameLine(contentRegionAvail.x - (lineHeight * 0.5F));
+
+    if (ImGui::Button("+", ImVec2{lineHeight, lineHeight})) {
+        ImGui::OpenPopup("ComponentSettings");
+    }
+    ImGui::PopStyleVar();
+
+    if (isOpen && info.size > 0) {
+        auto* component = static_cast<std::byte*>(info.get(registry, entity));
+        buffer.resize(2 * std::size_t{info.size});
+        std::byte* before       = buffer.data();
+        std::byte* defaultValue = buffer.data() + info.size;
+        std::memcpy(before, component, info.size);
+        info.construct(defaultValue);
+
+        bool hasChanged = false;
+        for (const fuse::FieldInfo& field : info.fields) {
+            hasChanged |= drawField(field,
+                                    component + field.offset,
+                                    defaultValue + field.offset,
+                                    scene.getMeshRegistry());
+        }
+
+        // The edits of a widget are merged until it is released.
+        if (hasChanged && journal) {
+            info.record(*journal, entity, before, component, ImGui::GetActiveID());
+        }
+    }
+
+    if (ImGui::BeginPopup("ComponentSettings")) {
+        if (ImGui::MenuItem("Remove")) {
+            info.remove(registry, entity);
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
+    }
+    ImGui::PopID();
+}
 
 } // namespace
 
@@ -202,6 +365,13 @@ namespace fuse {
 
 InspectorPanel::InspectorPanel() = default;
 
+void InspectorPanel::setScene(Scene* scene) {
+    mScene = scene;
+    if (mScene) {
+        mTransformSummary.connect(mScene->getRegistry());
+    }
+}
+
 void InspectorPanel::setEntity(Entity entity) { mEntity = entity; }
 
 void InspectorPanel::onImGui(bool& isOpen) {
@@ -211,11 +381,20 @@ void InspectorPanel::onImGui(bool& isOpen) {
 
     const ImGuiWindowFlags windowFlags = ImGuiWindowFlags_None;
     mIsVisible                         = ImGui::Begin(panelName, &isOpen, windowFlags);
-    if (mIsVisible && mEntity.isValid()) {
-        if (mEntity.hasComponents<NameComponent>()) {
-            auto name = mEntity.getComponent<NameComponent>().name;
+    if (mIsVisible && mScene && mScene->getRegistry().storage<CSelected>().size() > 1) {
+        drawSelection();
+    } else if (mIsVisible && mEntity.isValid()) {
+        if (mScene && mEntity.hasComponents<NameComponent>()) {
+            auto name = std::string(mScene->getEntityName(mEntity));
             if (drawInputText("Name", name)) {
-                mEntity.getComponent<NameComponent>().name = name;
+                const NameComponent before = mEntity.getComponent<NameComponent>();
+                mScene->setEntityName(mEntity, name);
+                if (mUndoJournal) {
+                    mUndoJournal->record(static_cast<entt::entity>(mEntity.getId()),
+                                         before,
+                                         mEntity.getComponent<NameComponent>(),
+                                         ImGui::GetActiveID());
+                }
             }
         }
 
@@ -225,31 +404,61 @@ void InspectorPanel::onImGui(bool& isOpen) {
         ImGuiTextFmt("Entt ID      {}", entt::to_entity(mEntity.getId()));
         ImGuiTextFmt("Entt Version {}", entt::to_version(mEntity.getId()));
 
-        drawComponent<CTransform>(ICON_MDI_VECTOR_LINE " Transform", mEntity, [this]() {
-            CTransform& cTransform = mEntity.getComponent<CTransform>();
-            dragVec3("Translation", cTransform.translation);
-            dragVec3("Roatation", cTransform.rotation);
-            dragVec3("Scaling", cTransform.scale, 1.0f);
-        });
-        drawComponent<CMesh>("Mesh", mEntity, [this]() {
-            CMesh& cMesh = mEntity.getComponent<CMesh>();
-            ImGui::ColorEdit4("Color", &cMesh.color.x);
-        });
-
-        drawComponent<CRotator>("Rotator", mEntity, [this]() {
-            CRotator& cRotator = mEntity.getComponent<CRotator>();
-            dragAngle("Angle", cRotator.angle);
-            dragVec3("Axis", cRotator.axis);
-        });
-
-        drawComponent<CTranslator>("Translator", mEntity, [this]() {
-            CTranslator& cTranslator = mEntity.getComponent<CTranslator>();
-            dragVec3("Direction", cTranslator.direction);
-            dragFloat("Seconds", cTranslator.duration);
-        });
+        // The components are drawn from their reflected fields (see ComponentReflection.h).
+        for (const ComponentInfo* info : getReflectedComponents()) {
+            drawComponent(*info,
+                          *mScene,
+                          static_cast<entt::entity>(mEntity.getId()),
+                          mUndoJournal,
+                          mComponentBuffer);
+        }
+
+        // the components are edited in place, the registry does not signal the changes.
+        if (ImGui::IsWindowFocused() && ImGui::IsAnyItemActive()) {
+            mScene->markTransformsChanged();
+            if (mEntity.hasComponents<CStatic>()) {
+                mScene->markStaticChanged();
+            }
+        }
+    }
+
+    // A new drag is undone separately from the previous one.
+    if (mUndoJournal && !ImGui::IsAnyItemActive()) {
+        mUndoJournal->closeMerge();
     }
 
     ImGui::End();
 }
 
+void InspectorPanel::drawSelection() {
+    auto& registry = mScene->getRegistry();
+    ImGuiTextFmt("{} entities selected", registry.storage<CSelected>().size());
+
+    // Only recomputed when the selection or the transforms changed.
+    mTransformSummary.update(registry, mScene->getTransformVersion());
+    if (mTransformSummary.getCount() == 0) {
+        return;
+    }
+
+    ImGui::PushID("Transform");
+    ImGuiTextFmt(ICON_MDI_VECTOR_LINE " Transform ({} entities)", mTransformSummary.getCount());
+    std::size_t field      = 0;
+    float       value      = 0.0f;
+    bool        hasChanged = dragMixedVec3("Translation", mTransformSummary, 0, field, value);
+    hasChanged |= dragMixedVec3("Rotation", mTransformSummary, 3, field, value);
+    hasChanged |= dragMixedVec3("Scaling", mTransformSummary, 6, field, value);
+    ImGui::PopID();
+
+    if (hasChanged) {
+        // One entry in the journal for all the entities, merged until the drag end.
+        mTransformSummary.setField(registry, field, value, mUndoJournal, ImGui::GetActiveID());
+        mScene->markTransformsChanged();
+        const auto statics = registry.view<const CStatic, const CSelected>();
+        if (statics.begin() != statics.end()) {
+            mScene->markStaticChanged();
+        }
+        mTransformSummary.acceptVersion(mScene->getTransformVersion());
+    }
+}
+
 } // namespace fuse
@@ -1,11 +1,22 @@
 #pragma once
 #include "EditorPanel.h"
 
+#include <FuseCore/scene/Components.h>
 #include <FuseCore/scene/Entity.h>
+#include <FuseCore/scene/SelectionSummary.h>
+
+#include <cstddef>
+#include <vector>
 
 namespace fuse {
+class Scene;
+class UndoJournal;
 
 /// @brief ImGui panel to display entity properties.
+///
+/// The components are displayed from their reflected fields (see ComponentReflection.h).
+/// When many entities are selected (see CSelected), their transforms are edited together,
+/// the fields with different values are displayed with a "-".
 class InspectorPanel : public EditorPanel {
 public:
     InspectorPanel();
@@ -16,6 +27,14 @@ public:
     InspectorPanel& operator=(const InspectorPanel&) = delete;
     InspectorPanel& operator=(InspectorPanel&&)      = delete;
 
+    /// @brief Set the scene owning the entities to display.
+    /// @param scene The scene to used.
+    void setScene(Scene* scene);
+
+    /// @brief Set the journal recording the edits of the components.
+    /// @param journal The journal to use, or nullptr to not record the edits.
+    void setUndoJournal(UndoJournal* journal) { mUndoJournal = journal; }
+
     /// @brief Set the entity to display properties.
     /// @param entity The entity to used.
     void setEntity(Entity entity);
@@ -23,8 +42,15 @@ public:
     void onImGui(bool& isOpen) override;
 
 private:
-    bool   mIsVisible{true};
-    Entity mEntity;
+    /// @brief Draw the components shared by the selected entities.
+    void drawSelection();
+
+    Scene*                       mScene{};
+    UndoJournal*                 mUndoJournal{};
+    bool                         mIsVisible{true};
+    Entity                       mEntity;
+    SelectionSummary<CTransform> mTransformSummary; ///< Transforms of the selected entities.
+    std::vector<std::byte>       mComponentBuffer;  ///< Component before a edit, and default.
 };
 
 } // namespace fuse
@@ -1,21 +1,179 @@
 #include "LogPanel.h"
 
+#include <FuseApp/ImGui/Widget.h>
+#include <FuseApp/LogRingSink.h>
 #include <FuseEditor/embed/fonts/IconsMaterialDesignIcons.h>
 
 #include <imgui.h>
+#include <spdlog/details/os.h>
+
+#include <algorithm>
+#include <ctime>
+
+namespace {
+
+/// @brief Name and color of each spdlog level.
+struct LevelStyle {
+    const char* name;
+    ImVec4      color;
+};
+
+constexpr std::array<LevelStyle, spdlog::level::n_levels> kLevelStyles = {{
+  {"trace", ImVec4{0.5F, 0.5F, 0.5F, 1.0F}},
+  {"debug", ImVec4{0.3F, 0.8F, 0.9F, 1.0F}},
+  {"info", ImVec4{0.3F, 0.9F, 0.3F, 1.0F}},
+  {"warning", ImVec4{1.0F, 0.8F, 0.2F, 1.0F}},
+  {"error", ImVec4{1.0F, 0.3F, 0.3F, 1.0F}},
+  {"critical", ImVec4{1.0F, 0.2F, 0.8F, 1.0F}},
+  {"off", ImVec4{1.0F, 1.0F, 1.0F, 1.0F}},
+}};
+
+} // namespace
 
 namespace fuse {
 
-LogPanel::LogPanel() = default;
+LogPanel::LogPanel() { mShowLevels.fill(true); }
+
+LogPanel::~LogPanel() = default;
+
+void LogPanel::setSink(std::shared_ptr<LogRingSink> sink) { mSink = std::move(sink); }
+
+void LogPanel::clear() {
+    mChunks.clear();
+    mVisibleLines.clear();
+    mFirstLine = mLineCount;
+}
 
 void LogPanel::onImGui(bool& isOpen) {
+    // The sink is drained even when the panel is closed, to not drop the messages.
+    if (mSink) {
+        mSink->drain([this](const LogRecord& record) { addLine(record); });
+    }
+
     if (!isOpen) {
         return;
     }
 
     if (ImGui::Begin(ICON_MDI_VIEW_LIST "Console###Console", &isOpen)) {
+        if (ImGui::Button("Clear")) {
+            clear();
+        }
+        // The levels except off.
+        for (std::size_t level = 0; level + 1 < spdlog::level::n_levels; level++) {
+            ImGui::SameLine();
+            if (ImGui::Checkbox(kLevelStyles[level].name, &mShowLevels[level])) {
+                updateVisibleLines();
+            }
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Auto-scroll", &mAutoScroll);
+        if (mSink && mSink->getDroppedCount() > 0) {
+            ImGui::SameLine();
+            ImGuiTextFmt("({} messages dropped)", mSink->getDroppedCount());
+        }
+        ImGui::Separator();
+
+        if (ImGui::BeginChild("##Lines",
+                              ImVec2{0, 0},
+                              ImGuiChildFlags_None,
+                              ImGuiWindowFlags_HorizontalScrollbar)) {
+            const std::uint64_t rowCount = mFiltered ? mVisibleLines.size()
+                                                     : mLineCount - mFirstLine;
+
+            ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2{4, 0});
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(rowCount));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    const auto index = static_cast<std::uint64_t>(row);
+                    drawLine(mFiltered ? mVisibleLines[index] : mFirstLine + index);
+                }
+            }
+            clipper.End();
+            ImGui::PopStyleVar();
+
+            if (mAutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
+                ImGui::SetScrollHereY(1.0F);
+            }
+        }
+        ImGui::EndChild();
     }
     ImGui::End();
 }
 
+void LogPanel::addLine(const LogRecord& record) {
+    if (mChunks.empty() || mChunks.back().lines.size() == kChunkLines) {
+        if (mChunks.size() == kMaxChunks) {
+            // The oldest chunk is reused, its memory is already allocated.
+            Chunk chunk = std::move(mChunks.front());
+            mChunks.pop_front();
+            mFirstLine += kChunkLines;
+            while (!mVisibleLines.empty() && mVisibleLines.front() < mFirstLine) {
+                mVisibleLines.pop_front();
+            }
+            chunk.lines.clear();
+            chunk.text.clear();
+            mChunks.push_back(std::move(chunk));
+        } else {
+            mChunks.emplace_back().lines.reserve(kChunkLines);
+        }
+    }
+
+    Chunk& chunk = mChunks.back();
+    chunk.lines.push_back({.time     = record.time,
+                           .offset   = static_cast<std::uint32_t>(chunk.text.size()),
+                           .threadId = record.threadId,
+                           .length   = record.length,
+                           .level    = record.level});
+    chunk.text.append(record.getText());
+
+    // The rows of the clipper have the same height.
+    std::replace(chunk.text.end() - record.length, chunk.text.end(), '\n', ' ');
+
+    if (mFiltered && mShowLevels[static_cast<std::size_t>(record.level)]) {
+        mVisibleLines.push_back(mLineCount);
+    }
+    mLineCount++;
+}
+
+void LogPanel::updateVisibleLines() {
+    mFiltered = std::ranges::any_of(mShowLevels, [](bool show) { return !show; });
+    mVisibleLines.clear();
+    if (!mFiltered) {
+        return;
+    }
+
+    std::uint64_t line = mFirstLine;
+    for (const Chunk& chunk : mChunks) {
+        for (const Line& l : chunk.lines) {
+            if (mShowLevels[static_cast<std::size_t>(l.level)]) {
+                mVisibleLines.push_back(line);
+            }
+            line++;
+        }
+    }
+}
+
+void LogPanel::drawLine(std::uint64_t line) const {
+    const std::uint64_t index = line - mFirstLine;
+    const Chunk&        chunk = mChunks[index / kChunkLines];
+    const Line&         l     = chunk.lines[index % kChunkLines];
+    const LevelStyle&   style = kLevelStyles[static_cast<std::size_t>(l.level)];
+
+    const std::int64_t milliseconds = l.time / 1'000'000;
+    const auto         seconds      = static_cast<std::time_t>(milliseconds / 1000);
+    const std::tm      time         = spdlog::details::os::localtime(seconds);
+    ImGuiTextFmt("{:02}:{:02}:{:02}.{:03} [{}]",
+                 time.tm_hour,
+                 time.tm_min,
+                 time.tm_sec,
+                 milliseconds % 1000,
+                 l.threadId);
+    ImGui::SameLine();
+    ImGui::TextColored(style.color, "%s", style.name);
+    ImGui::SameLine();
+    const char* text = chunk.text.data() + l.offset;
+    ImGui::TextUnformatted(text, text + l.length);
+}
+
 } // namespace fuse
@@ -2,20 +2,83 @@
 
 #include "EditorPanel.h"
 
+#include <spdlog/common.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace fuse {
+class LogRingSink;
+struct LogRecord;
 
-/// @brief
+/// @brief ImGui panel to display the messages logged (see LogRingSink).
+///
+/// The messages are moved from the sink each frame into chunks of lines. When the maximum
+/// number of chunks is reached, the oldest chunk is reused for the new lines, so the memory
+/// is bounded and does not move. The numbers of the lines of the levels shown are kept when
+/// some levels are hidden, updated as the lines are added. Only the visible rows are drawn
+/// (ImGuiListClipper).
 class LogPanel : public EditorPanel {
 public:
+    static constexpr std::size_t kChunkLines = 1024; ///< Number of lines in a chunk.
+    static constexpr std::size_t kMaxChunks  = 64;   ///< Maximum number of chunks kept.
+
     LogPanel();
-    ~LogPanel() override = default;
+    ~LogPanel() override;
 
     LogPanel(const LogPanel&)              = delete;
     LogPanel& operator=(const LogPanel&)   = delete;
     LogPanel(const LogPanel&&)             = delete;
     LogPanel&& operator=(const LogPanel&&) = delete;
 
+    /// @brief Set the sink receiving the messages to display.
+    /// @param sink The sink, or nullptr to not receive messages.
+    void setSink(std::shared_ptr<LogRingSink> sink);
+
+    /// @brief Remove all the lines.
+    void clear();
+
     void onImGui(bool& isOpen) override;
+
+private:
+    /// @brief A message, the text is stored in the chunk.
+    struct Line {
+        std::int64_t              time;     ///< Nanoseconds since the epoch.
+        std::uint32_t             offset;   ///< Position of the text in Chunk::text.
+        std::uint32_t             threadId; ///< Thread which logged the message.
+        std::uint16_t             length;   ///< Number of characters of the text.
+        spdlog::level::level_enum level;    ///< Level of the message.
+    };
+
+    /// @brief kChunkLines lines and their text.
+    struct Chunk {
+        std::vector<Line> lines;
+        std::string       text;
+    };
+
+    /// @brief Add a line after the last one, dropping the oldest chunk if needed.
+    void addLine(const LogRecord& record);
+
+    /// @brief Rebuild mVisibleLines after the levels shown changed.
+    void updateVisibleLines();
+
+    /// @brief Draw a line.
+    /// @param line The number of the line, from mFirstLine to mLineCount.
+    void drawLine(std::uint64_t line) const;
+
+    std::shared_ptr<LogRingSink>              mSink;
+    std::deque<Chunk>                         mChunks;           ///< Oldest chunk first.
+    std::uint64_t                             mFirstLine{};      ///< Number of the oldest line.
+    std::uint64_t                             mLineCount{};      ///< Number of the next line.
+    std::array<bool, spdlog::level::n_levels> mShowLevels{};     ///< The levels displayed.
+    bool                                      mFiltered{};       ///< Some levels are hidden.
+    std::deque<std::uint64_t>                 mVisibleLines;     ///< Lines shown, if mFiltered.
+    bool                                      mAutoScroll{true}; ///< Follow the new lines.
 };
 
 
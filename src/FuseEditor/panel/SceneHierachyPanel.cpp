@@ -8,6 +8,8 @@
 #include <imgui.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 namespace {
 const char* panelName = ICON_MDI_FILE_TREE " Hierarchy###Hierarchy";
 }
@@ -18,7 +20,12 @@ SceneHierarchyPanel::SceneHierarchyPanel() = default;
 
 SceneHierarchyPanel::~SceneHierarchyPanel() = default;
 
-void SceneHierarchyPanel::setScene(Scene* scene) { mScene = scene; }
+void SceneHierarchyPanel::setScene(Scene* scene) {
+    mScene         = scene;
+    mFilterVersion = std::numeric_limits<std::uint64_t>::max();
+    mAnchorRow     = -1;
+    mFilteredEntities.clear();
+}
 
 void SceneHierarchyPanel::onImGui(bool& isOpen) {
     if (!isOpen) {
@@ -32,11 +39,31 @@ void SceneHierarchyPanel::onImGui(bool& isOpen) {
     const ImGuiWindowFlags windowFlags = 0;
     mIsVisible                         = ImGui::Begin(panelName, &isOpen, windowFlags);
     if (mIsVisible) {
-        auto& registry   = mScene->getRegistry();
-        auto  entityView = registry.view<NameComponent>();
-        for (auto e : entityView) {
-            const Entity entity(e, registry);
-            drawEntityNode(entity, entityView.get<NameComponent>(e).name);
+        ImGui::SetNextItemWidth(-FLT_MIN);
+        ImGui::InputTextWithHint(
+          "##Search", ICON_MDI_MAGNIFY " Search", mFilter.data(), mFilter.size());
+        updateFilter();
+
+        auto& registry = mScene->getRegistry();
+
+        // The names are interned and null-terminated, they are displayed without copy.
+        ImGuiListClipper clipper;
+        clipper.Begin(getRowCount());
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const Entity entity(getRowEntity(row), registry);
+                drawEntityNode(entity, mScene->getEntityName(entity), row);
+            }
+        }
+        clipper.End();
+
+        // Destroying a entity while drawing the rows would move the next rows.
+        if (mEntityToDestroy) {
+            if (mEntityToDestroy == mSelectedEntity) {
+                setSelectedEntity({});
+            }
+            mEntityToDestroy.destroy();
+            mEntityToDestroy = {};
         }
     }
 
@@ -57,20 +84,32 @@ void SceneHierarchyPanel::onImGui(bool& isOpen) {
     }
 
     //
-    // Clear the selection when clicking into the hierachy panel
+    // Clear the selection when clicking into the empty area of the hierachy panel
     //
-    if (ImGui::IsWindowHovered(ImGuiHoveredFlags_None) &&
+    if (ImGui::IsWindowHovered(ImGuiHoveredFlags_None) && !ImGui::IsAnyItemHovered() &&
         ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
-        mSelectedEntity = {};
-        if (mOnSelectionCallback) {
-            mOnSelectionCallback({});
-        }
+        setSelectedEntity({});
     }
 
     ImGui::End();
 }
 
-void SceneHierarchyPanel::drawEntityNode(Entity entity, const std::string& name) {
+void SceneHierarchyPanel::setSelectedEntity(Entity entity) {
+    if (mScene) {
+        auto& registry = mScene->getRegistry();
+        registry.clear<CSelected>();
+        if (entity) {
+            registry.emplace<CSelected>(static_cast<entt::entity>(entity.getId()));
+        }
+    }
+    mSelectedEntity = entity;
+    mAnchorRow      = -1;
+    if (mOnSelectionCallback) {
+        mOnSelectionCallback(entity);
+    }
+}
+
+void SceneHierarchyPanel::drawEntityNode(Entity entity, std::string_view name, int row) {
 
     ImGuiTreeNodeFlags nodeFlags = ImGuiTreeNodeFlags_None;
     nodeFlags |= ImGuiTreeNodeFlags_OpenOnArrow;
@@ -78,13 +117,12 @@ void SceneHierarchyPanel::drawEntityNode(Entity entity, const std::string& name)
     // nodeFlags |= ImGuiTreeNodeFlags_SpanFullWidth;
     nodeFlags |= ImGuiTreeNodeFlags_SpanAvailWidth;
 
-    if (entity == mSelectedEntity) {
+    if (entity.hasComponents<CSelected>()) {
         nodeFlags |= ImGuiTreeNodeFlags_Selected;
     }
 
-    ImGui::PushID(static_cast<int>(entity.getComponent<IDComponent>().id));
-    const std::string nameWithIcon = ICON_MDI_CUBE_OUTLINE " " + name;
-    if (ImGui::TreeNodeEx(nameWithIcon.c_str(), nodeFlags)) {
+    ImGui::PushID(static_cast<int>(entity.getId()));
+    if (ImGui::TreeNodeEx("##Entity", nodeFlags, ICON_MDI_CUBE_OUTLINE " %s", name.data())) {
         //
         // Tree node is open.
         //
@@ -92,10 +130,7 @@ void SceneHierarchyPanel::drawEntityNode(Entity entity, const std::string& name)
     }
 
     if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
-        mSelectedEntity = entity;
-        if (mOnSelectionCallback) {
-            mOnSelectionCallback(entity);
-        }
+        onEntityClicked(entity, row);
     }
 
     //
@@ -107,12 +142,16 @@ void SceneHierarchyPanel::drawEntityNode(Entity entity, const std::string& name)
     if (ImGui::BeginPopupContextItem(nullptr, entityContextWindowFlags)) {
 
         if (ImGui::MenuItem("Delete Entity", nullptr, nullptr)) {
-            entity.destroy();
+            mEntityToDestroy = entity;
         }
         if (ImGui::MenuItem("Duplicate Entity", nullptr, nullptr)) {
             mScene->duplicateEntity(entity);
         } else if (ImGui::MenuItem("Add Mesh", nullptr, nullptr)) {
             entity.addComponent<CMesh>();
+        } else if (ImGui::MenuItem("Add static", nullptr, nullptr)) {
+            entity.addComponent<CStatic>();
+        } else if (ImGui::MenuItem("Add LOD", nullptr, nullptr)) {
+            entity.addComponent<CLod>();
         } else if (ImGui::MenuItem("Add rotator", nullptr, nullptr)) {
             entity.addComponent<CRotator>();
         } else if (ImGui::MenuItem("Add translator", nullptr, nullptr)) {
@@ -125,18 +164,106 @@ void SceneHierarchyPanel::drawEntityNode(Entity entity, const std::string& name)
     ImGui::PopID();
 }
 
+void SceneHierarchyPanel::onEntityClicked(Entity entity, int row) {
+    auto&          registry = mScene->getRegistry();
+    const auto     clicked  = static_cast<entt::entity>(entity.getId());
+    const ImGuiIO& io       = ImGui::GetIO();
+
+    if (io.KeyShift && mAnchorRow >= 0 && mAnchorRow < getRowCount()) {
+        // Select the rows between the anchor and the clicked row, added to the selection
+        // when ctrl is down.
+        if (!io.KeyCtrl) {
+            registry.clear<CSelected>();
+        }
+        for (int i = std::min(mAnchorRow, row); i <= std::max(mAnchorRow, row); i++) {
+            const entt::entity e = getRowEntity(i);
+            if (!registry.all_of<CSelected>(e)) {
+                registry.emplace<CSelected>(e);
+            }
+        }
+    } else if (io.KeyCtrl) {
+        if (registry.all_of<CSelected>(clicked)) {
+            registry.remove<CSelected>(clicked);
+        } else {
+            registry.emplace<CSelected>(clicked);
+        }
+        mAnchorRow = row;
+    } else {
+        registry.clear<CSelected>();
+        registry.emplace<CSelected>(clicked);
+        mAnchorRow = row;
+    }
+
+    // The entity displayed by the inspector, another selected entity if it was deselected.
+    const entt::sparse_set& selection = registry.storage<CSelected>();
+    if (selection.contains(clicked)) {
+        mSelectedEntity = entity;
+    } else if (!selection.empty()) {
+        mSelectedEntity = Entity(*selection.begin(), registry);
+    } else {
+        mSelectedEntity = {};
+    }
+    if (mOnSelectionCallback) {
+        mOnSelectionCallback(mSelectedEntity);
+    }
+}
+
+int SceneHierarchyPanel::getRowCount() const {
+    const std::size_t count = mFilter[0] != '\0'
+                                ? mFilteredEntities.size()
+                                : mScene->getRegistry().storage<NameComponent>().size();
+    return static_cast<int>(count);
+}
+
+entt::entity SceneHierarchyPanel::getRowEntity(int row) const {
+    if (mFilter[0] != '\0') {
+        return mFilteredEntities[static_cast<std::size_t>(row)];
+    }
+    return mScene->getRegistry().storage<NameComponent>().begin()[row];
+}
+
+void SceneHierarchyPanel::updateFilter() {
+    const std::string_view filter(mFilter.data());
+    if (filter.empty()) {
+        if (!mAppliedFilter.empty()) {
+            mAnchorRow = -1;
+        }
+        mAppliedFilter.clear();
+        mFilteredEntities.clear();
+        return;
+    }
+
+    const std::uint64_t version = mScene->getNameVersion();
+    if (version != mFilterVersion || filter != mAppliedFilter) {
+        mScene->findEntitiesByName(filter, mFilteredEntities);
+        mAppliedFilter = filter;
+        mFilterVersion = version;
+        mAnchorRow     = -1;
+    }
+}
+
 void SceneHierarchyPanel::drawMenuEntity3d() {
     if (ImGui::BeginMenu("3D Object")) {
         if (ImGui::MenuItem("Cube")) {
             Entity entity = mScene->createEntity("Cube");
             entity.addComponent<CTransform>();
             entity.addComponent<CMesh>();
-        } else if (ImGui::MenuItem("Sphere", nullptr, nullptr, false)) {
-            mScene->createEntity("Sphere");
-        } else if (ImGui::MenuItem("Plane", nullptr, nullptr, false)) {
-            mScene->createEntity("Plane");
-        } else if (ImGui::MenuItem("Cylinder", nullptr, nullptr, false)) {
-            mScene->createEntity("Cylinder");
+        } else if (ImGui::MenuItem("Sphere")) {
+            Entity entity = mScene->createEntity("Sphere");
+            entity.addComponent<CTransform>();
+            entity.addComponent<CMesh>().mesh = MeshHandle::kSphere;
+            auto& lod       = entity.addComponent<CLod>();
+            lod.meshes      = {MeshHandle::kSphereMedium, MeshHandle::kSphereLow};
+            lod.screenSizes = {0.2f, 0.05f};
+            lod.levelCount  = 2;
+        } else if (ImGui::MenuItem("Plane")) {
+            Entity entity = mScene->createEntity("Plane");
+            entity.addComponent<CTransform>();
+            entity.addComponent<CMesh>().mesh = MeshHandle::kPlane;
+        } else if (ImGui::MenuItem("Cylinder")) {
+            Entity entity = mScene->createEntity("Cylinder");
+            entity.addComponent<CTransform>();
+            entity.addComponent<CMesh>().mesh = MeshHandle::kCylinder;
         }
         ImGui::EndMenu();
     }
@@ -5,13 +5,27 @@
 
 #include <entt/entity/entity.hpp>
 
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace fuse {
 class Scene;
 
 /// @brief ImGui panel to display entity in the a scene.
+///
+/// Only the visible rows are drawn (ImGuiListClipper), so the cost of the panel does not
+/// depend on the number of entities. The entities matching the search box are kept between
+/// frames and only searched again (see Scene::findEntitiesByName()) when the filter or a
+/// name change.
+///
+/// The selected entities are tagged with CSelected: a click select a entity, ctrl+click add
+/// or remove it from the selection and shift+click select the rows from the last clicked
+/// row. The selected entity given to the callback is the one shown by the inspector.
 class SceneHierarchyPanel : public EditorPanel {
 public:
     SceneHierarchyPanel();
@@ -30,16 +44,42 @@ public:
         mOnSelectionCallback = std::move(callback);
     }
 
+    /// @brief Select a entity selected outside of the panel (the viewport for example).
+    ///
+    /// The selection callback is called as if the entity was clicked in the panel, the other
+    /// entities are deselected.
+    /// @param entity The entity to select, or a invalid entity to clear the selection.
+    void setSelectedEntity(Entity entity);
+
     void onImGui(bool& isOpen) override;
 
 private:
-    void drawEntityNode(Entity entity, const std::string& name);
+    void drawEntityNode(Entity entity, std::string_view name, int row);
     void drawMenuEntity3d();
 
+    /// @brief Update the selection after a click on a row.
+    void onEntityClicked(Entity entity, int row);
+
+    /// @brief Get the number of rows, the entities matching the filter.
+    [[nodiscard]] int getRowCount() const;
+
+    /// @brief Get the entity displayed by a row.
+    [[nodiscard]] entt::entity getRowEntity(int row) const;
+
+    /// @brief Update mFilteredEntities if the filter or the names changed.
+    void updateFilter();
+
     Scene*                      mScene{};
     bool                        mIsVisible{true};
     Entity                      mSelectedEntity;
     std::function<void(Entity)> mOnSelectionCallback;
+    Entity                      mEntityToDestroy; ///< Destroyed after drawing the rows.
+    int                         mAnchorRow = -1;  ///< Start of a shift+click range.
+
+    std::array<char, 128>     mFilter{};         ///< Text of the search box.
+    std::string               mAppliedFilter;    ///< Filter of mFilteredEntities.
+    std::vector<entt::entity> mFilteredEntities; ///< Entities with a name matching the filter.
+    std::uint64_t mFilterVersion = std::numeric_limits<std::uint64_t>::max(); ///< Name version.
 };
 
 } // namespace fuse
@@ -2,19 +2,34 @@
 
 #include "FuseApp/ImGui/Widget.h"
 
+#include <FuseCore/scene/Lod.h>
+#include <FuseCore/scene/RenderList.h>
+#include <FuseCore/scene/Scene.h>
 #include <FuseEditor/embed/fonts/IconsMaterialDesignIcons.h>
 
 #include <imgui.h>
 #include <imgui_internal.h>
 
+#include <algorithm>
+#include <chrono>
+
 namespace fuse {
 
 ScenePanel::ScenePanel() {
     mEditorCamera.setPosition({0, 0, 10});
     mSceneRenderer = std::make_unique<SceneRenderer>();
+    glCreateFramebuffers(1, &mFbo);
+
+    // the renderer write the color in the attachment 0 and the pick ids in the attachment 1
+    const GLenum drawBuffers[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glNamedFramebufferDrawBuffers(mFbo, 2, drawBuffers);
 }
 
-ScenePanel::~ScenePanel() { mSceneRenderer.reset(); }
+ScenePanel::~ScenePanel() {
+    mSceneRenderer.reset();
+    glDeleteFramebuffers(1, &mFbo);
+    releaseRenderTargets();
+}
 
 void ScenePanel::onImGui(bool& isOpen) {
     if (!isOpen) {
@@ -23,28 +38,84 @@ void ScenePanel::onImGui(bool& isOpen) {
 
     ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 1));
     if (ImGui::Begin(ICON_MDI_GAMEPAD_VARIANT " Viewport###Viewport", &isOpen)) {
-        createOrResizeFBO(static_cast<int>(ImGui::GetContentRegionAvail().x),
-                          static_cast<int>(ImGui::GetContentRegionAvail().y));
+        resizeRenderTargets(static_cast<int>(ImGui::GetContentRegionAvail().x),
+                            static_cast<int>(ImGui::GetContentRegionAvail().y));
 
         mEditorCamera.update(ImGui::GetIO().DeltaTime);
 
+        // the pick of a previous frame
+        if (const auto pickId = mPickReadback.poll()) {
+            selectEntity(fromPickId(*pickId));
+        }
+
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFbo);
-        glClearColor(1.0f, .0f, .0f, 1.f);
         glEnable(GL_DEPTH_TEST);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        const GLfloat clearColor[] = {1.0f, 0.0f, 0.0f, 1.0f};
+        const GLuint  clearPickId  = 0; // no entity
+        glClearNamedFramebufferfv(mFbo, GL_COLOR, 0, clearColor);
+        glClearNamedFramebufferuiv(mFbo, GL_COLOR, 1, &clearPickId);
+        glClearNamedFramebufferfi(mFbo, GL_DEPTH_STENCIL, 0, 1.0f, 0);
 
         mEditorCamera.setAspectRatio(static_cast<float>(mWidth) / static_cast<float>(mHeight));
         const auto proj = mEditorCamera.getProjMatrix();
         const auto view = mEditorCamera.getViewMatrix();
         glViewport(0, 0, mWidth, mHeight);
+        const auto lodStats = selectLods(*mScene, proj, view);
         mSceneRenderer->renderScene(*mScene, proj, view);
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 
-        ImGui::GetWindowDrawList()->AddImage(mTexColorBuffer,
+        if (ImGui::IsWindowHovered() && !ImGui::IsAnyItemHovered() &&
+            ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
+            pick(ImGui::GetMousePos().x, ImGui::GetMousePos().y);
+        }
+
+        // the viewport is the bottom left part of the render target
+        const ImVec2 uvMax(static_cast<float>(mWidth) / static_cast<float>(mTargetDesc.width),
+                           static_cast<float>(mHeight) / static_cast<float>(mTargetDesc.height));
+        ImGui::GetWindowDrawList()->AddImage(mColorTarget,
                                              ImGui::GetWindowPos(),
                                              ImGui::GetWindowPos() + ImGui::GetWindowSize(),
-                                             ImVec2(0, 1) /*upper-left*/,
-                                             ImVec2(1, 0) /*bottom-right*/);
+                                             ImVec2(0, uvMax.y) /*upper-left*/,
+                                             ImVec2(uvMax.x, 0) /*bottom-right*/);
+        const auto& stats = mSceneRenderer->getStats();
+        ImGuiTextFmt("Draws                 {} ({} transparent) in {} batches",
+                     stats.drawCount,
+                     stats.transparentCount,
+                     stats.batchCount);
+        ImGuiTextFmt("State changes         shader {} material {} mesh {}",
+                     stats.shaderChanges,
+                     stats.materialChanges,
+                     stats.meshChanges);
+        ImGuiTextFmt("LOD                   {} entities {} triangles {} saved",
+                     lodStats.entityCount,
+                     lodStats.triangleCount,
+                     lodStats.savedTriangleCount);
+        const auto& staticBatcher = mSceneRenderer->getStaticBatcher();
+        ImGuiTextFmt("Static                {} entities in {} batches",
+                     staticBatcher.getEntityCount(),
+                     staticBatcher.getBatches().size());
+        bool occlusionCulling = mSceneRenderer->isOcclusionCulling();
+        if (ImGui::Checkbox("Occlusion culling", &occlusionCulling)) {
+            mSceneRenderer->setOcclusionCulling(occlusionCulling);
+        }
+        ImGui::Checkbox("GPU picking", &mGpuPicking);
+        if (!mGpuPicking) {
+            ImGuiTextFmt("Raycast               {:.1f} us", mRaycastTime);
+        }
+        const auto& occlusion = mSceneRenderer->getOcclusionStats();
+        ImGuiTextFmt("Occlusion             {} occluders {} triangles {}/{} culled",
+                     occlusion.occluderCount,
+                     occlusion.triangleCount,
+                     occlusion.culledCount,
+                     occlusion.testedCount);
+        const auto targetStats = mRenderTargets.getStats();
+        ImGuiTextFmt("Render targets        {}x{} {} used {} free {} created {} reused",
+                     mTargetDesc.width,
+                     mTargetDesc.height,
+                     targetStats.usedCount,
+                     targetStats.freeCount,
+                     targetStats.createdCount,
+                     targetStats.reusedCount);
         ImGuiTextFmt("GetContentRegionAvail {}x{}",
                      ImGui::GetContentRegionAvail().x,
                      ImGui::GetContentRegionAvail().y);
@@ -71,44 +142,83 @@ void ScenePanel::onImGui(bool& isOpen) {
     }
     ImGui::PopStyleColor(1);
     ImGui::End();
+    mRenderTargets.endFrame();
 }
 
-void ScenePanel::createOrResizeFBO(int width, int height) {
-    if (mWidth == width && mHeight == height) {
+void ScenePanel::resizeRenderTargets(int width, int height) {
+    mWidth  = std::max(width, 1);
+    mHeight = std::max(height, 1);
+
+    const RenderTargetDesc desc{.width  = roundUpToBucket(static_cast<std::uint32_t>(mWidth),
+                                                         kTargetBucket),
+                                .height = roundUpToBucket(static_cast<std::uint32_t>(mHeight),
+                                                          kTargetBucket),
+                                .format = RenderTargetFormat::RGBA8};
+    if (mColorTarget != 0 && desc == mTargetDesc) {
         return;
     }
-    mWidth  = width;
-    mHeight = height;
-
+    mTargetDesc = desc;
+
+    // the previous targets stay in the pool, ready if the size come back
+    releaseRenderTargets();
+    mColorTarget = mRenderTargets.acquire(desc);
+    mDepthTarget = mRenderTargets.acquire(
+      {.width = desc.width, .height = desc.height, .format = RenderTargetFormat::Depth24Stencil8});
+    mEntityTarget = mRenderTargets.acquire(
+      {.width = desc.width, .height = desc.height, .format = RenderTargetFormat::R32UI});
+
+    glNamedFramebufferTexture(mFbo, GL_COLOR_ATTACHMENT0, mColorTarget, 0 /*level*/);
+    glNamedFramebufferTexture(mFbo, GL_COLOR_ATTACHMENT1, mEntityTarget, 0 /*level*/);
+    glNamedFramebufferRenderbuffer(mFbo,
+                                   GL_DEPTH_STENCIL_ATTACHMENT,
+                                   GL_RENDERBUFFER,
+                                   mDepthTarget);
+}
 
-    if (mFbo == 0) {
-        glCreateTextures(GL_TEXTURE_2D, 1, &mTexColorBuffer);
-        glCreateRenderbuffers(1, &mTexDepthBuffer);
-        glCreateFramebuffers(1, &mFbo);
-    } else {
-        glDeleteTextures(1, &mTexColorBuffer);
-        glDeleteRenderbuffers(1, &mTexDepthBuffer);
+void ScenePanel::releaseRenderTargets() {
+    // the depth target is a renderbuffer, it name can be the name of a color texture.
+    mRenderTargets.release(mColorTarget, RenderTargetFormat::RGBA8);
+    mRenderTargets.release(mDepthTarget, RenderTargetFormat::Depth24Stencil8);
+    mRenderTargets.release(mEntityTarget, RenderTargetFormat::R32UI);
+}
 
-        glCreateTextures(GL_TEXTURE_2D, 1, &mTexColorBuffer);
-        glCreateRenderbuffers(1, &mTexDepthBuffer);
-        glCreateFramebuffers(1, &mFbo);
+void ScenePanel::pick(float mouseX, float mouseY) {
+    // the image of the viewport is stretched over the window
+    const ImVec2 windowPos  = ImGui::GetWindowPos();
+    const ImVec2 windowSize = ImGui::GetWindowSize();
+    const float  u          = (mouseX - windowPos.x) / windowSize.x;
+    const float  v          = (mouseY - windowPos.y) / windowSize.y;
+    if (u < 0.0f || u >= 1.0f || v < 0.0f || v >= 1.0f) {
+        return;
     }
 
-    glTextureStorage2D(mTexColorBuffer, 1, GL_RGBA8 /*internalformat*/, mWidth, mHeight);
-    glTextureParameteri(mTexColorBuffer, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTextureParameteri(mTexColorBuffer, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glNamedRenderbufferStorage(mTexDepthBuffer,
-                               GL_DEPTH24_STENCIL8 /*internalformat*/,
-                               mWidth,
-                               mHeight);
+    if (!mGpuPicking) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto ray   = mEditorCamera.computeRay(u * 2.0f - 1.0f, 1.0f - v * 2.0f);
+        const auto hit   = mScene->raycast(ray.origin, ray.direction);
+        mRaycastTime     = std::chrono::duration<float, std::micro>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+        selectEntity(hit.entity);
+        return;
+    }
 
+    // the rows of the framebuffer start from the bottom
+    const int x = std::min(static_cast<int>(u * static_cast<float>(mWidth)), mWidth - 1);
+    const int y = std::min(static_cast<int>(v * static_cast<float>(mHeight)), mHeight - 1);
+    mPickReadback.request(mFbo, GL_COLOR_ATTACHMENT1, x, mHeight - 1 - y);
+}
 
-    glNamedFramebufferTexture(mFbo, GL_COLOR_ATTACHMENT0, mTexColorBuffer, 0 /*level*/);
-    glNamedFramebufferRenderbuffer(mFbo,
-                                   GL_DEPTH_STENCIL_ATTACHMENT,
-                                   GL_RENDERBUFFER,
-                                   mTexDepthBuffer);
+void ScenePanel::selectEntity(entt::entity entity) {
+    if (!mOnSelectionCallback) {
+        return;
+    }
+    auto& registry = mScene->getRegistry();
+    if (entity == entt::null || !registry.valid(entity)) {
+        mOnSelectionCallback({}); // the background or a entity destroyed since the click
+        return;
+    }
+    mOnSelectionCallback(Entity(entity, registry));
 }
 
 } // namespace fuse
@@ -1,10 +1,17 @@
 #pragma once
 #include "../EditorCamera.h"
 #include "EditorPanel.h"
+#include "FuseApp/PixelReadback.h"
+#include "FuseApp/RenderTargets.h"
 #include "FuseApp/SceneRenderer.h"
 
+#include <FuseCore/scene/Entity.h>
+
 #include <glad/glad.h>
 
+#include <cstdint>
+#include <functional>
+
 namespace fuse {
 class Scene;
 
@@ -24,16 +31,55 @@ public:
     /// @param scene The scene to used.
     void setScene(Scene* scene) { mScene = scene; }
 
+    /// @brief Set the callback called when a entity is clicked in the viewport.
+    ///
+    /// The entity is invalid when the background is clicked. The pick is read back
+    /// asynchronously, the callback is called a frame or two after the click.
+    void setSelectionCallback(std::function<void(Entity)> callback) {
+        mOnSelectionCallback = std::move(callback);
+    }
+
 private:
-    void                           createOrResizeFBO(int width, int height);
+    /// @brief Granularity of the size of the render targets, in pixels.
+    static constexpr std::uint32_t kTargetBucket = 128;
+
+    /// @brief Resize the viewport, reallocate the render targets if needed.
+    ///
+    /// The targets are rounded up to kTargetBucket, so resizing the dock only reallocate
+    /// them when the size cross a bucket, and come from a pool which keep the previous
+    /// targets a few frames when the size go back and forth.
+    void resizeRenderTargets(int width, int height);
+
+    /// @brief Give back the render targets to the pool.
+    void releaseRenderTargets();
+
+    /// @brief Pick the entity under a point of the screen.
+    ///
+    /// With the GPU picking the pixel of the entity target is read back asynchronously,
+    /// otherwise a ray is cast from the camera through the point (see Scene::raycast()).
+    /// @param mouseX The position of the point on the screen, in pixels.
+    /// @param mouseY The position of the point on the screen, in pixels.
+    void pick(float mouseX, float mouseY);
+
+    /// @brief Forward a picked entity to the selection callback.
+    /// @param entity The entity, or null for the background.
+    void selectEntity(entt::entity entity);
+
     Scene*                         mScene{};
-    GLuint                         mFbo            = 0;
-    GLuint                         mTexColorBuffer = 0;
-    GLuint                         mTexDepthBuffer = 0;
-    int                            mWidth          = 0;
-    int                            mHeight         = 0;
+    RenderTargetPool               mRenderTargets{createRenderTarget, destroyRenderTarget};
+    GLuint                         mFbo = 0;
+    RenderTargetPool::Handle       mColorTarget{};
+    RenderTargetPool::Handle       mDepthTarget{};
+    RenderTargetPool::Handle       mEntityTarget{};   ///< Pick id of the entity of each pixel.
+    RenderTargetDesc               mTargetDesc;       ///< Size of the targets, >= the viewport.
+    int                            mWidth  = 0;       ///< Width of the viewport.
+    int                            mHeight = 0;       ///< Height of the viewport.
     std::unique_ptr<SceneRenderer> mSceneRenderer;
     EditorCamera                   mEditorCamera;
+    PixelReadback                  mPickReadback;
+    bool                           mGpuPicking{true}; ///< Pick with the entity target or a ray.
+    float                          mRaycastTime{};    ///< Duration of the last raycast in us.
+    std::function<void(Entity)>    mOnSelectionCallback;
 };
 
 
@@ -0,0 +1,114 @@
+#include <FuseCore/scene/ComponentReflection.h>
+#include <FuseCore/scene/Scene.h>
+#include <FuseCore/scene/SceneSerializer.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+using fuse::CLod;
+using fuse::CMesh;
+using fuse::CStatic;
+using fuse::CTransform;
+using fuse::FieldType;
+using fuse::kComponentInfo;
+using fuse::SceneSerializer;
+using fuse::Vec3;
+
+TEST(ComponentReflection, fieldTables) {
+    constexpr const fuse::ComponentInfo& transform = kComponentInfo<CTransform>;
+    static_assert(transform.name == "CTransform");
+    static_assert(transform.size == sizeof(CTransform));
+    static_assert(transform.fields.size() == 3);
+    static_assert(transform.fields[1].name == "rotation");
+    static_assert(transform.fields[1].offset == offsetof(CTransform, rotation));
+    static_assert(transform.fields[1].type == FieldType::Vec3);
+
+    // std::array are a field with many elements
+    constexpr const fuse::ComponentInfo& lod = kComponentInfo<CLod>;
+    static_assert(lod.fields.size() == 3);
+    static_assert(lod.fields[1].name == "meshes");
+    static_assert(lod.fields[1].type == FieldType::Mesh);
+    static_assert(lod.fields[1].count == CLod::kMaxLevels);
+    static_assert(lod.fields[1].size == sizeof(CLod::meshes));
+    static_assert(lod.fields[2].max == 1.0f);
+
+    static_assert(kComponentInfo<CStatic>.size == 0);
+    static_assert(kComponentInfo<CStatic>.fields.empty());
+
+    EXPECT_EQ(kComponentInfo<CMesh>.fields[0].typeName, fuse::getTypeName<fuse::Vec4>());
+}
+
+TEST(ComponentReflection, findComponentInfo) {
+    const fuse::Scene scene; // register the reflected components
+    EXPECT_EQ(fuse::findComponentInfo(kComponentInfo<CMesh>.id), &kComponentInfo<CMesh>);
+    EXPECT_EQ(fuse::findComponentInfo(kComponentInfo<CStatic>.id), &kComponentInfo<CStatic>);
+    EXPECT_EQ(fuse::findComponentInfo(0), nullptr);
+}
+
+TEST(SceneSerializer, roundTrip) {
+    fuse::Scene scene;
+    auto        entity1 = scene.createEntity("first");
+    auto        entity2 = scene.createEntity("second");
+    entity1.addComponent<CTransform>(Vec3{1, 2, 3}, Vec3{4, 5, 6}, Vec3{7, 8, 9});
+    entity1.addComponent<CStatic>();
+    entity2.addComponent<CMesh>(fuse::Vec4{0.5f, 0.5f, 0.5f, 1.0f}, fuse::MeshHandle{2}, true);
+    auto& lod      = entity2.addComponent<CLod>();
+    lod.meshes[0]  = fuse::MeshHandle{3};
+    lod.levelCount = 1;
+    lod.level      = 1; // not reflected, not saved
+
+    const auto data = SceneSerializer::Serialize(scene);
+
+    fuse::Scene loaded;
+    ASSERT_TRUE(SceneSerializer::Deserialize(data, loaded));
+    EXPECT_EQ(loaded.getEntityCount(), 2);
+
+    auto copy1 = loaded.findEntity(entity1.getComponent<fuse::IDComponent>().id);
+    ASSERT_TRUE(copy1.isValid());
+    EXPECT_EQ(loaded.getEntityName(copy1), "first");
+    EXPECT_EQ(copy1.getComponent<CTransform>().rotation, (Vec3{4, 5, 6}));
+    EXPECT_TRUE(copy1.hasComponents<CStatic>());
+    EXPECT_FALSE(copy1.hasComponents<CMesh>());
+
+    auto copy2 = loaded.findEntity(entity2.getComponent<fuse::IDComponent>().id);
+    ASSERT_TRUE(copy2.isValid());
+    EXPECT_EQ(loaded.getEntityName(copy2), "second");
+    EXPECT_EQ(copy2.getComponent<CMesh>().mesh, fuse::MeshHandle{2});
+    EXPECT_TRUE(copy2.getComponent<CMesh>().occluder);
+    EXPECT_EQ(copy2.getComponent<CLod>().meshes[0], fuse::MeshHandle{3});
+    EXPECT_EQ(copy2.getComponent<CLod>().levelCount, 1);
+    EXPECT_EQ(copy2.getComponent<CLod>().level, 0);
+    EXPECT_FALSE(copy2.hasComponents<CTransform>());
+
+    // truncated data are rejected
+    fuse::Scene truncated;
+    EXPECT_FALSE(SceneSerializer::Deserialize(std::span(data).first(data.size() - 1), truncated));
+}
+
+TEST(SceneSerializer, invalidValues) {
+    fuse::Scene scene;
+    auto        entity = scene.createEntity("entity");
+    entity.addComponent<CMesh>().mesh = fuse::MeshHandle{1000}; // saved with other meshes
+    auto& lod      = entity.addComponent<CLod>();
+    lod.meshes[0]  = fuse::MeshHandle::kSphere;
+    lod.meshes[1]  = fuse::MeshHandle{2000};
+    lod.levelCount = 200;
+    const auto data = SceneSerializer::Serialize(scene);
+
+    // the invalid handles take the default value, the level count is clamped
+    fuse::Scene loaded;
+    ASSERT_TRUE(SceneSerializer::Deserialize(data, loaded));
+    auto copy = loaded.findEntity(entity.getComponent<fuse::IDComponent>().id);
+    ASSERT_TRUE(copy.isValid());
+    EXPECT_EQ(copy.getComponent<CMesh>().mesh, fuse::MeshHandle::kCube);
+    EXPECT_EQ(copy.getComponent<CLod>().meshes[0], fuse::MeshHandle::kSphere);
+    EXPECT_EQ(copy.getComponent<CLod>().meshes[1], fuse::MeshHandle{});
+    EXPECT_EQ(copy.getComponent<CLod>().levelCount, CLod::kMaxLevels);
+
+    // loaded again in the same scene, the copy get a new UUID
+    ASSERT_TRUE(SceneSerializer::Deserialize(data, loaded));
+    EXPECT_EQ(loaded.getEntityCount(), 2);
+    EXPECT_EQ(loaded.findEntity(entity.getComponent<fuse::IDComponent>().id), copy);
+}
@@ -0,0 +1,113 @@
+#include <FuseCore/EventRecorder.h>
+
+#include <gtest/gtest.h>
+
+#include <string_view>
+#include <vector>
+
+using fuse::Event;
+using fuse::EventPlayer;
+using fuse::EventRecorder;
+
+TEST(EventRecorder, empty) {
+    EventRecorder recorder;
+    EXPECT_EQ(recorder.getFrameCount(), 0);
+
+    EventPlayer player;
+    ASSERT_TRUE(player.load({recorder.getData().begin(), recorder.getData().end()}));
+    EXPECT_EQ(player.getFrameCount(), 0);
+    EXPECT_TRUE(player.isFinished());
+    EXPECT_FALSE(player.nextFrame().has_value());
+}
+
+TEST(EventRecorder, replay) {
+    EventRecorder recorder;
+    recorder.record(fuse::KeyPressedEvent(
+      fuse::ScanCode::A, fuse::KeyCode{}, false, fuse::KeyModMask{fuse::KeyModFlag::LeftShift}));
+    recorder.record(fuse::MouseMovedEvent(10.f, 20.f, 1.f, 2.f, {}));
+    recorder.endFrame(0.016f);
+    recorder.endFrame(0.017f); // frame without event
+    recorder.record(fuse::TextInputEvent("hello"));
+    recorder.record(fuse::WindowResizedEvent(800, 600));
+    recorder.endFrame(0.018f);
+    EXPECT_EQ(recorder.getFrameCount(), 3);
+
+    EventPlayer player;
+    ASSERT_TRUE(player.load({recorder.getData().begin(), recorder.getData().end()}));
+    EXPECT_EQ(player.getFrameCount(), 3);
+
+    auto frame = player.nextFrame();
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->index, 0);
+    EXPECT_FLOAT_EQ(frame->deltaTime, 0.016f);
+    ASSERT_EQ(frame->events.size(), 2);
+    const auto* key = frame->events[0].getIf<fuse::KeyPressedEvent>();
+    ASSERT_NE(key, nullptr);
+    EXPECT_EQ(key->getScanCode(), fuse::ScanCode::A);
+    EXPECT_TRUE(key->isLeftShift());
+    const auto* mouse = frame->events[1].getIf<fuse::MouseMovedEvent>();
+    ASSERT_NE(mouse, nullptr);
+    EXPECT_EQ(mouse->getMousePosition(), std::make_pair(10.f, 20.f));
+    EXPECT_EQ(mouse->getMouseDelta(), std::make_pair(1.f, 2.f));
+
+    frame = player.nextFrame();
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->index, 1);
+    EXPECT_TRUE(frame->events.empty());
+
+    frame = player.nextFrame();
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->index, 2);
+    ASSERT_EQ(frame->events.size(), 2);
+    const auto* text = frame->events[0].getIf<fuse::TextInputEvent>();
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(std::string_view(text->getText()), "hello");
+    const auto* resize = frame->events[1].getIf<fuse::WindowResizedEvent>();
+    ASSERT_NE(resize, nullptr);
+    EXPECT_EQ(resize->getWidth(), 800);
+    EXPECT_EQ(resize->getHeight(), 600);
+
+    EXPECT_TRUE(player.isFinished());
+    EXPECT_FALSE(player.nextFrame().has_value());
+
+    player.rewind();
+    frame = player.nextFrame();
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->index, 0);
+    EXPECT_EQ(frame->events.size(), 2);
+}
+
+TEST(EventRecorder, invalidLog) {
+    EventPlayer player;
+    EXPECT_FALSE(player.load({}));
+    EXPECT_FALSE(player.load(std::vector<char>(64, 'x')));
+
+    // truncated log
+    EventRecorder recorder;
+    recorder.record(fuse::WindowResizedEvent(800, 600));
+    recorder.endFrame(0.016f);
+    std::vector<char> data(recorder.getData().begin(), recorder.getData().end() - 1);
+    ASSERT_TRUE(player.load(std::move(data)));
+    EXPECT_FALSE(player.nextFrame().has_value());
+    EXPECT_TRUE(player.isFinished());
+}
+
+TEST(EventRecorder, manyEventsPerFrame) {
+    constexpr int kEventCount = 70000; // more than a 16 bits count
+
+    EventRecorder recorder;
+    for (int i = 0; i < kEventCount; i++) {
+        recorder.record(fuse::WindowResizedEvent(i, 600));
+    }
+    recorder.endFrame(0.016f);
+
+    EventPlayer player;
+    ASSERT_TRUE(player.load({recorder.getData().begin(), recorder.getData().end()}));
+    const auto frame = player.nextFrame();
+    ASSERT_TRUE(frame.has_value());
+    ASSERT_EQ(frame->events.size(), kEventCount);
+    const auto* resize = frame->events.back().getIf<fuse::WindowResizedEvent>();
+    ASSERT_NE(resize, nullptr);
+    EXPECT_EQ(resize->getWidth(), kEventCount - 1);
+    EXPECT_TRUE(player.isFinished());
+}
@@ -0,0 +1,48 @@
+#include <FuseCore/utils/FixedTimestep.h>
+
+#include <gtest/gtest.h>
+
+using fuse::FixedTimestep;
+
+TEST(FixedTimestep, ctor) {
+    const FixedTimestep timestep(50.0f, 3);
+    EXPECT_FLOAT_EQ(timestep.getStep(), 0.02f);
+    EXPECT_EQ(timestep.getMaxSteps(), 3);
+    EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.0f);
+}
+
+TEST(FixedTimestep, advance) {
+    FixedTimestep timestep(10.0f, 5);
+
+    // not enough time for a step
+    EXPECT_EQ(timestep.advance(0.05f), 0);
+    EXPECT_NEAR(timestep.getAlpha(), 0.5f, 1e-5f);
+
+    // the remaining time is accumulated
+    EXPECT_EQ(timestep.advance(0.07f), 1);
+    EXPECT_NEAR(timestep.getAlpha(), 0.2f, 1e-5f);
+
+    EXPECT_EQ(timestep.advance(0.2f), 2);
+    EXPECT_NEAR(timestep.getAlpha(), 0.2f, 1e-5f);
+
+    // negative time is ignored
+    EXPECT_EQ(timestep.advance(-1.0f), 0);
+    EXPECT_NEAR(timestep.getAlpha(), 0.2f, 1e-5f);
+    EXPECT_FLOAT_EQ(timestep.getDroppedTime(), 0.0f);
+}
+
+TEST(FixedTimestep, maxSteps) {
+    FixedTimestep timestep(10.0f, 2);
+
+    // a long frame is clamped to the max steps, the extra time is dropped.
+    EXPECT_EQ(timestep.advance(1.05f), 2);
+    EXPECT_NEAR(timestep.getAlpha(), 0.5f, 1e-4f);
+    EXPECT_NEAR(timestep.getDroppedTime(), 0.8f, 1e-4f);
+
+    // the next frame does not try to catch up.
+    EXPECT_EQ(timestep.advance(0.1f), 1);
+
+    timestep.reset();
+    EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.0f);
+    EXPECT_FLOAT_EQ(timestep.getDroppedTime(), 0.0f);
+}
@@ -0,0 +1,76 @@
+#include <FuseCore/Event.h>
+#include <FuseCore/Input.h>
+
+#include <gtest/gtest.h>
+
+using fuse::Input;
+using fuse::MouseButton;
+using fuse::ScanCode;
+
+namespace {
+
+void pressKey(ScanCode key) {
+    Input::OnEvent(fuse::KeyPressedEvent(key, fuse::KeyCode{}, false, fuse::KeyModMask{}));
+}
+
+void releaseKey(ScanCode key) {
+    Input::OnEvent(fuse::KeyReleasedEvent(key, fuse::KeyCode{}, fuse::KeyModMask{}));
+}
+
+} // namespace
+
+TEST(Input, keyboard) {
+    pressKey(ScanCode::A);
+    EXPECT_TRUE(Input::IsKeyPressed(ScanCode::A));
+    EXPECT_TRUE(Input::IsKeyDown(ScanCode::A));
+    EXPECT_FALSE(Input::IsKeyReleased(ScanCode::A));
+    EXPECT_FALSE(Input::IsKeyDown(ScanCode::B));
+
+    // next frame, the key is held
+    Input::UpdateStates();
+    EXPECT_FALSE(Input::IsKeyPressed(ScanCode::A));
+    EXPECT_TRUE(Input::IsKeyDown(ScanCode::A));
+
+    releaseKey(ScanCode::A);
+    EXPECT_TRUE(Input::IsKeyReleased(ScanCode::A));
+    EXPECT_FALSE(Input::IsKeyDown(ScanCode::A));
+
+    Input::UpdateStates();
+    EXPECT_FALSE(Input::IsKeyReleased(ScanCode::A));
+    EXPECT_FALSE(Input::IsKeyDown(ScanCode::A));
+}
+
+TEST(Input, mouse) {
+    Input::OnEvent(fuse::MouseButtonEvent(MouseButton::Left, true, 1, 0.f, 0.f));
+    EXPECT_TRUE(Input::IsButtonPressed(MouseButton::Left));
+    EXPECT_TRUE(Input::IsButtonDown(MouseButton::Left));
+    EXPECT_FALSE(Input::IsButtonDown(MouseButton::Right));
+
+    Input::OnEvent(fuse::MouseMovedEvent(10.f, 20.f, 1.f, 2.f, {}));
+    EXPECT_EQ(Input::GetMousePosition(), std::make_pair(10.f, 20.f));
+    EXPECT_EQ(Input::GetMousePositionDelta(), std::make_pair(1.f, 2.f));
+
+    Input::UpdateStates();
+    EXPECT_FALSE(Input::IsButtonPressed(MouseButton::Left));
+    EXPECT_TRUE(Input::IsButtonDown(MouseButton::Left));
+    EXPECT_EQ(Input::GetMousePosition(), std::make_pair(10.f, 20.f));
+    EXPECT_EQ(Input::GetMousePositionDelta(), std::make_pair(0.f, 0.f));
+
+    Input::OnEvent(fuse::MouseButtonEvent(MouseButton::Left, false, 1, 0.f, 0.f));
+    EXPECT_TRUE(Input::IsButtonReleased(MouseButton::Left));
+    EXPECT_FALSE(Input::IsButtonDown(MouseButton::Left));
+    Input::UpdateStates();
+}
+
+TEST(Input, snapshot) {
+    pressKey(ScanCode::Space);
+    const auto snapshot = Input::GetSnapshot();
+    EXPECT_TRUE(snapshot.isKeyPressed(ScanCode::Space));
+    EXPECT_TRUE(snapshot.isKeyDown(ScanCode::Space));
+
+    // a snapshot is a copy, it does not change with the input state.
+    releaseKey(ScanCode::Space);
+    Input::UpdateStates();
+    EXPECT_TRUE(snapshot.isKeyDown(ScanCode::Space));
+    EXPECT_FALSE(Input::GetSnapshot().isKeyDown(ScanCode::Space));
+}
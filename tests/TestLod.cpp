@@ -0,0 +1,108 @@
+#include <FuseCore/scene/Lod.h>
+#include <FuseCore/scene/RenderList.h>
+#include <FuseCore/scene/Scene.h>
+
+#include <gtest/gtest.h>
+
+using fuse::CLod;
+using fuse::Mat4;
+using fuse::MeshHandle;
+
+namespace {
+
+/// @brief A sphere with two coarser levels, used under 20% and 5% of the screen height.
+CLod createSphereLod() {
+    CLod lod;
+    lod.meshes      = {MeshHandle::kSphereMedium, MeshHandle::kSphereLow};
+    lod.screenSizes = {0.2f, 0.05f};
+    lod.levelCount  = 2;
+    return lod;
+}
+
+Mat4 perspective() {
+    return Mat4::CreateProjectionPerspectiveFOVY(fuse::degrees(90.0f), 1.0f, 0.1f, 1000.0f);
+}
+
+} // namespace
+
+TEST(Lod, computeScreenSize) {
+    // a fov of 90 degrees see a height of 2 * distance
+    EXPECT_NEAR(fuse::computeScreenSize(1.0f, 10.0f, perspective()), 0.1f, 1e-5f);
+    EXPECT_NEAR(fuse::computeScreenSize(1.0f, 20.0f, perspective()), 0.05f, 1e-5f);
+    EXPECT_GT(fuse::computeScreenSize(1.0f, 0.5f, perspective()), 1.0f); // inside the sphere
+
+    // orthographic, independent of the distance
+    const auto ortho = Mat4::CreateProjectionOrthographic(10.0f, 10.0f, 0.1f, 100.0f);
+    EXPECT_NEAR(fuse::computeScreenSize(1.0f, 10.0f, ortho), 0.2f, 1e-5f);
+    EXPECT_NEAR(fuse::computeScreenSize(1.0f, 50.0f, ortho), 0.2f, 1e-5f);
+}
+
+TEST(Lod, selectLodLevel) {
+    CLod lod = createSphereLod();
+    EXPECT_EQ(fuse::selectLodLevel(lod, 0.5f, 0.1f), 0);
+    EXPECT_EQ(fuse::selectLodLevel(lod, 0.1f, 0.1f), 1);
+    EXPECT_EQ(fuse::selectLodLevel(lod, 0.01f, 0.1f), 2);
+
+    // a size just under a threshold keep the current level...
+    lod.level = 0;
+    EXPECT_EQ(fuse::selectLodLevel(lod, 0.19f, 0.1f), 0);
+    EXPECT_EQ(fuse::selectLodLevel(lod, 0.17f, 0.1f), 1);
+    // ...and just above too
+    lod.level = 1;
+    EXPECT_EQ(fuse::selectLodLevel(lod, 0.21f, 0.1f), 1);
+    EXPECT_EQ(fuse::selectLodLevel(lod, 0.23f, 0.1f), 0);
+    EXPECT_EQ(fuse::selectLodLevel(lod, 0.19f, 0.0f), 1);
+
+    // a level out of range is clamped
+    lod.levelCount = 1;
+    lod.level      = 2;
+    EXPECT_EQ(fuse::selectLodLevel(lod, 0.01f, 0.1f), 1);
+}
+
+TEST(Lod, getLodMesh) {
+    CLod        lod = createSphereLod();
+    fuse::CMesh mesh;
+    mesh.mesh = MeshHandle::kSphere;
+    EXPECT_EQ(fuse::getLodMesh(mesh, lod), MeshHandle::kSphere);
+    lod.level = 1;
+    EXPECT_EQ(fuse::getLodMesh(mesh, lod), MeshHandle::kSphereMedium);
+    lod.level = 2;
+    EXPECT_EQ(fuse::getLodMesh(mesh, lod), MeshHandle::kSphereLow);
+    lod.levelCount = 1; // level out of range
+    EXPECT_EQ(fuse::getLodMesh(mesh, lod), MeshHandle::kSphereMedium);
+}
+
+TEST(Lod, selectLods) {
+    fuse::Scene scene;
+    const float distances[] = {2.0f, 6.0f, 100.0f};
+    for (const float distance : distances) {
+        auto entity = scene.createEntity();
+        entity.addComponent<fuse::CTransform>(
+          fuse::Vec3{0, 0, -distance}, fuse::Vec3{}, fuse::Vec3{1, 1, 1});
+        entity.addComponent<fuse::CMesh>(fuse::Vec4{1, 1, 1, 1}, MeshHandle::kSphere);
+        entity.addComponent<CLod>(createSphereLod());
+    }
+    scene.createEntity().addComponent<fuse::CMesh>(); // without lod, ignored
+
+    const auto stats = fuse::selectLods(scene, perspective(), Mat4::kIdentity);
+    EXPECT_EQ(stats.entityCount, 3);
+    EXPECT_EQ(stats.levelChanges, 2);
+
+    const auto& registry = scene.getMeshRegistry();
+    const auto  full     = registry.getInfo(MeshHandle::kSphere).indexCount / 3;
+    const auto  medium   = registry.getInfo(MeshHandle::kSphereMedium).indexCount / 3;
+    const auto  low      = registry.getInfo(MeshHandle::kSphereLow).indexCount / 3;
+    EXPECT_EQ(stats.triangleCount, full + medium + low);
+    EXPECT_EQ(stats.savedTriangleCount, full * 3 - stats.triangleCount);
+
+    // the extraction draw the selected meshes
+    fuse::RenderList renderList;
+    fuse::extractRenderList(scene, 1.0f, renderList);
+    ASSERT_EQ(renderList.size(), 3);
+    EXPECT_EQ(renderList.meshIds[0], MeshHandle::kSphere.id);
+    EXPECT_EQ(renderList.meshIds[1], MeshHandle::kSphereMedium.id);
+    EXPECT_EQ(renderList.meshIds[2], MeshHandle::kSphereLow.id);
+
+    // stable when nothing move
+    EXPECT_EQ(fuse::selectLods(scene, perspective(), Mat4::kIdentity).levelChanges, 0);
+}
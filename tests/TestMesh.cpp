@@ -0,0 +1,136 @@
+#include <FuseCore/renderer/MeshRegistry.h>
+#include <FuseCore/renderer/RenderQueue.h>
+
+#include <gtest/gtest.h>
+
+using fuse::MeshData;
+using fuse::MeshHandle;
+using fuse::MeshRegistry;
+
+namespace {
+
+/// @brief Check the indices and that each triangle is counter-clockwise seen from it normals.
+void checkMesh(const MeshData& mesh) {
+    ASSERT_EQ(mesh.indices.size() % 3, 0);
+    for (std::size_t i = 0; i < mesh.indices.size(); i += 3) {
+        ASSERT_LT(mesh.indices[i], mesh.vertices.size());
+        ASSERT_LT(mesh.indices[i + 1], mesh.vertices.size());
+        ASSERT_LT(mesh.indices[i + 2], mesh.vertices.size());
+        const auto& a = mesh.vertices[mesh.indices[i]];
+        const auto& b = mesh.vertices[mesh.indices[i + 1]];
+        const auto& c = mesh.vertices[mesh.indices[i + 2]];
+
+        const auto faceNormal = (b.position - a.position).crossRH(c.position - a.position);
+        EXPECT_GT(faceNormal.dot(a.normal + b.normal + c.normal), 0.0f) << "triangle " << i / 3;
+    }
+    for (const auto& vertex : mesh.vertices) {
+        EXPECT_NEAR(vertex.normal.length(), 1.0f, 1e-5f);
+        EXPECT_LE(std::abs(vertex.position.x), 0.5f + 1e-5f);
+        EXPECT_LE(std::abs(vertex.position.y), 0.5f + 1e-5f);
+        EXPECT_LE(std::abs(vertex.position.z), 0.5f + 1e-5f);
+    }
+}
+
+} // namespace
+
+TEST(Mesh, cube) {
+    const auto cube = fuse::createCubeMesh();
+    EXPECT_EQ(cube.vertices.size(), 24);
+    EXPECT_EQ(cube.indices.size(), 36);
+    checkMesh(cube);
+}
+
+TEST(Mesh, sphere) {
+    const auto sphere = fuse::createSphereMesh(8, 4);
+    EXPECT_EQ(sphere.vertices.size(), 9 * 5);
+    EXPECT_EQ(sphere.indices.size(), 8 * 3 * 6);
+    checkMesh(sphere);
+    for (const auto& vertex : sphere.vertices) {
+        EXPECT_NEAR(vertex.position.length(), 0.5f, 1e-5f);
+    }
+}
+
+TEST(Mesh, plane) {
+    const auto plane = fuse::createPlaneMesh(4);
+    EXPECT_EQ(plane.vertices.size(), 25);
+    EXPECT_EQ(plane.indices.size(), 4 * 4 * 6);
+    checkMesh(plane);
+}
+
+TEST(Mesh, cylinder) {
+    const auto cylinder = fuse::createCylinderMesh(6);
+    EXPECT_EQ(cylinder.vertices.size(), 7 * 2 + 8 * 2);
+    EXPECT_EQ(cylinder.indices.size(), 6 * 12);
+    checkMesh(cylinder);
+}
+
+TEST(MeshRegistry, builtin) {
+    const MeshRegistry registry;
+    EXPECT_EQ(registry.getMeshCount(), 6);
+    EXPECT_EQ(registry.getName(MeshHandle::kCube), "Cube");
+    EXPECT_EQ(registry.getName(MeshHandle::kSphere), "Sphere");
+    EXPECT_EQ(registry.getName(MeshHandle::kPlane), "Plane");
+    EXPECT_EQ(registry.getName(MeshHandle::kCylinder), "Cylinder");
+    EXPECT_EQ(registry.getName(MeshHandle::kSphereMedium), "Sphere (medium)");
+    EXPECT_EQ(registry.getName(MeshHandle::kSphereLow), "Sphere (low)");
+    EXPECT_FALSE(registry.isValid(MeshHandle{6}));
+
+    // the coarser spheres have less triangles
+    EXPECT_LT(registry.getInfo(MeshHandle::kSphereMedium).indexCount,
+              registry.getInfo(MeshHandle::kSphere).indexCount);
+    EXPECT_LT(registry.getInfo(MeshHandle::kSphereLow).indexCount,
+              registry.getInfo(MeshHandle::kSphereMedium).indexCount);
+
+    const auto& cube = registry.getInfo(MeshHandle::kCube);
+    EXPECT_EQ(cube.boundsMin, fuse::Vec3(-0.5f));
+    EXPECT_EQ(cube.boundsMax, fuse::Vec3(0.5f));
+    const auto& plane = registry.getInfo(MeshHandle::kPlane);
+    EXPECT_EQ(plane.boundsMin, fuse::Vec3(-0.5f, 0.0f, -0.5f));
+    EXPECT_EQ(plane.boundsMax, fuse::Vec3(0.5f, 0.0f, 0.5f));
+
+    // the meshes are packed one after the other
+    std::uint32_t vertexCount = 0;
+    std::uint32_t indexCount  = 0;
+    for (const auto& info : registry.getInfos()) {
+        EXPECT_EQ(info.indexType, fuse::IndexType::UInt16);
+        EXPECT_EQ(info.baseVertex, vertexCount);
+        EXPECT_EQ(info.firstIndex, indexCount);
+        vertexCount += info.vertexCount;
+        indexCount += info.indexCount;
+    }
+    EXPECT_EQ(registry.getVertices().size(), vertexCount);
+    EXPECT_EQ(registry.getIndices16().size(), indexCount);
+    EXPECT_TRUE(registry.getIndices32().empty());
+}
+
+TEST(MeshRegistry, add) {
+    MeshRegistry registry;
+    const auto   vertexCount = registry.getVertices().size();
+
+    // too many vertices for 16 bits indices
+    const auto  large = registry.add(fuse::createPlaneMesh(300), "Large");
+    const auto  small = registry.add(fuse::createCubeMesh(), "Small");
+    const auto& info  = registry.getInfo(large);
+    EXPECT_EQ(info.indexType, fuse::IndexType::UInt32);
+    EXPECT_EQ(info.baseVertex, vertexCount);
+    EXPECT_EQ(info.firstIndex, 0);
+    EXPECT_EQ(registry.getIndices32().size(), info.indexCount);
+    EXPECT_EQ(registry.getName(large), "Large");
+
+    const auto& smallInfo = registry.getInfo(small);
+    EXPECT_EQ(smallInfo.indexType, fuse::IndexType::UInt16);
+    EXPECT_EQ(smallInfo.baseVertex, vertexCount + info.vertexCount);
+    EXPECT_EQ(registry.getIndices16()[smallInfo.firstIndex], fuse::createCubeMesh().indices[0]);
+}
+
+TEST(MeshRegistry, full) {
+    MeshRegistry registry;
+    EXPECT_FALSE(registry.isValid(MeshHandle::kInvalid));
+
+    // the handles must fit in the mesh field of the sort keys
+    while (registry.getMeshCount() <= fuse::SortKey::kMaxMesh) {
+        ASSERT_TRUE(registry.isValid(registry.add({}, "Empty")));
+    }
+    EXPECT_EQ(registry.add(fuse::createCubeMesh(), "Cube"), MeshHandle::kInvalid);
+    EXPECT_EQ(registry.getMeshCount(), fuse::SortKey::kMaxMesh + 1);
+}
@@ -0,0 +1,76 @@
+#include <FuseCore/utils/MpscRing.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using fuse::MpscRing;
+
+namespace {
+
+struct Message {
+    std::uint32_t producer{};
+    std::uint32_t value{};
+};
+
+} // namespace
+
+TEST(MpscRing, pushDrain) {
+    MpscRing<int> ring(4);
+    EXPECT_EQ(ring.getCapacity(), 4);
+    EXPECT_EQ(ring.drain([](int) {}), 0);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(ring.tryPush([i](int& value) { value = i; }));
+    }
+    EXPECT_FALSE(ring.tryPush([](int&) { FAIL() << "The ring is full."; }));
+
+    std::vector<int> values;
+    EXPECT_EQ(ring.drain([&](int value) { values.push_back(value); }, 3), 3);
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2}));
+
+    // wrap around
+    EXPECT_TRUE(ring.tryPush([](int& value) { value = 4; }));
+    EXPECT_TRUE(ring.tryPush([](int& value) { value = 5; }));
+    values.clear();
+    EXPECT_EQ(ring.drain([&](int value) { values.push_back(value); }), 3);
+    EXPECT_EQ(values, (std::vector<int>{3, 4, 5}));
+}
+
+TEST(MpscRing, manyProducers) {
+    constexpr std::uint32_t kProducerCount = 4;
+    constexpr std::uint32_t kValueCount    = 100000;
+
+    MpscRing<Message>        ring(256);
+    std::vector<std::thread> producers;
+    for (std::uint32_t producer = 0; producer < kProducerCount; producer++) {
+        producers.emplace_back([&ring, producer]() {
+            for (std::uint32_t value = 0; value < kValueCount;) {
+                if (ring.tryPush([&](Message& message) { message = {producer, value}; })) {
+                    value++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // the values of each producer are received once, in order
+    std::vector<std::uint32_t> next(kProducerCount);
+    std::size_t                received = 0;
+    bool                       ordered  = true;
+    while (received < kProducerCount * kValueCount) {
+        received += ring.drain([&](const Message& message) {
+            ordered = ordered && message.value == next[message.producer];
+            next[message.producer]++;
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(next, std::vector<std::uint32_t>(kProducerCount, kValueCount));
+    EXPECT_EQ(ring.drain([](const Message&) {}), 0);
+}
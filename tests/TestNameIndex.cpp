@@ -0,0 +1,98 @@
+#include <FuseCore/scene/NameIndex.h>
+#include <FuseCore/scene/Scene.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+using fuse::NameIndex;
+using fuse::StringInterner;
+
+namespace {
+
+/// @brief Sorted result of a search.
+std::vector<entt::entity> search(NameIndex&             index,
+                                 const StringInterner& interner,
+                                 const char*           text) {
+    std::vector<entt::entity> entities;
+    index.search(interner, text, entities);
+    std::ranges::sort(entities);
+    return entities;
+}
+
+} // namespace
+
+TEST(NameIndex, search) {
+    StringInterner interner;
+    NameIndex      index;
+    const auto     cube   = interner.intern("Cube");
+    const auto     sphere = interner.intern("Red Sphere");
+    index.insert(entt::entity{1}, cube);
+    index.insert(entt::entity{2}, sphere);
+    index.insert(entt::entity{3}, cube);
+    index.insert(entt::entity{42}, {}); // default name
+    EXPECT_EQ(index.size(), 4);
+
+    using Result = std::vector<entt::entity>;
+    EXPECT_EQ(search(index, interner, "CUBE"), (Result{entt::entity{1}, entt::entity{3}}));
+    EXPECT_EQ(search(index, interner, "d sph"), (Result{entt::entity{2}}));
+    EXPECT_EQ(search(index, interner, "e"), (Result{entt::entity{1}, entt::entity{2},
+                                                    entt::entity{3}, entt::entity{42}}));
+    EXPECT_EQ(search(index, interner, ""), search(index, interner, "e"));
+    EXPECT_TRUE(search(index, interner, "cone").empty());
+
+    // the default names
+    EXPECT_EQ(search(index, interner, "entity"), (Result{entt::entity{42}}));
+    EXPECT_EQ(search(index, interner, "(42)"), (Result{entt::entity{42}}));
+    EXPECT_TRUE(search(index, interner, "(4)").empty());
+
+    // a name interned after the previous search
+    index.erase(entt::entity{1});
+    index.erase(entt::entity{1}); // not in the index
+    index.insert(entt::entity{1}, interner.intern("Blue cube"));
+    EXPECT_EQ(search(index, interner, "cube"), (Result{entt::entity{1}, entt::entity{3}}));
+    EXPECT_EQ(search(index, interner, "blue"), (Result{entt::entity{1}}));
+    EXPECT_EQ(index.size(), 4);
+}
+
+TEST(NameIndex, clearedInterner) {
+    StringInterner interner;
+    NameIndex      index;
+    index.insert(entt::entity{1}, interner.intern("Cube"));
+    index.insert(entt::entity{2}, interner.intern("Sphere"));
+    EXPECT_EQ(search(index, interner, "cube").size(), 1);
+
+    // the interner is cleared then as many names are interned, the ids are reused
+    index.erase(entt::entity{1});
+    index.erase(entt::entity{2});
+    interner.clear();
+    index.insert(entt::entity{1}, interner.intern("Cone"));
+    index.insert(entt::entity{2}, interner.intern("Plane"));
+    EXPECT_TRUE(search(index, interner, "cube").empty());
+    EXPECT_EQ(search(index, interner, "plan"), (std::vector<entt::entity>{entt::entity{2}}));
+}
+
+TEST(NameIndex, scene) {
+    fuse::Scene scene;
+    auto        cube   = scene.createEntity("Cube");
+    auto        sphere = scene.createEntity("Sphere");
+    auto        other  = scene.createEntity();
+
+    std::vector<entt::entity> entities;
+    scene.findEntitiesByName("cub", entities);
+    ASSERT_EQ(entities.size(), 1);
+    EXPECT_EQ(entt::to_integral(entities[0]), cube.getId());
+
+    // the index follow the renamed and destroyed entities
+    scene.setEntityName(other, "Small cube");
+    scene.destroyEntity(cube);
+    scene.findEntitiesByName("cub", entities);
+    ASSERT_EQ(entities.size(), 1);
+    EXPECT_EQ(entt::to_integral(entities[0]), other.getId());
+
+    scene.findEntitiesByName("", entities);
+    EXPECT_EQ(entities.size(), 2);
+    scene.findEntitiesByName(scene.getEntityName(sphere), entities);
+    EXPECT_EQ(entities.size(), 1);
+}
@@ -0,0 +1,167 @@
+#include <FuseCore/renderer/OcclusionCuller.h>
+#include <FuseCore/scene/RenderList.h>
+#include <FuseCore/utils/WorkerPool.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using fuse::Mat4;
+using fuse::MeshHandle;
+using fuse::MeshRegistry;
+using fuse::OcclusionCuller;
+using fuse::Vec3;
+
+namespace {
+
+/// @brief Camera at the origin looking down -z.
+Mat4 viewProj() {
+    return Mat4::CreateProjectionPerspectiveFOVY(fuse::degrees(90.0f), 2.0f, 0.1f, 100.0f);
+}
+
+/// @brief A wall of 20x20 in front of the camera, from z = -9.5 to z = -10.5.
+Mat4 wall() {
+    return Mat4::CreateTranslation({0.0f, 0.0f, -10.0f}) *
+           Mat4::CreateScaling({20.0f, 20.0f, 1.0f});
+}
+
+/// @brief Check if a unit cube at a position is visible.
+bool isCubeVisible(const OcclusionCuller& culler, const Vec3& position) {
+    return culler.isVisible(Vec3(-0.5f), Vec3(0.5f), Mat4::CreateTranslation(position));
+}
+
+} // namespace
+
+TEST(OcclusionCuller, empty) {
+    OcclusionCuller culler;
+    culler.begin(viewProj());
+    culler.rasterize();
+    EXPECT_EQ(culler.getStats().triangleCount, 0);
+    EXPECT_EQ(culler.getDepth(0, 0, 0), 1.0f);
+    EXPECT_TRUE(isCubeVisible(culler, {0.0f, 0.0f, -10.0f}));
+    EXPECT_TRUE(isCubeVisible(culler, {0.0f, 0.0f, -90.0f}));
+}
+
+TEST(OcclusionCuller, occluder) {
+    const MeshRegistry registry;
+    OcclusionCuller    culler;
+    culler.begin(viewProj());
+    culler.addOccluder(registry, MeshHandle::kCube, wall());
+    culler.rasterize();
+    EXPECT_EQ(culler.getStats().occluderCount, 1);
+    EXPECT_GT(culler.getStats().triangleCount, 0);
+
+    // the wall cover the center of the screen, not the border
+    const float center = culler.getDepth(0, culler.getWidth() / 2, culler.getHeight() / 2);
+    EXPECT_GT(center, 0.0f);
+    EXPECT_LT(center, 1.0f);
+    EXPECT_EQ(culler.getDepth(0, 0, culler.getHeight() / 2), 1.0f);
+
+    EXPECT_FALSE(isCubeVisible(culler, {0.0f, 0.0f, -30.0f})); // behind the wall
+    EXPECT_FALSE(isCubeVisible(culler, {3.0f, -2.0f, -50.0f}));
+    EXPECT_TRUE(isCubeVisible(culler, {0.0f, 0.0f, -5.0f}));   // in front of the wall
+    EXPECT_TRUE(isCubeVisible(culler, {40.0f, 0.0f, -30.0f})); // beside the wall
+    EXPECT_TRUE(isCubeVisible(culler, {0.0f, 0.0f, -9.5f}));   // inside the wall
+}
+
+TEST(OcclusionCuller, outsideOfView) {
+    OcclusionCuller culler;
+    culler.begin(viewProj());
+    culler.rasterize();
+    EXPECT_FALSE(isCubeVisible(culler, {100.0f, 0.0f, -10.0f}));
+    EXPECT_FALSE(isCubeVisible(culler, {0.0f, 0.0f, 10.0f}));  // behind the camera
+    EXPECT_FALSE(isCubeVisible(culler, {0.0f, 0.0f, -200.0f})); // after the far plane
+    EXPECT_TRUE(isCubeVisible(culler, {0.0f, 0.0f, 0.0f}));     // cross the near plane
+}
+
+TEST(OcclusionCuller, nearPlaneClipping) {
+    // a occluder crossing the near plane is clipped, not discarded
+    const MeshRegistry registry;
+    OcclusionCuller    culler;
+    culler.begin(viewProj());
+    culler.addOccluder(registry,
+                       MeshHandle::kPlane,
+                       Mat4::CreateTranslation({0.0f, -1.0f, 0.0f}) *
+                         Mat4::CreateScaling({100.0f, 1.0f, 100.0f}));
+    culler.rasterize();
+    EXPECT_LT(culler.getDepth(0, culler.getWidth() / 2, 0), 1.0f);
+    EXPECT_FALSE(isCubeVisible(culler, {0.0f, -5.0f, -10.0f})); // under the floor
+    EXPECT_TRUE(isCubeVisible(culler, {0.0f, 1.0f, -10.0f}));
+}
+
+TEST(OcclusionCuller, hierarchy) {
+    const MeshRegistry registry;
+    OcclusionCuller    culler(64, 32);
+    culler.begin(viewProj());
+    culler.addOccluder(registry, MeshHandle::kSphere, Mat4::CreateTranslation({0, 0, -2}));
+    culler.rasterize();
+    ASSERT_EQ(culler.getLevelCount(), 7);
+
+    // each texel is the farthest of the 2x2 texels below
+    for (unsigned level = 1; level < culler.getLevelCount(); level++) {
+        const unsigned width  = std::max(culler.getWidth() >> level, 1U);
+        const unsigned height = std::max(culler.getHeight() >> level, 1U);
+        const unsigned below  = std::max(culler.getHeight() >> (level - 1), 1U);
+        for (unsigned y = 0; y < height; y++) {
+            for (unsigned x = 0; x < width; x++) {
+                const unsigned y1 = std::min(y * 2 + 1, below - 1);
+                EXPECT_EQ(culler.getDepth(level, x, y),
+                          std::max({culler.getDepth(level - 1, x * 2, y * 2),
+                                    culler.getDepth(level - 1, x * 2 + 1, y * 2),
+                                    culler.getDepth(level - 1, x * 2, y1),
+                                    culler.getDepth(level - 1, x * 2 + 1, y1)}));
+            }
+        }
+    }
+}
+
+TEST(OcclusionCuller, threads) {
+    const MeshRegistry registry;
+    OcclusionCuller    single;
+    OcclusionCuller    multi;
+    single.begin(viewProj());
+    multi.begin(viewProj());
+    for (int i = 0; i < 20; i++) {
+        const auto world = Mat4::CreateTranslation(
+                             {static_cast<float>(i % 5) * 4.0f - 8.0f,
+                              static_cast<float>(i / 5) * 3.0f - 4.0f,
+                              -10.0f - static_cast<float>(i)}) *
+                           Mat4::CreateRotationY(fuse::degrees(static_cast<float>(i) * 10.0f));
+        single.addOccluder(registry, MeshHandle::kSphere, world);
+        multi.addOccluder(registry, MeshHandle::kSphere, world);
+    }
+    fuse::WorkerPool workers(4);
+    single.rasterize();
+    multi.rasterize(&workers);
+
+    for (unsigned y = 0; y < single.getHeight(); y++) {
+        for (unsigned x = 0; x < single.getWidth(); x++) {
+            ASSERT_EQ(single.getDepth(0, x, y), multi.getDepth(0, x, y)) << x << ", " << y;
+        }
+    }
+}
+
+TEST(OcclusionCuller, cull) {
+    const MeshRegistry registry;
+    OcclusionCuller    culler;
+    culler.begin(viewProj());
+    culler.addOccluder(registry, MeshHandle::kCube, wall());
+    culler.rasterize();
+
+    fuse::RenderList list;
+    list.resize(4);
+    const float distances[] = {5.0f, 30.0f, 8.0f, 40.0f};
+    for (std::size_t i = 0; i < list.size(); i++) {
+        list.worldMatrices[i] = Mat4::CreateTranslation({0.0f, 0.0f, -distances[i]});
+        list.meshIds[i]       = MeshHandle::kCube.id;
+        list.sortKeys[i]      = i;
+    }
+
+    fuse::WorkerPool workers(2);
+    EXPECT_EQ(culler.cull(list, registry.getInfos(), &workers), 2);
+    ASSERT_EQ(list.size(), 2);
+    EXPECT_EQ(list.sortKeys[0], 0);
+    EXPECT_EQ(list.sortKeys[1], 2);
+    EXPECT_EQ(culler.getStats().testedCount, 4);
+    EXPECT_EQ(culler.getStats().culledCount, 2);
+}
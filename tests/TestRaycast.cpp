@@ -0,0 +1,147 @@
+#include <FuseCore/scene/Raycast.h>
+#include <FuseCore/scene/Scene.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using fuse::Mat4;
+using fuse::Ray;
+using fuse::RaycastGrid;
+using fuse::Vec3;
+
+namespace {
+
+/// @brief Nearest box hit by a ray, tested one by one.
+float raycastBruteForce(std::span<const Vec3> boundsMin,
+                        std::span<const Vec3> boundsMax,
+                        const Ray&            ray) {
+    float nearest = std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < boundsMin.size(); i++) {
+        float      enter = 0.0f;
+        float      exit  = std::numeric_limits<float>::infinity();
+        const auto slab  = [&](float min, float max, float origin, float direction) {
+            const float t0 = (min - origin) / direction;
+            const float t1 = (max - origin) / direction;
+            enter          = std::max(enter, std::min(t0, t1));
+            exit           = std::min(exit, std::max(t0, t1));
+        };
+        slab(boundsMin[i].x, boundsMax[i].x, ray.origin.x, ray.direction.x);
+        slab(boundsMin[i].y, boundsMax[i].y, ray.origin.y, ray.direction.y);
+        slab(boundsMin[i].z, boundsMax[i].z, ray.origin.z, ray.direction.z);
+        if (enter <= exit) {
+            nearest = std::min(nearest, enter);
+        }
+    }
+    return nearest;
+}
+
+} // namespace
+
+TEST(Raycast, computeRay) {
+    const auto proj =
+      Mat4::CreateProjectionPerspectiveFOVY(fuse::degrees(90.0f), 1.0f, 1.0f, 100.0f);
+    const auto view        = Mat4::CreateTranslation({0, 0, -5}); // camera at z = 5 looking at -z
+    const auto invViewProj = (proj * view).inversed();
+
+    const Ray center = fuse::computeRay(invViewProj, 0.0f, 0.0f);
+    EXPECT_NEAR(center.origin.z, 4.0f, 1e-4f); // on the near plane
+    EXPECT_NEAR(center.direction.z, -1.0f, 1e-5f);
+
+    // a fov of 90 degrees, the top right corner is at 45 degrees on both axis
+    const Ray corner = fuse::computeRay(invViewProj, 1.0f, 1.0f);
+    EXPECT_NEAR(corner.direction.x, corner.direction.y, 1e-5f);
+    EXPECT_NEAR(corner.direction.x, -corner.direction.z, 1e-5f);
+    EXPECT_NEAR(corner.direction.length(), 1.0f, 1e-5f);
+}
+
+TEST(Raycast, grid) {
+    const entt::entity entities[]  = {entt::entity{1}, entt::entity{2}, entt::entity{3}};
+    const Vec3         boundsMin[] = {{-1, -1, -1}, {-1, -1, -11}, {-100, -20, -100}};
+    const Vec3         boundsMax[] = {{1, 1, 1}, {1, 1, -9}, {100, -19, 100}};
+
+    RaycastGrid grid;
+    EXPECT_FALSE(grid.raycast({Vec3{0, 0, 5}, Vec3{0, 0, -1}}).isHit()); // empty
+    grid.build(boundsMin, boundsMax, entities);
+    EXPECT_EQ(grid.getEntityCount(), 3);
+
+    // the nearest box
+    auto hit = grid.raycast({Vec3{0, 0, 5}, Vec3{0, 0, -1}});
+    EXPECT_EQ(hit.entity, entities[0]);
+    EXPECT_FLOAT_EQ(hit.distance, 4.0f);
+    hit = grid.raycast({Vec3{0, 0, -5}, Vec3{0, 0, -1}});
+    EXPECT_EQ(hit.entity, entities[1]);
+    EXPECT_FLOAT_EQ(hit.distance, 4.0f);
+
+    // the large floor, the origin inside a box and the maximum distance
+    EXPECT_EQ(grid.raycast({Vec3{50, 0, 50}, Vec3{0, -1, 0}}).entity, entities[2]);
+    hit = grid.raycast({Vec3{0, 0, 0}, Vec3{1, 0, 0}});
+    EXPECT_EQ(hit.entity, entities[0]);
+    EXPECT_EQ(hit.distance, 0.0f);
+    EXPECT_FALSE(grid.raycast({Vec3{0, 0, 5}, Vec3{0, 0, -1}}, 3.0f).isHit());
+    EXPECT_FALSE(grid.raycast({Vec3{0, 0, 5}, Vec3{0, 0, 1}}).isHit()); // behind
+}
+
+TEST(Raycast, gridMatchBruteForce) {
+    std::mt19937                          random(42);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.1f, 4.0f);
+
+    std::vector<Vec3>         boundsMin;
+    std::vector<Vec3>         boundsMax;
+    std::vector<entt::entity> entities;
+    for (std::uint32_t i = 0; i < 10000; i++) {
+        const Vec3 min{position(random), position(random) * 0.1f, position(random)};
+        boundsMin.push_back(min);
+        boundsMax.push_back(min + Vec3{size(random), size(random), size(random)});
+        entities.push_back(entt::entity{i});
+    }
+    RaycastGrid grid;
+    grid.build(boundsMin, boundsMax, entities);
+    EXPECT_GT(grid.getCellCount(), 100);
+
+    for (int i = 0; i < 500; i++) {
+        const Vec3 origin{position(random), position(random), position(random)};
+        const Vec3 target{position(random), position(random) * 0.1f, position(random)};
+        const Ray  ray{origin, (target - origin).normalized()};
+
+        const float expected = raycastBruteForce(boundsMin, boundsMax, ray);
+        const auto  hit      = grid.raycast(ray);
+        EXPECT_EQ(hit.isHit(), expected != std::numeric_limits<float>::infinity()) << i;
+        if (hit.isHit()) {
+            EXPECT_NEAR(hit.distance, expected, 1e-3f) << i;
+        }
+    }
+}
+
+TEST(Raycast, scene) {
+    fuse::Scene scene;
+    auto        front = scene.createEntity();
+    front.addComponent<fuse::CTransform>(Vec3{0, 0, 0}, Vec3{0, 0, 0}, Vec3{1, 1, 1});
+    front.addComponent<fuse::CMesh>();
+    auto back = scene.createEntity();
+    back.addComponent<fuse::CTransform>(Vec3{0, 0, -10}, Vec3{0, 0, 0}, Vec3{2, 2, 2});
+    back.addComponent<fuse::CMesh>();
+    scene.createEntity().addComponent<fuse::CTransform>(); // no mesh, not hit
+
+    auto hit = scene.raycast({0, 0, 10}, {0, 0, -1});
+    EXPECT_EQ(entt::to_integral(hit.entity), front.getId());
+    EXPECT_NEAR(hit.distance, 9.5f, 1e-5f);
+
+    // moving a entity rebuild the grid
+    front.patchComponent<fuse::CTransform>(
+      [](fuse::CTransform& transform) { transform.translation = {5, 0, 0}; });
+    hit = scene.raycast({0, 0, 10}, {0, 0, -1});
+    EXPECT_EQ(entt::to_integral(hit.entity), back.getId());
+    EXPECT_NEAR(hit.distance, 19.0f, 1e-5f); // scaled by 2
+
+    // a modification in place must be reported
+    front.getComponent<fuse::CTransform>().translation = {0, 0, 0};
+    scene.markTransformsChanged();
+    EXPECT_EQ(entt::to_integral(scene.raycast({0, 0, 10}, {0, 0, -1}).entity), front.getId());
+
+    scene.destroyEntity(front);
+    EXPECT_EQ(entt::to_integral(scene.raycast({0, 0, 10}, {0, 0, -1}).entity), back.getId());
+    EXPECT_FALSE(scene.raycast({0, 10, 10}, {0, 0, -1}).isHit());
+}
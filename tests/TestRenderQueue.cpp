@@ -0,0 +1,122 @@
+#include <FuseCore/renderer/RenderQueue.h>
+#include <FuseCore/scene/RenderList.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+using fuse::RenderPass;
+using fuse::RenderQueue;
+using fuse::SortKey;
+
+TEST(SortKey, encodeDecode) {
+    const auto opaque = SortKey::WithDepth(SortKey::Make(RenderPass::Opaque, 3, 42, 7), 1000);
+    const auto fields = SortKey::Decode(opaque);
+    EXPECT_EQ(fields.pass, RenderPass::Opaque);
+    EXPECT_EQ(fields.shader, 3);
+    EXPECT_EQ(fields.material, 42);
+    EXPECT_EQ(fields.mesh, 7);
+    EXPECT_EQ(fields.depth, 1000);
+
+    const auto transparent =
+      SortKey::WithDepth(SortKey::Make(RenderPass::Transparent, SortKey::kMaxShader, 1, 2), 5);
+    const auto transparentFields = SortKey::Decode(transparent);
+    EXPECT_EQ(transparentFields.pass, RenderPass::Transparent);
+    EXPECT_EQ(transparentFields.shader, SortKey::kMaxShader);
+    EXPECT_EQ(transparentFields.material, 1);
+    EXPECT_EQ(transparentFields.mesh, 2);
+    EXPECT_EQ(transparentFields.depth, 5);
+}
+
+TEST(SortKey, order) {
+    const auto opaque = SortKey::Make(RenderPass::Opaque, 1, 0, 0);
+    // opaque: state first, then front to back
+    EXPECT_LT(SortKey::WithDepth(opaque, 10), SortKey::WithDepth(opaque, 20));
+    EXPECT_LT(SortKey::WithDepth(opaque, SortKey::kMaxDepth),
+              SortKey::WithDepth(SortKey::Make(RenderPass::Opaque, 2, 0, 0), 0));
+
+    // transparent: after the opaque, back to front whatever the state
+    const auto transparentA = SortKey::Make(RenderPass::Transparent, 0, 0, 0);
+    const auto transparentB = SortKey::Make(RenderPass::Transparent, 5, 0, 0);
+    EXPECT_LT(SortKey::WithDepth(opaque, SortKey::kMaxDepth), SortKey::WithDepth(transparentA, 0));
+    EXPECT_LT(SortKey::WithDepth(transparentB, 20), SortKey::WithDepth(transparentA, 10));
+}
+
+TEST(SortKey, quantizeDepth) {
+    EXPECT_EQ(SortKey::QuantizeDepth(-1.0f, 100.0f), 0);
+    EXPECT_EQ(SortKey::QuantizeDepth(0.0f, 100.0f), 0);
+    EXPECT_EQ(SortKey::QuantizeDepth(100.0f, 100.0f), SortKey::kMaxDepth);
+    EXPECT_EQ(SortKey::QuantizeDepth(1000.0f, 100.0f), SortKey::kMaxDepth);
+    EXPECT_LT(SortKey::QuantizeDepth(10.0f, 100.0f), SortKey::QuantizeDepth(11.0f, 100.0f));
+}
+
+TEST(RenderQueue, sort) {
+    std::mt19937_64            rng(1234);
+    std::vector<std::uint64_t> keys(5000);
+    RenderQueue                queue;
+    for (std::uint32_t i = 0; i < keys.size(); i++) {
+        // few distinct high bytes, to exercise the skipped passes and the stability
+        keys[i] = rng() & 0xFF0000000000FFFFULL;
+        queue.push(keys[i], i);
+    }
+    queue.sort();
+
+    std::vector<std::uint64_t> expected = keys;
+    std::ranges::sort(expected);
+
+    const auto items = queue.getItems();
+    ASSERT_EQ(items.size(), keys.size());
+    for (std::size_t i = 0; i < items.size(); i++) {
+        EXPECT_EQ(items[i].key, expected[i]);
+        EXPECT_EQ(keys[items[i].index], items[i].key);
+        if (i > 0 && items[i].key == items[i - 1].key) {
+            EXPECT_LT(items[i - 1].index, items[i].index); // stable
+        }
+    }
+}
+
+TEST(RenderQueue, build) {
+    fuse::RenderList list;
+    list.resize(4);
+    const float distances[] = {5.0f, 1.0f, 3.0f, 2.0f};
+    const bool  opaques[]   = {true, true, false, false};
+    for (std::size_t i = 0; i < list.size(); i++) {
+        // the camera is at the origin and look down -z
+        list.worldMatrices[i] = fuse::Mat4::CreateTranslation({0, 0, -distances[i]});
+        list.sortKeys[i] =
+          SortKey::Make(opaques[i] ? RenderPass::Opaque : RenderPass::Transparent, 0, 0, 0);
+    }
+
+    RenderQueue queue;
+    queue.build(list, fuse::Mat4::kIdentity, 100.0f);
+    ASSERT_EQ(queue.size(), 4);
+
+    // opaque front to back, then transparent back to front
+    const auto items = queue.getItems();
+    EXPECT_EQ(items[0].index, 1);
+    EXPECT_EQ(items[1].index, 0);
+    EXPECT_EQ(items[2].index, 2);
+    EXPECT_EQ(items[3].index, 3);
+}
+
+TEST(RenderQueue, stats) {
+    RenderQueue queue;
+    EXPECT_EQ(queue.computeStats().drawCount, 0);
+
+    queue.push(SortKey::Make(RenderPass::Opaque, 0, 0, 1), 0);
+    queue.push(SortKey::Make(RenderPass::Opaque, 0, 0, 0), 1);
+    queue.push(SortKey::Make(RenderPass::Opaque, 0, 1, 1), 2);
+    queue.push(SortKey::Make(RenderPass::Opaque, 0, 0, 1), 3);
+    queue.push(SortKey::Make(RenderPass::Transparent, 0, 0, 1), 4);
+    queue.sort();
+
+    const auto stats = queue.computeStats();
+    EXPECT_EQ(stats.drawCount, 5);
+    EXPECT_EQ(stats.transparentCount, 1);
+    EXPECT_EQ(stats.passChanges, 2);
+    EXPECT_EQ(stats.shaderChanges, 1);
+    EXPECT_EQ(stats.materialChanges, 3); // 0, 1, then 0 in the transparent pass
+    EXPECT_EQ(stats.meshChanges, 2);     // 0 then 1
+    EXPECT_EQ(stats.batchCount, 4);      // the two (0, 0, 1) opaque draws are batched
+}
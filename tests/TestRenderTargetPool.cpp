@@ -0,0 +1,121 @@
+#include <FuseCore/renderer/RenderTargetPool.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using fuse::RenderTargetDesc;
+using fuse::RenderTargetFormat;
+using fuse::RenderTargetPool;
+
+namespace {
+
+/// @brief Fake graphic API, the names are the index of the creation plus one.
+struct FakeTargets {
+    std::vector<RenderTargetPool::Handle> destroyed;
+    RenderTargetPool::Handle              createdCount{};
+
+    RenderTargetPool createPool(std::uint32_t maxUnusedFrames) {
+        return {[this](const RenderTargetDesc&) { return ++createdCount; },
+                [this](RenderTargetPool::Handle handle, const RenderTargetDesc&) {
+                    destroyed.push_back(handle);
+                },
+                maxUnusedFrames};
+    }
+};
+
+const RenderTargetDesc kColor{128, 64, RenderTargetFormat::RGBA8};
+const RenderTargetDesc kDepth{128, 64, RenderTargetFormat::Depth24Stencil8};
+
+} // namespace
+
+TEST(RenderTargetPool, roundUpToBucket) {
+    EXPECT_EQ(fuse::roundUpToBucket(0, 128), 128);
+    EXPECT_EQ(fuse::roundUpToBucket(1, 128), 128);
+    EXPECT_EQ(fuse::roundUpToBucket(128, 128), 128);
+    EXPECT_EQ(fuse::roundUpToBucket(129, 128), 256);
+    EXPECT_EQ(fuse::roundUpToBucket(1000, 128), 1024);
+}
+
+TEST(RenderTargetPool, reuse) {
+    FakeTargets fake;
+    {
+        auto       pool  = fake.createPool(2);
+        const auto color = pool.acquire(kColor);
+        const auto depth = pool.acquire(kDepth);
+        EXPECT_NE(color, depth); // same size, different format
+        EXPECT_NE(pool.acquire(kColor), color); // still used
+
+        // a released target is reused for the same size and format only
+        pool.release(color, kColor.format);
+        EXPECT_NE(pool.acquire({256, 64, RenderTargetFormat::RGBA8}), color);
+        EXPECT_EQ(pool.acquire(kColor), color);
+        pool.release(0, kColor.format); // ignored
+
+        const auto stats = pool.getStats();
+        EXPECT_EQ(stats.usedCount, 4);
+        EXPECT_EQ(stats.freeCount, 0);
+        EXPECT_EQ(stats.createdCount, 4);
+        EXPECT_EQ(stats.reusedCount, 1);
+        EXPECT_EQ(stats.allocatedPixels, 128 * 64 * 3 + 256 * 64);
+        EXPECT_TRUE(fake.destroyed.empty());
+    }
+    EXPECT_EQ(fake.destroyed.size(), 4); // all destroyed with the pool
+}
+
+TEST(RenderTargetPool, endFrame) {
+    FakeTargets fake;
+    auto        pool  = fake.createPool(2);
+    const auto  color = pool.acquire(kColor);
+    const auto  depth = pool.acquire(kDepth);
+
+    // a used target is never destroyed
+    for (int frame = 0; frame < 10; ++frame) {
+        pool.endFrame();
+    }
+    EXPECT_TRUE(fake.destroyed.empty());
+
+    // a free target is kept maxUnusedFrames frames
+    pool.release(color, kColor.format);
+    pool.endFrame();
+    pool.endFrame();
+    EXPECT_TRUE(fake.destroyed.empty());
+    pool.endFrame();
+    ASSERT_EQ(fake.destroyed.size(), 1);
+    EXPECT_EQ(fake.destroyed[0], color);
+    EXPECT_EQ(pool.getStats().destroyedCount, 1);
+    EXPECT_EQ(pool.getStats().allocatedPixels, 128 * 64);
+
+    // reusing a target restart it delay
+    pool.release(depth, kDepth.format);
+    pool.endFrame();
+    EXPECT_EQ(pool.acquire(kDepth), depth);
+    pool.endFrame();
+    pool.release(depth, kDepth.format);
+    pool.endFrame();
+    pool.endFrame();
+    EXPECT_EQ(fake.destroyed.size(), 1);
+
+    pool.trim();
+    EXPECT_EQ(fake.destroyed.size(), 2);
+    EXPECT_EQ(pool.getStats().freeCount, 0);
+}
+
+TEST(RenderTargetPool, sameNameOtherFormat) {
+    // textures and renderbuffers have their own names in OpenGL, they can be equal
+    std::vector<RenderTargetDesc> destroyed;
+    const auto create  = [](const RenderTargetDesc&) { return RenderTargetPool::Handle{1}; };
+    const auto destroy = [&](RenderTargetPool::Handle, const RenderTargetDesc& desc) {
+        destroyed.push_back(desc);
+    };
+    RenderTargetPool pool(create, destroy, 0);
+    const auto color = pool.acquire(kColor);
+    const auto depth = pool.acquire(kDepth);
+    EXPECT_EQ(color, depth);
+
+    pool.release(depth, kDepth.format);
+    pool.endFrame();
+    ASSERT_EQ(destroyed.size(), 1);
+    EXPECT_EQ(destroyed[0], kDepth);
+    EXPECT_EQ(pool.getStats().usedCount, 1);
+}
@@ -1,14 +1,37 @@
 #include <FuseCore/scene/Components.h>
+#include <FuseCore/scene/RenderList.h>
 #include <FuseCore/scene/Scene.h>
+#include <FuseCore/scene/TransformInterpolation.h>
+#include <FuseCore/scene/UUIDIndex.h>
+#include <FuseCore/utils/WorkerPool.h>
 
 #include <gtest/gtest.h>
 
+#include <utility>
+#include <vector>
+
 namespace {
 
 struct TestComponent {
     int value = 0;
 };
 
+struct TestTag {};
+
+struct UntrackedComponent {
+    int value = 0;
+};
+
+template <int N>
+struct NumberedComponent {
+    int value = N;
+};
+
+template <int... N>
+void addNumberedComponents(fuse::Entity& entity, std::integer_sequence<int, N...> /*numbers*/) {
+    (entity.addComponent<NumberedComponent<N>>(), ...);
+}
+
 } // namespace
 
 TEST(Scene, ctor) {
@@ -63,6 +86,98 @@ TEST(Scene, destroyEntity) {
     EXPECT_EQ(scene.getEntityCount(), 0);
 }
 
+TEST(Scene, entityName) {
+    fuse::Scene scene;
+
+    auto entity1 = scene.createEntity("Foo");
+    auto entity2 = scene.createEntity();
+    EXPECT_EQ(scene.getEntityName(entity1), "Foo");
+
+    // the default name is only generated when requested
+    EXPECT_FALSE(entity2.getComponent<fuse::NameComponent>().name.isValid());
+    EXPECT_FALSE(scene.getEntityName(entity2).empty());
+    EXPECT_TRUE(entity2.getComponent<fuse::NameComponent>().name.isValid());
+
+    // same name share the same interned string
+    scene.setEntityName(entity2, "Foo");
+    EXPECT_EQ(entity1.getComponent<fuse::NameComponent>(),
+              entity2.getComponent<fuse::NameComponent>());
+    EXPECT_EQ(scene.getStringInterner().size(), 2);
+
+    scene.setEntityName(entity2, "Bar");
+    EXPECT_EQ(scene.getEntityName(entity2), "Bar");
+
+    EXPECT_TRUE(scene.getEntityName({}).empty());
+}
+
+TEST(Scene, nameVersion) {
+    fuse::Scene scene;
+
+    auto version = scene.getNameVersion();
+    auto entity  = scene.createEntity();
+    EXPECT_GT(scene.getNameVersion(), version);
+
+    // the default name does not change the version
+    version = scene.getNameVersion();
+    EXPECT_FALSE(scene.getEntityName(entity).empty());
+    EXPECT_EQ(scene.getNameVersion(), version);
+
+    scene.setEntityName(entity, "Foo");
+    EXPECT_GT(scene.getNameVersion(), version);
+    version = scene.getNameVersion();
+    scene.destroyEntity(entity);
+    EXPECT_GT(scene.getNameVersion(), version);
+}
+
+TEST(Scene, findEntity) {
+    fuse::Scene scene;
+    auto        entity1 = scene.createEntity();
+    auto        entity2 = scene.createEntity();
+
+    const auto uuid1 = entity1.getComponent<fuse::IDComponent>().id;
+    const auto uuid2 = entity2.getComponent<fuse::IDComponent>().id;
+    EXPECT_EQ(scene.findEntity(uuid1), entity1);
+    EXPECT_EQ(scene.findEntity(uuid2), entity2);
+    EXPECT_FALSE(scene.findEntity(fuse::UUID()));
+
+    // replace the id (e.g. when loading a scene)
+    entity1.replaceComponent<fuse::IDComponent>(fuse::UUID(42));
+    EXPECT_FALSE(scene.findEntity(uuid1));
+    EXPECT_EQ(scene.findEntity(fuse::UUID(42)), entity1);
+
+    scene.destroyEntity(entity2);
+    EXPECT_FALSE(scene.findEntity(uuid2));
+
+    // create with a given id
+    auto entity3 = scene.createEntity("third", fuse::UUID(7));
+    EXPECT_EQ(entity3.getComponent<fuse::IDComponent>().id, fuse::UUID(7));
+    EXPECT_EQ(scene.findEntity(fuse::UUID(7)), entity3);
+    EXPECT_EQ(scene.getEntityName(entity3), "third");
+}
+
+TEST(UUIDIndex, replace) {
+    entt::registry  registry;
+    fuse::UUIDIndex index;
+    index.connect(registry);
+
+    const auto entity = registry.create();
+    registry.emplace<fuse::IDComponent>(entity, fuse::UUID(1));
+    registry.replace<fuse::IDComponent>(entity, fuse::UUID(2));
+    registry.replace<fuse::IDComponent>(entity, fuse::UUID(3));
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_EQ(index.find(fuse::UUID(1)), entt::entity{entt::null});
+    EXPECT_EQ(index.find(fuse::UUID(3)), entity);
+
+    // a UUID already used stay mapped to the first entity
+    const auto other = registry.create();
+    EXPECT_DEBUG_DEATH(registry.emplace<fuse::IDComponent>(other, fuse::UUID(3)), "already used");
+    registry.destroy(other);
+    EXPECT_EQ(index.find(fuse::UUID(3)), entity);
+
+    registry.destroy(entity);
+    EXPECT_EQ(index.size(), 0);
+}
+
 TEST(Scene, hasSameComponentType) {
     fuse::Scene scene;
     auto        entity1 = scene.createEntity();
@@ -83,6 +198,32 @@ TEST(Scene, hasSameComponentType) {
     EXPECT_TRUE(scene.hasSameComponentType(entity1, entity2));
 }
 
+TEST(Scene, entitySignature) {
+    fuse::Scene scene;
+    auto        entity = scene.createEntity();
+    EXPECT_EQ(scene.getEntitySignature(entity).count(), 2);
+
+    // component added through the entity are tracked
+    entity.addComponent<TestComponent>();
+    entity.addComponent<TestTag>();
+    EXPECT_EQ(scene.getEntityComponentCount(entity), 4);
+
+    // component added through the registry must be registered
+    scene.registerComponent<fuse::CMesh>();
+    scene.getRegistry().emplace<fuse::CMesh>(static_cast<entt::entity>(entity.getId()));
+    EXPECT_EQ(scene.getEntityComponentCount(entity), 5);
+
+    entity.removeComponents<TestComponent, fuse::CMesh>();
+    EXPECT_EQ(scene.getEntityComponentCount(entity), 3);
+
+    // destroying a entity clear it signature
+    const auto id = static_cast<entt::entity>(entity.getId());
+    scene.destroyEntity(entity);
+    auto recycled = scene.createEntity();
+    EXPECT_EQ(entt::to_entity(static_cast<entt::entity>(recycled.getId())), entt::to_entity(id));
+    EXPECT_EQ(scene.getEntityComponentCount(recycled), 2);
+}
+
 TEST(Scene, duplicateEntity) {
     fuse::Scene scene;
 
@@ -107,3 +248,194 @@ TEST(Scene, duplicateEntity) {
     // component ID should be different
     ASSERT_NE(entity1.getComponent<fuse::IDComponent>(), entity2.getComponent<fuse::IDComponent>());
 }
+
+TEST(Scene, untrackedComponent) {
+    fuse::Scene scene;
+    auto        entity1 = scene.createEntity();
+    auto        entity2 = scene.createEntity();
+
+    // a component added with the registry without being registered is still visited
+    scene.getRegistry().emplace<UntrackedComponent>(static_cast<entt::entity>(entity1.getId()), 7);
+    EXPECT_EQ(scene.getEntityComponentCount(entity1), 3);
+    EXPECT_FALSE(scene.hasSameComponentType(entity1, entity2));
+
+    auto copy = scene.duplicateEntity(entity1);
+    EXPECT_EQ(copy.getComponent<UntrackedComponent>().value, 7);
+    EXPECT_TRUE(scene.hasSameComponentType(entity1, copy));
+
+    std::vector<entt::entity> entities(3);
+    scene.instantiate(entity1, entities);
+    for (const auto e : entities) {
+        EXPECT_EQ(scene.getRegistry().get<UntrackedComponent>(e).value, 7);
+    }
+}
+
+TEST(Scene, manyComponentTypes) {
+    fuse::Scene scene;
+    auto        entity = scene.createEntity();
+
+    // more component types than the bits of a signature, the last ones are not tracked
+    constexpr int kTypeCount = static_cast<int>(fuse::kMaxComponentTypes) + 6;
+    addNumberedComponents(entity, std::make_integer_sequence<int, kTypeCount>{});
+    EXPECT_EQ(scene.getEntityComponentCount(entity), kTypeCount + 2); // with name and id
+
+    auto copy = scene.duplicateEntity(entity);
+    EXPECT_EQ(copy.getComponent<NumberedComponent<kTypeCount - 1>>().value, kTypeCount - 1);
+    EXPECT_TRUE(scene.hasSameComponentType(entity, copy));
+    copy.removeComponents<NumberedComponent<kTypeCount - 1>>();
+    EXPECT_FALSE(scene.hasSameComponentType(entity, copy));
+
+    std::vector<entt::entity> entities(2);
+    scene.instantiate(entity, entities);
+    for (const auto e : entities) {
+        EXPECT_EQ(scene.getRegistry().get<NumberedComponent<kTypeCount - 1>>(e).value,
+                  kTypeCount - 1);
+    }
+}
+
+TEST(Scene, createEntities) {
+    fuse::Scene scene;
+
+    std::vector<entt::entity> entities(100);
+    scene.createEntities(entities, TestComponent{42});
+    EXPECT_EQ(scene.getEntityCount(), 100);
+
+    for (const auto e : entities) {
+        const fuse::Entity entity(e, scene.getRegistry());
+        ASSERT_TRUE(entity.isValid());
+        ASSERT_TRUE((entity.hasComponents<fuse::NameComponent, fuse::IDComponent>()));
+        ASSERT_EQ(entity.getComponent<TestComponent>().value, 42);
+    }
+
+    // each entity get it own id
+    const fuse::Entity first(entities.front(), scene.getRegistry());
+    const fuse::Entity last(entities.back(), scene.getRegistry());
+    EXPECT_NE(first.getComponent<fuse::IDComponent>(), last.getComponent<fuse::IDComponent>());
+}
+
+TEST(Scene, destroyEntities) {
+    fuse::Scene scene;
+
+    std::vector<entt::entity> entities(100);
+    scene.createEntities(entities);
+    auto other = scene.createEntity();
+    EXPECT_EQ(scene.getEntityCount(), 101);
+
+    scene.destroyEntities(entities);
+    EXPECT_EQ(scene.getEntityCount(), 1);
+    EXPECT_TRUE(other.isValid());
+    for (const auto e : entities) {
+        ASSERT_FALSE(scene.getRegistry().valid(e));
+    }
+}
+
+TEST(Scene, instantiate) {
+    fuse::Scene scene;
+
+    auto prototype = scene.createEntity("Prototype");
+    prototype.addComponent<TestComponent>(10);
+
+    std::vector<entt::entity> entities(50);
+    scene.instantiate(prototype, entities);
+    EXPECT_EQ(scene.getEntityCount(), 51);
+
+    for (const auto e : entities) {
+        const fuse::Entity entity(e, scene.getRegistry());
+        ASSERT_TRUE(scene.hasSameComponentType(prototype, entity));
+        ASSERT_EQ(entity.getComponent<TestComponent>().value, 10);
+        ASSERT_EQ(scene.getEntityName(entity), "Prototype");
+        ASSERT_NE(entity.getComponent<fuse::IDComponent>(),
+                  prototype.getComponent<fuse::IDComponent>());
+    }
+}
+
+TEST(Scene, storePreviousTransforms) {
+    fuse::Scene scene;
+    auto        entity = scene.createEntity();
+    auto&       transform =
+      entity.addComponent<fuse::CTransform>(fuse::Vec3{1, 0, 0}, fuse::Vec3{}, fuse::Vec3{1, 1, 1});
+
+    fuse::storePreviousTransforms(scene);
+    ASSERT_TRUE(entity.hasComponents<fuse::CPreviousTransform>());
+    EXPECT_EQ(entity.getComponent<fuse::CPreviousTransform>().transform.translation,
+              fuse::Vec3(1, 0, 0));
+
+    transform.translation = {3, 0, 0};
+    fuse::storePreviousTransforms(scene);
+    EXPECT_EQ(entity.getComponent<fuse::CPreviousTransform>().transform.translation,
+              fuse::Vec3(3, 0, 0));
+}
+
+TEST(Scene, interpolateTransform) {
+    const fuse::CTransform previous{
+      .translation = {0, 0, 0}, .rotation = {0, 350, 0}, .scale = {1, 1, 1}};
+    const fuse::CTransform current{
+      .translation = {2, 4, 6}, .rotation = {90, 10, 0}, .scale = {3, 1, 1}};
+
+    const auto start = fuse::interpolateTransform(previous, current, 0.0f);
+    EXPECT_EQ(start.translation, previous.translation);
+
+    const auto middle = fuse::interpolateTransform(previous, current, 0.5f);
+    EXPECT_EQ(middle.translation, fuse::Vec3(1, 2, 3));
+    EXPECT_EQ(middle.scale, fuse::Vec3(2, 1, 1));
+    EXPECT_FLOAT_EQ(middle.rotation.x, 45.0f);
+    // shortest path from 350 to 10 degrees go through 360
+    EXPECT_FLOAT_EQ(middle.rotation.y, 360.0f);
+
+    const auto end = fuse::interpolateTransform(previous, current, 1.0f);
+    EXPECT_EQ(end.translation, current.translation);
+}
+
+TEST(Scene, extractRenderList) {
+    fuse::Scene scene;
+    auto        mesh = scene.createEntity();
+    mesh.addComponent<fuse::CTransform>(fuse::Vec3{1, 2, 3}, fuse::Vec3{}, fuse::Vec3{1, 1, 1});
+    mesh.addComponent<fuse::CMesh>(fuse::Vec4{1, 0, 0, 1});
+    scene.createEntity().addComponent<fuse::CTransform>(); // no mesh, not extracted
+
+    fuse::RenderList renderList;
+    fuse::extractRenderList(scene, 1.0f, renderList);
+    ASSERT_EQ(renderList.size(), 1);
+    EXPECT_EQ(renderList.colors[0], fuse::Vec4(1, 0, 0, 1));
+    EXPECT_EQ(renderList.worldMatrices[0], fuse::Mat4::CreateTranslation({1, 2, 3}));
+    EXPECT_EQ(renderList.meshIds.size(), 1);
+    EXPECT_EQ(renderList.sortKeys.size(), 1);
+    EXPECT_EQ(renderList.occluders[0], 0);
+    EXPECT_EQ(fuse::fromPickId(renderList.entityIds[0]), entt::entity{mesh.getId()});
+    EXPECT_EQ(fuse::fromPickId(0), entt::entity{entt::null}); // background
+
+    mesh.getComponent<fuse::CMesh>().occluder = true;
+    fuse::extractRenderList(scene, 1.0f, renderList);
+    EXPECT_EQ(renderList.occluders[0], 1);
+
+    // interpolate with the previous transform
+    fuse::storePreviousTransforms(scene);
+    mesh.getComponent<fuse::CTransform>().translation = {3, 2, 3};
+    fuse::extractRenderList(scene, 0.5f, renderList);
+    ASSERT_EQ(renderList.size(), 1);
+    EXPECT_EQ(renderList.worldMatrices[0], fuse::Mat4::CreateTranslation({2, 2, 3}));
+
+    renderList.clear();
+    EXPECT_TRUE(renderList.isEmpty());
+}
+
+TEST(Scene, extractRenderListMultiThread) {
+    fuse::Scene scene;
+    for (int i = 0; i < 20000; i++) {
+        auto entity = scene.createEntity();
+        entity.addComponent<fuse::CMesh>(fuse::Vec4{static_cast<float>(i), 0, 0, 1});
+        if (i % 3 != 0) { // some meshes without transform are skipped
+            entity.addComponent<fuse::CTransform>(
+              fuse::Vec3{static_cast<float>(i), 0, 0}, fuse::Vec3{}, fuse::Vec3{1, 1, 1});
+        }
+    }
+
+    fuse::WorkerPool workers(4);
+    fuse::RenderList single;
+    fuse::RenderList parallel;
+    fuse::extractRenderList(scene, 1.0f, single);
+    fuse::extractRenderList(scene, 1.0f, parallel, &workers);
+    ASSERT_EQ(single.size(), parallel.size());
+    EXPECT_EQ(single.colors, parallel.colors);
+    EXPECT_EQ(single.worldMatrices, parallel.worldMatrices);
+}
@@ -0,0 +1,90 @@
+#include <FuseCore/scene/Scene.h>
+#include <FuseCore/scene/SelectionSummary.h>
+
+#include <gtest/gtest.h>
+
+using fuse::CSelected;
+using fuse::CTransform;
+using fuse::SelectionSummary;
+using fuse::Vec3;
+
+namespace {
+constexpr std::size_t kTranslationX = 0;
+constexpr std::size_t kTranslationY = 1;
+constexpr std::size_t kScaleX       = 6;
+} // namespace
+
+TEST(SelectionSummary, mixedValues) {
+    fuse::Scene scene;
+    auto&       registry = scene.getRegistry();
+    const auto  entity1  = registry.create();
+    const auto  entity2  = registry.create();
+    const auto  entity3  = registry.create();
+    registry.emplace<CTransform>(entity1, Vec3{1, 2, 3}, Vec3{0, 0, 0}, Vec3{1, 1, 1});
+    registry.emplace<CTransform>(entity2, Vec3{1, 5, 3}, Vec3{0, 0, 0}, Vec3{1, 1, 1});
+    registry.emplace<CTransform>(entity3, Vec3{4, 2, 3}, Vec3{0, 0, 0}, Vec3{1, 1, 1});
+
+    SelectionSummary<CTransform> summary;
+    summary.connect(registry);
+    summary.update(registry, scene.getTransformVersion());
+    EXPECT_EQ(summary.getCount(), 0);
+
+    // selecting entities update the summary without iterating the selection
+    registry.emplace<CSelected>(entity1);
+    registry.emplace<CSelected>(entity2);
+    EXPECT_EQ(summary.getCount(), 2);
+    EXPECT_FALSE(summary.isMixed(kTranslationX));
+    EXPECT_TRUE(summary.isMixed(kTranslationY));
+    EXPECT_EQ(summary.getValue(kScaleX), 1.0f);
+
+    // deselecting recompute the summary on update()
+    registry.remove<CSelected>(entity2);
+    registry.emplace<CSelected>(entity3);
+    summary.update(registry, scene.getTransformVersion());
+    EXPECT_EQ(summary.getCount(), 2);
+    EXPECT_TRUE(summary.isMixed(kTranslationX));
+    EXPECT_FALSE(summary.isMixed(kTranslationY));
+
+    // a modification in place is detected with the version
+    registry.get<CTransform>(entity3).translation.y = 7.0f;
+    scene.markTransformsChanged();
+    summary.update(registry, scene.getTransformVersion());
+    EXPECT_TRUE(summary.isMixed(kTranslationY));
+
+    registry.clear<CSelected>();
+    summary.update(registry, scene.getTransformVersion());
+    EXPECT_EQ(summary.getCount(), 0);
+}
+
+TEST(SelectionSummary, setField) {
+    fuse::Scene               scene;
+    auto&                     registry = scene.getRegistry();
+    std::vector<entt::entity> entities(1000);
+    registry.create(entities.begin(), entities.end());
+    for (std::size_t i = 0; i < entities.size(); i++) {
+        registry.emplace<CTransform>(entities[i], Vec3{static_cast<float>(i), 0, 0});
+    }
+    registry.insert<CSelected>(entities.begin(), entities.begin() + 500);
+
+    SelectionSummary<CTransform> summary;
+    summary.connect(registry);
+    summary.update(registry, scene.getTransformVersion());
+    EXPECT_TRUE(summary.isMixed(kTranslationX));
+
+    // a drag of the field over several frames is one undo step
+    fuse::UndoJournal journal;
+    summary.setField(registry, kTranslationX, 10.0f, &journal, 42);
+    summary.setField(registry, kTranslationX, 20.0f, &journal, 42);
+    EXPECT_FALSE(summary.isMixed(kTranslationX));
+    EXPECT_EQ(summary.getValue(kTranslationX), 20.0f);
+    EXPECT_EQ(registry.get<CTransform>(entities[0]).translation.x, 20.0f);
+    EXPECT_EQ(registry.get<CTransform>(entities[499]).translation.x, 20.0f);
+    EXPECT_EQ(registry.get<CTransform>(entities[500]).translation.x, 500.0f); // not selected
+    EXPECT_EQ(journal.getUndoCount(), 1);
+
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_EQ(registry.get<CTransform>(entities[0]).translation.x, 0.0f);
+    EXPECT_EQ(registry.get<CTransform>(entities[499]).translation.x, 499.0f);
+    summary.update(registry, scene.getTransformVersion());
+    EXPECT_TRUE(summary.isMixed(kTranslationX));
+}
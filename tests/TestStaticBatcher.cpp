@@ -0,0 +1,139 @@
+#include <FuseCore/scene/RenderList.h>
+#include <FuseCore/scene/Scene.h>
+#include <FuseCore/scene/StaticBatcher.h>
+
+#include <gtest/gtest.h>
+
+using fuse::Mat4;
+using fuse::MeshHandle;
+using fuse::StaticBatcher;
+using fuse::StaticEntry;
+using fuse::Vec3;
+using fuse::Vec4;
+
+namespace {
+
+const Vec4 kRed{1, 0, 0, 1};
+const Vec4 kBlue{0, 0, 1, 1};
+
+fuse::Entity createStatic(fuse::Scene& scene, const Vec3& position, const Vec4& color) {
+    auto entity = scene.createEntity();
+    entity.addComponent<fuse::CTransform>(position, Vec3{0, 0, 0}, Vec3{1, 1, 1});
+    entity.addComponent<fuse::CMesh>(color);
+    entity.addComponent<fuse::CStatic>();
+    return entity;
+}
+
+} // namespace
+
+TEST(StaticBatcher, build) {
+    const fuse::MeshRegistry registry;
+    const auto&              cube = registry.getInfo(MeshHandle::kCube);
+    const StaticEntry        entries[] = {
+      {Mat4::CreateTranslation({10, 0, 0}), kRed, MeshHandle::kCube, 1},
+      {Mat4::CreateTranslation({20, 0, 0}), kBlue, MeshHandle::kCube, 2},
+      {Mat4::CreateTranslation({30, 0, 0}), kRed, MeshHandle::kCube, 3},
+    };
+
+    StaticBatcher batcher;
+    batcher.build(entries, registry);
+    EXPECT_EQ(batcher.getEntityCount(), 3);
+    EXPECT_EQ(batcher.getVertices().size(), cube.vertexCount * 3);
+    EXPECT_EQ(batcher.getIndices().size(), cube.indexCount * 3);
+
+    // one batch per color, the meshes of a batch are contiguous
+    const auto batches = batcher.getBatches();
+    ASSERT_EQ(batches.size(), 2);
+    std::uint32_t indexCount = 0;
+    for (const auto& batch : batches) {
+        EXPECT_EQ(batch.firstIndex, indexCount);
+        indexCount += batch.indexCount;
+    }
+    const auto& red = batches[0].color == kRed ? batches[0] : batches[1];
+    EXPECT_EQ(red.entityCount, 2);
+    EXPECT_EQ(red.indexCount, cube.indexCount * 2);
+
+    // the vertices are in world space, and keep the entity of their mesh
+    ASSERT_EQ(batcher.getEntityIds().size(), batcher.getVertices().size());
+    for (const auto index : batcher.getIndices().subspan(red.firstIndex, red.indexCount)) {
+        const float x        = batcher.getVertices()[index].position.x;
+        const auto  entityId = batcher.getEntityIds()[index];
+        EXPECT_TRUE((x >= 9.5f && x <= 10.5f) || (x >= 29.5f && x <= 30.5f)) << x;
+        EXPECT_EQ(entityId, x < 20.0f ? 1 : 3);
+    }
+}
+
+TEST(StaticBatcher, transformNormals) {
+    const fuse::MeshRegistry registry;
+    const StaticEntry        entries[] = {
+      // non uniform scale and mirror
+      {Mat4::CreateRotationY(fuse::degrees(90)) * Mat4::CreateScaling({-2, 1, 4}),
+       kRed,
+       MeshHandle::kSphere},
+    };
+
+    StaticBatcher batcher;
+    batcher.build(entries, registry);
+
+    // the triangles stay counter-clockwise seen from their normals
+    const auto vertices = batcher.getVertices();
+    const auto indices  = batcher.getIndices();
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        const auto& a = vertices[indices[i]];
+        const auto& b = vertices[indices[i + 1]];
+        const auto& c = vertices[indices[i + 2]];
+        EXPECT_NEAR(a.normal.length(), 1.0f, 1e-5f);
+
+        const auto faceNormal = (b.position - a.position).crossRH(c.position - a.position);
+        EXPECT_GT(faceNormal.dot(a.normal + b.normal + c.normal), 0.0f) << "triangle " << i / 3;
+    }
+}
+
+TEST(StaticBatcher, update) {
+    fuse::Scene scene;
+    auto        first = createStatic(scene, {0, 0, 0}, kRed);
+    createStatic(scene, {5, 0, 0}, kRed);
+    createStatic(scene, {0, 5, 0}, Vec4{0, 1, 0, 0.5f}); // transparent, not batched
+    auto dynamic = scene.createEntity();
+    dynamic.addComponent<fuse::CTransform>();
+    dynamic.addComponent<fuse::CMesh>(kBlue);
+
+    StaticBatcher batcher;
+    EXPECT_TRUE(batcher.update(scene));
+    EXPECT_EQ(batcher.getEntityCount(), 2);
+    ASSERT_EQ(batcher.getBatches().size(), 1);
+    EXPECT_FALSE(batcher.update(scene)); // nothing changed
+
+    // the static entities are not extracted, except the transparent one
+    fuse::RenderList renderList;
+    fuse::extractRenderList(scene, 1.0f, renderList, nullptr, true);
+    ASSERT_EQ(renderList.size(), 2);
+    EXPECT_EQ(renderList.colors[0], Vec4(0, 1, 0, 0.5f));
+    EXPECT_EQ(renderList.colors[1], kBlue);
+    EXPECT_EQ(renderList.entityIds[1], fuse::toPickId(entt::entity{dynamic.getId()}));
+    fuse::extractRenderList(scene, 1.0f, renderList);
+    EXPECT_EQ(renderList.size(), 4);
+
+    // a dynamic entity does not change the static version
+    const auto version = scene.getStaticVersion();
+    dynamic.patchComponent<fuse::CTransform>(
+      [](fuse::CTransform& transform) { transform.translation = {1, 1, 1}; });
+    EXPECT_EQ(scene.getStaticVersion(), version);
+    EXPECT_FALSE(batcher.update(scene));
+
+    // patching a static entity, making a entity static or removing it rebuild the batches
+    first.patchComponent<fuse::CTransform>(
+      [](fuse::CTransform& transform) { transform.translation = {1, 1, 1}; });
+    EXPECT_TRUE(batcher.update(scene));
+    dynamic.addComponent<fuse::CStatic>();
+    EXPECT_TRUE(batcher.update(scene));
+    EXPECT_EQ(batcher.getEntityCount(), 3);
+    EXPECT_EQ(batcher.getBatches().size(), 2);
+    scene.destroyEntity(first);
+    EXPECT_TRUE(batcher.update(scene));
+    EXPECT_EQ(batcher.getEntityCount(), 2);
+
+    // a modification in place must be reported
+    scene.markStaticChanged();
+    EXPECT_TRUE(batcher.update(scene));
+}
@@ -0,0 +1,74 @@
+#include <FuseCore/utils/StringInterner.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+TEST(StringInterner, ctor) {
+    const fuse::StringInterner interner;
+    EXPECT_EQ(interner.size(), 0);
+    EXPECT_EQ(interner.resolve({}), "");
+    EXPECT_FALSE(interner.find("foo").isValid());
+}
+
+TEST(StringInterner, intern) {
+    fuse::StringInterner interner;
+
+    // empty string are not interned
+    EXPECT_FALSE(interner.intern("").isValid());
+    EXPECT_EQ(interner.size(), 0);
+
+    const auto foo = interner.intern("foo");
+    const auto bar = interner.intern("bar");
+    EXPECT_TRUE(foo.isValid());
+    EXPECT_TRUE(bar.isValid());
+    EXPECT_NE(foo, bar);
+    EXPECT_EQ(interner.size(), 2);
+
+    // the same string give back the same id
+    EXPECT_EQ(interner.intern(std::string("foo")), foo);
+    EXPECT_EQ(interner.find("bar"), bar);
+    EXPECT_EQ(interner.size(), 2);
+
+    EXPECT_EQ(interner.resolve(foo), "foo");
+    EXPECT_EQ(interner.resolve(bar), "bar");
+
+    // string are null-terminated
+    EXPECT_EQ(interner.resolve(foo).data()[3], '\0');
+}
+
+TEST(StringInterner, manyStrings) {
+    fuse::StringInterner interner;
+
+    constexpr int kCount = 10000;
+    for (int i = 0; i < kCount; i++) {
+        interner.intern(std::to_string(i));
+    }
+    EXPECT_EQ(interner.size(), kCount);
+
+    for (int i = 0; i < kCount; i++) {
+        const auto str = std::to_string(i);
+        const auto id  = interner.find(str);
+        ASSERT_TRUE(id.isValid());
+        ASSERT_EQ(interner.resolve(id), str);
+    }
+
+    // string larger than a arena block
+    const std::string large(256 * 1024, 'a');
+    const auto        id = interner.intern(large);
+    EXPECT_EQ(interner.resolve(id), large);
+    EXPECT_EQ(interner.resolve(interner.find("9999")), "9999");
+}
+
+TEST(StringInterner, clear) {
+    fuse::StringInterner interner;
+    interner.intern("foo");
+    EXPECT_EQ(interner.getGeneration(), 0);
+    interner.clear();
+    EXPECT_EQ(interner.getGeneration(), 1);
+    EXPECT_EQ(interner.size(), 0);
+    EXPECT_FALSE(interner.find("foo").isValid());
+
+    const auto foo = interner.intern("foo");
+    EXPECT_EQ(interner.resolve(foo), "foo");
+}
@@ -0,0 +1,55 @@
+#include <FuseCore/utils/UUID.h>
+
+#include <gtest/gtest.h>
+
+#include <format>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+TEST(UUID, ctor) {
+    EXPECT_FALSE(fuse::UUID().isValid());
+    EXPECT_EQ(fuse::UUID().value(), 0);
+
+    const fuse::UUID uuid(0x1234);
+    EXPECT_TRUE(uuid.isValid());
+    EXPECT_EQ(uuid.value(), 0x1234);
+    EXPECT_EQ(uuid, fuse::UUID(0x1234));
+}
+
+TEST(UUID, generate) {
+    std::unordered_set<fuse::UUID> uuids;
+    for (int i = 0; i < 100000; i++) {
+        const auto uuid = fuse::UUID::Generate();
+        ASSERT_TRUE(uuid.isValid());
+        ASSERT_TRUE(uuids.insert(uuid).second);
+    }
+}
+
+TEST(UUID, generateMultiThread) {
+    constexpr int kNbThread = 4;
+    constexpr int kNbUUID   = 10000;
+
+    std::mutex                     mutex;
+    std::unordered_set<fuse::UUID> uuids;
+    std::vector<std::thread>       threads;
+    for (int t = 0; t < kNbThread; t++) {
+        threads.emplace_back([&]() {
+            std::vector<fuse::UUID> local;
+            for (int i = 0; i < kNbUUID; i++) {
+                local.push_back(fuse::UUID::Generate());
+            }
+            const std::scoped_lock lock(mutex);
+            uuids.insert(local.begin(), local.end());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(uuids.size(), kNbThread * kNbUUID);
+}
+
+TEST(UUID, format) {
+    EXPECT_EQ(std::format("{}", fuse::UUID(0xABCDEF)), "0000000000abcdef");
+}
@@ -0,0 +1,191 @@
+#include <FuseCore/scene/Components.h>
+#include <FuseCore/scene/UndoJournal.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using fuse::CTransform;
+using fuse::UndoJournal;
+using fuse::Vec3;
+
+namespace {
+
+/// @brief A component which is not trivially copyable.
+struct CLabel {
+    std::string text;
+};
+
+CTransform translated(float x) { return {Vec3{x, 0, 0}, Vec3{0, 0, 0}, Vec3{1, 1, 1}}; }
+
+/// @brief Replace a component and record the change.
+template <class Component>
+void change(UndoJournal&     journal,
+            entt::registry&  registry,
+            entt::entity     entity,
+            const Component& value,
+            std::uint64_t    mergeKey = 0) {
+    const Component before = registry.get<Component>(entity);
+    registry.replace<Component>(entity, value);
+    journal.record(entity, before, value, mergeKey);
+}
+
+} // namespace
+
+TEST(UndoJournal, undoRedo) {
+    entt::registry registry;
+    UndoJournal    journal;
+    const auto     entity = registry.create();
+    registry.emplace<CTransform>(entity, translated(0));
+    registry.emplace<CLabel>(entity, "Foo");
+    EXPECT_FALSE(journal.canUndo());
+    EXPECT_FALSE(journal.undo(registry));
+
+    change(journal, registry, entity, translated(1));
+    change(journal, registry, entity, CLabel{"Bar"});
+    change(journal, registry, entity, translated(2));
+    EXPECT_EQ(journal.getUndoCount(), 3);
+
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_EQ(registry.get<CTransform>(entity).translation.x, 1);
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_EQ(registry.get<CLabel>(entity).text, "Foo");
+    EXPECT_TRUE(journal.redo(registry));
+    EXPECT_EQ(registry.get<CLabel>(entity).text, "Bar");
+    EXPECT_EQ(journal.getRedoCount(), 1);
+
+    // a new change drop the redo history
+    change(journal, registry, entity, translated(3));
+    EXPECT_FALSE(journal.canRedo());
+    EXPECT_EQ(journal.getUndoCount(), 3);
+
+    // the removed components are ignored
+    registry.remove<CTransform>(entity);
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_FALSE(registry.all_of<CTransform>(entity));
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_EQ(registry.get<CLabel>(entity).text, "Foo");
+}
+
+TEST(UndoJournal, merge) {
+    entt::registry registry;
+    UndoJournal    journal;
+    const auto     entity1 = registry.create();
+    const auto     entity2 = registry.create();
+    registry.emplace<CTransform>(entity1, translated(0));
+    registry.emplace<CTransform>(entity2, translated(10));
+
+    // a drag of the two entities
+    for (int frame = 1; frame <= 10; ++frame) {
+        change(journal, registry, entity1, translated(static_cast<float>(frame)), 42);
+        change(journal, registry, entity2, translated(static_cast<float>(10 + frame)), 42);
+    }
+    const auto memoryUsage = journal.getMemoryUsage();
+    EXPECT_EQ(journal.getUndoCount(), 1);
+
+    // a other drag of the same field
+    journal.closeMerge();
+    change(journal, registry, entity1, translated(100), 42);
+    change(journal, registry, entity1, translated(200), 42);
+    EXPECT_EQ(journal.getUndoCount(), 2);
+    EXPECT_GT(journal.getMemoryUsage(), memoryUsage);
+
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_EQ(registry.get<CTransform>(entity1).translation.x, 10);
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_EQ(registry.get<CTransform>(entity1).translation.x, 0);
+    EXPECT_EQ(registry.get<CTransform>(entity2).translation.x, 10);
+    EXPECT_TRUE(journal.redo(registry));
+    EXPECT_EQ(registry.get<CTransform>(entity1).translation.x, 10);
+    EXPECT_EQ(registry.get<CTransform>(entity2).translation.x, 20);
+}
+
+TEST(UndoJournal, group) {
+    entt::registry            registry;
+    UndoJournal               journal;
+    std::vector<entt::entity> entities(10000);
+    registry.create(entities.begin(), entities.end());
+    registry.insert<CTransform>(entities.begin(), entities.end(), translated(0));
+
+    // the same component changed twice in the group
+    journal.beginGroup();
+    for (auto entity : entities) {
+        change(journal, registry, entity, translated(1));
+    }
+    journal.beginGroup(); // nested
+    for (auto entity : entities) {
+        change(journal, registry, entity, translated(2), 42);
+    }
+    journal.endGroup();
+    journal.endGroup();
+    EXPECT_EQ(journal.getUndoCount(), 1);
+
+    // a empty group does not create a entry
+    journal.beginGroup();
+    journal.endGroup();
+    EXPECT_EQ(journal.getUndoCount(), 1);
+
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_TRUE(std::ranges::all_of(entities, [&](auto entity) {
+        return registry.get<CTransform>(entity).translation.x == 0;
+    }));
+    EXPECT_TRUE(journal.redo(registry));
+    EXPECT_TRUE(std::ranges::all_of(entities, [&](auto entity) {
+        return registry.get<CTransform>(entity).translation.x == 2;
+    }));
+
+    // a drag of the entities, one group per frame
+    const auto memoryUsage = journal.getMemoryUsage();
+    for (int frame = 3; frame < 10; ++frame) {
+        journal.beginGroup(42);
+        for (auto entity : entities) {
+            change(journal, registry, entity, translated(static_cast<float>(frame)));
+        }
+        journal.endGroup();
+    }
+    EXPECT_EQ(journal.getUndoCount(), 2);
+    EXPECT_LT(journal.getMemoryUsage(), memoryUsage * 2);
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_EQ(registry.get<CTransform>(entities.back()).translation.x, 2);
+}
+
+TEST(UndoJournal, memoryBudget) {
+    entt::registry registry;
+    UndoJournal    journal(UndoJournal::kChunkSize * 2);
+    const auto     entity = registry.create();
+    registry.emplace<CTransform>(entity, translated(0));
+    registry.emplace<CLabel>(entity);
+    EXPECT_EQ(journal.getMemoryBudget(), UndoJournal::kChunkSize * 2);
+
+    // the oldest entries are dropped
+    for (int i = 1; i <= 10000; ++i) {
+        change(journal, registry, entity, translated(static_cast<float>(i)));
+        change(journal, registry, entity, CLabel{std::to_string(i)});
+        EXPECT_LE(journal.getMemoryUsage(), journal.getMemoryBudget());
+    }
+    EXPECT_LT(journal.getUndoCount(), 20000);
+    EXPECT_GT(journal.getUndoCount(), 1000);
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_EQ(registry.get<CLabel>(entity).text, "9999");
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_EQ(registry.get<CTransform>(entity).translation.x, 9999);
+
+    // a group larger than the budget cannot be undone
+    std::vector<entt::entity> entities(10000);
+    registry.create(entities.begin(), entities.end());
+    registry.insert<CTransform>(entities.begin(), entities.end(), translated(0));
+    journal.beginGroup();
+    for (auto e : entities) {
+        change(journal, registry, e, translated(1));
+    }
+    journal.endGroup();
+    EXPECT_FALSE(journal.canUndo());
+    EXPECT_FALSE(journal.canRedo());
+    EXPECT_EQ(journal.getMemoryUsage(), 0);
+
+    change(journal, registry, entity, translated(1));
+    EXPECT_TRUE(journal.undo(registry));
+    EXPECT_EQ(registry.get<CTransform>(entity).translation.x, 9999);
+}
@@ -0,0 +1,56 @@
+#include <FuseCore/utils/WorkerPool.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+using fuse::WorkerPool;
+
+TEST(WorkerPool, run) {
+    WorkerPool workers(4);
+    EXPECT_EQ(workers.getThreadCount(), 4);
+
+    // the threads are reused from a job to the next
+    std::vector<std::atomic<int>> counts(100);
+    for (int job = 0; job < 50; job++) {
+        workers.run(counts.size(), [&](std::size_t task) { counts[task]++; });
+    }
+    for (const auto& count : counts) {
+        EXPECT_EQ(count, 50);
+    }
+
+    bool called = false;
+    workers.run(0, [&](std::size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(WorkerPool, parallelFor) {
+    WorkerPool       workers(3);
+    std::vector<int> values(1000);
+    workers.parallelFor(values.size(), 100, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            values[i]++;
+        }
+    });
+    EXPECT_EQ(std::ranges::count(values, 1), 1000);
+
+    // a small job is not split
+    int chunkCount = 0;
+    workers.parallelFor(10, 100, [&](std::size_t begin, std::size_t end) {
+        EXPECT_EQ(begin, 0);
+        EXPECT_EQ(end, 10);
+        chunkCount++;
+    });
+    EXPECT_EQ(chunkCount, 1);
+}
+
+TEST(WorkerPool, singleThread) {
+    WorkerPool workers(1);
+    EXPECT_EQ(workers.getThreadCount(), 1);
+
+    std::vector<std::size_t> tasks;
+    workers.run(3, [&](std::size_t task) { tasks.push_back(task); });
+    EXPECT_EQ(tasks, (std::vector<std::size_t>{0, 1, 2}));
+}